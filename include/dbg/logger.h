@@ -11,15 +11,40 @@
  */
 #pragma once
 
+#include <kformat.h>
+
 extern bool d_enabled;
 
 namespace logger {
 	namespace debug {
 		void puts(const char *subsystem, const char *type, const char *message);
-		int  printf(const char *subsystem,
-		            const char *type,
-		            const char *format,
-		            ...);
+		int  print(const char             *subsystem,
+		           const char             *type,
+		           const char             *str,
+		           const kstd::fmt::instr *ops,
+		           size_t                  count,
+		           const kstd::fmt::value *values);
+
+		/**
+		 * @brief Formatted debug log to the serial port
+		 * @note The format is checked and compiled at build time, see kformat.h
+		 */
+		template <typename... Args>
+		inline int printf(
+		    const char                                                    *subsystem,
+		    const char                                                    *type,
+		    kstd::fmt::format_string<kstd::fmt::type_identity_t<Args>...> format,
+		    Args... args) {
+			if( !d_enabled )
+				return 0;
+			const kstd::fmt::value values[] = {kstd::fmt::make_value(args)..., {}};
+			return print(subsystem,
+			             type,
+			             format.str,
+			             format.ops,
+			             format.count,
+			             values);
+		}
 	}  // namespace debug
 
 	void crit(const char *s, const char *m, const char *e);
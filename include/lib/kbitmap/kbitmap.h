@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * Bitmaps stored as arrays of 64-bit words, bit n living in word n / 64 at
+ * position n % 64.  On x86 that is the same layout as a byte array with
+ * LSB-first bits, so an 8-byte aligned ext2 block or inode bitmap can be
+ * passed in directly.
+ *
+ * Searches return the bit index found, or `nbits` when there is none.
+ * Bits at or past `nbits` in the last word are never reported.
+ */
+namespace kbitmap {
+	// Number of words needed for a bitmap of nbits bits
+	constexpr size_t words_for(size_t nbits) {
+		return (nbits + 63) / 64;
+	}
+
+	inline bool test(const uint64_t *map, size_t bit) {
+		return (map[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	inline void set(uint64_t *map, size_t bit) {
+		map[bit / 64] |= 1ULL << (bit % 64);
+	}
+
+	inline void clear(uint64_t *map, size_t bit) {
+		map[bit / 64] &= ~(1ULL << (bit % 64));
+	}
+
+	void set_range(uint64_t *map, size_t start, size_t len);
+	void clear_range(uint64_t *map, size_t start, size_t len);
+
+	size_t find_next_set(const uint64_t *map, size_t nbits, size_t start);
+	size_t find_next_zero(const uint64_t *map, size_t nbits, size_t start);
+
+	inline size_t find_first_set(const uint64_t *map, size_t nbits) {
+		return find_next_set(map, nbits, 0);
+	}
+
+	inline size_t find_first_zero(const uint64_t *map, size_t nbits) {
+		return find_next_zero(map, nbits, 0);
+	}
+
+	/**
+	 * @brief Find @p count consecutive zero bits at or after @p start
+	 * @return Index of the first bit of the run, or @p nbits
+	 */
+	size_t find_zero_run(const uint64_t *map,
+	                     size_t          nbits,
+	                     size_t          start,
+	                     size_t          count);
+
+	/**
+	 * @brief Number of set bits in [start, start + len)
+	 */
+	size_t popcount(const uint64_t *map, size_t start, size_t len);
+}  // namespace kbitmap
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+
+/*
+ * Batch versions of the elementary functions: out[i] = f(in[i]), and
+ * out[i] = pow(x[i], y[i]).
+ *
+ * Two elements are evaluated per step with SSE2.  Every result is bit for
+ * bit what the scalar function returns; a pair holding an argument outside
+ * the fast path (huge, subnormal, infinite or NaN) is handed to the scalar
+ * function instead.  @p in and @p out may point to the same array.
+ */
+namespace kmath {
+	void sin_n(const double *in, double *out, size_t n);
+	void cos_n(const double *in, double *out, size_t n);
+	void tan_n(const double *in, double *out, size_t n);
+	void exp_n(const double *in, double *out, size_t n);
+	void log_n(const double *in, double *out, size_t n);
+	void pow_n(const double *x, const double *y, double *out, size_t n);
+}  // namespace kmath
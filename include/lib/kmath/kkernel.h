@@ -0,0 +1,375 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * Polynomial kernels shared by the scalar functions and the batch versions.
+ *
+ * The coefficients are the Remez (minimax) fits from fdlibm, each valid on
+ * the reduced interval named above it.  The templates take either `double`
+ * or a GCC vector of doubles, so sin() and sin_n() run the exact same
+ * operations and return the same bits.
+ */
+namespace kmath {
+	namespace detail {
+		inline uint64_t to_bits(double x) {
+			return __builtin_bit_cast(uint64_t, x);
+		}
+
+		inline double from_bits(uint64_t b) {
+			return __builtin_bit_cast(double, b);
+		}
+
+		inline uint32_t high_word(double x) {
+			return (uint32_t) (to_bits(x) >> 32);
+		}
+
+		/**
+		 * @brief Exact product a * b = hi + lo (Dekker; no FMA on x86-64 v1)
+		 *
+		 * @p b may be a plain double next to a vector @p a.
+		 */
+		template <typename T, typename U = T>
+		inline void two_prod(T a, U b, T &hi, T &lo) {
+			constexpr double SPLIT = 134217729.0;  // 2^27 + 1
+
+			T ca = SPLIT * a;
+			T ah = ca - (ca - a);
+			T al = a - ah;
+			U cb = SPLIT * b;
+			U bh = cb - (cb - b);
+			U bl = b - bh;
+
+			hi = a * b;
+			lo = ((ah * bh - hi) + ah * bl + al * bh) + al * bl;
+		}
+
+		/**
+		 * @brief Exact sum a + b = s + e (Knuth)
+		 */
+		template <typename T>
+		inline void two_sum(T a, T b, T &s, T &e) {
+			s    = a + b;
+			T bb = s - a;
+			e    = (a - (s - bb)) + (b - bb);
+		}
+
+		// Adding this forces rounding to an integer in the low mantissa bits
+		constexpr double ROUND_SHIFTER = 0x1.8p52;
+
+		// sin on [-pi/4, pi/4]
+		constexpr double S1 = -1.66666666666666324348e-01;
+		constexpr double S2 = 8.33333333332248946124e-03;
+		constexpr double S3 = -1.98412698298579493134e-04;
+		constexpr double S4 = 2.75573137070700676789e-06;
+		constexpr double S5 = -2.50507602534068634195e-08;
+		constexpr double S6 = 1.58969099521155010221e-10;
+
+		// cos on [-pi/4, pi/4]
+		constexpr double C1 = 4.16666666666666019037e-02;
+		constexpr double C2 = -1.38888888888741095749e-03;
+		constexpr double C3 = 2.48015872894767294178e-05;
+		constexpr double C4 = -2.75573143513906633035e-07;
+		constexpr double C5 = 2.08757232129817482790e-09;
+		constexpr double C6 = -1.13596475577881948265e-11;
+
+		// exp on [-ln2/2, ln2/2], as R(r^2) in r*(exp(r)+1)/(exp(r)-1)
+		constexpr double P1 = 1.66666666666666019037e-01;
+		constexpr double P2 = -2.77777777770155933842e-03;
+		constexpr double P3 = 6.61375632143793436117e-05;
+		constexpr double P4 = -1.65339022054652515390e-06;
+		constexpr double P5 = 4.13813679705723846039e-08;
+
+		// log(1+f) = 2*atanh(s) on s in [-0.1716, 0.1716]
+		constexpr double LG1 = 6.666666666666735130e-01;
+		constexpr double LG2 = 3.999999999940941908e-01;
+		constexpr double LG3 = 2.857142874366239149e-01;
+		constexpr double LG4 = 2.222219843214978396e-01;
+		constexpr double LG5 = 1.818357216161805012e-01;
+		constexpr double LG6 = 1.531383769920937332e-01;
+		constexpr double LG7 = 1.479819860511658591e-01;
+
+		// 2/3 as a double-double, and 2 / (2n + 1) for n = 11 down to 2 in
+		// Horner order: the atanh series of pow()'s extended log
+		constexpr double TWO_THIRDS_HI  = 6.66666666666666629659e-01;
+		constexpr double TWO_THIRDS_LO  = 3.70074341541718826321e-17;
+		constexpr double ATANH_TAIL[10] = {
+		    2.0 / 23, 2.0 / 21, 2.0 / 19, 2.0 / 17, 2.0 / 15,
+		    2.0 / 13, 2.0 / 11, 2.0 / 9,  2.0 / 7,  2.0 / 5,
+		};
+
+		// tan on [-0.6744, 0.6744]; larger arguments use tan(pi/4 - x)
+		constexpr double TAN[] = {
+		    3.33333333333334091986e-01,  1.33333333333201242699e-01,
+		    5.39682539762260521377e-02,  2.18694882948595424599e-02,
+		    8.86323982359930005737e-03,  3.59207910759131235356e-03,
+		    1.45620945432529025516e-03,  5.88041240820264096874e-04,
+		    2.46463134818469906812e-04,  7.81794442939557092300e-05,
+		    7.14072491382608190305e-05,  -1.85586374855275456654e-05,
+		    2.59073051863633712884e-05,
+		};
+
+		// High word from which tan() switches to tan(pi/4 - x)
+		constexpr uint32_t TAN_BIG_HIGH = 0x3FE59428;
+
+		constexpr double PIO4    = 7.85398163397448278999e-01;
+		constexpr double PIO4_LO = 3.06161699786838301793e-17;
+
+		// asin(x) = x + x * P(x^2) / Q(x^2) on [0, 0.5]
+		constexpr double PS0 = 1.66666666666666657415e-01;
+		constexpr double PS1 = -3.25565818622400915405e-01;
+		constexpr double PS2 = 2.01212532134862925881e-01;
+		constexpr double PS3 = -4.00555345006794114027e-02;
+		constexpr double PS4 = 7.91534994289814532176e-04;
+		constexpr double PS5 = 3.47933107596021167570e-05;
+		constexpr double QS1 = -2.40339491173441421878e+00;
+		constexpr double QS2 = 2.02094576023350569471e+00;
+		constexpr double QS3 = -6.88283971605453293030e-01;
+		constexpr double QS4 = 7.70381505559019352791e-02;
+
+		// pi/2 in four pieces; the first three have at most 33 bits so
+		// n * PIO2_x is exact for any n below 2^20
+		constexpr double INV_PIO2 = 6.36619772367581382433e-01;
+		constexpr double PIO2_1   = 1.57079632673412561417e+00;
+		constexpr double PIO2_2   = 6.07710050630396597660e-11;
+		constexpr double PIO2_3   = 2.02226624871116645580e-21;
+		constexpr double PIO2_3T  = 8.47842766036889956997e-32;
+
+		// pi/2 as a double-double
+		constexpr double PIO2_HI = 1.57079632679489655800e+00;
+		constexpr double PIO2_LO = 6.12323399573676603587e-17;
+
+		// Largest |x| handled by reduce_pio2(); above it use rem_pio2_large()
+		constexpr double PIO2_MEDIUM_MAX = 0x1p20 * PIO2_1;
+
+		// ln2 split so that k * LN2_HI is exact for any exponent k
+		constexpr double INV_LN2 = 1.44269504088896338700e+00;
+		constexpr double LN2_HI  = 6.93147180369123816490e-01;
+		constexpr double LN2_LO  = 1.90821492927058770002e-10;
+
+		// Past these exp(x) overflows or rounds to zero
+		constexpr double EXP_OVERFLOW_AT  = 7.09782712893383973096e+02;
+		constexpr double EXP_UNDERFLOW_AT = -7.45133219101941108420e+02;
+
+		/**
+		 * @brief sin(x + y) for |x + y| <= pi/4
+		 * @param y Low part of the reduced argument (may be zero)
+		 */
+		template <typename T>
+		inline T kernel_sin(T x, T y) {
+			T z = x * x;
+			T w = z * z;
+			T r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+			T v = z * x;
+			return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+		}
+
+		/**
+		 * @brief cos(x + y) for |x + y| <= pi/4
+		 */
+		template <typename T>
+		inline T kernel_cos(T x, T y) {
+			T z  = x * x;
+			T w  = z * z;
+			T r  = z * (C1 + z * (C2 + z * C3))
+			    + w * w * (C4 + z * (C5 + z * C6));
+			T hz = 0.5 * z;
+			T a  = 1.0 - hz;
+			return a + (((1.0 - a) - hz) + (z * r - x * y));
+		}
+
+		/**
+		 * @brief Cody-Waite reduction of x by pi/2, |x| <= PIO2_MEDIUM_MAX
+		 *
+		 * The three products n * PIO2_1..3 are exact and are subtracted
+		 * with error-free sums, so the result keeps its precision even when
+		 * x sits right next to a multiple of pi/2.
+		 *
+		 * @param y0 High part of x - n * pi/2
+		 * @param y1 Low part of x - n * pi/2
+		 * @return n + ROUND_SHIFTER; the low mantissa bits hold n
+		 */
+		template <typename T>
+		inline T reduce_pio2(T x, T &y0, T &y1) {
+			T shifted = x * INV_PIO2 + ROUND_SHIFTER;
+			T fn      = shifted - ROUND_SHIFTER;
+
+			T r = x - fn * PIO2_1;
+
+			T a  = -(fn * PIO2_2);
+			T s  = r + a;
+			T bb = s - r;
+			T e  = (r - (s - bb)) + (a - bb);
+
+			T b   = -(fn * PIO2_3);
+			T s2  = s + b;
+			T bb2 = s2 - s;
+			T e2  = (s - (s2 - bb2)) + (b - bb2);
+
+			T lo = (e + e2) - fn * PIO2_3T;
+			y0   = s2 + lo;
+			y1   = lo - (y0 - s2);
+			return shifted;
+		}
+
+		/**
+		 * @brief Payne-Hanek reduction of a large finite x by pi/2
+		 * @param y Receives the high and low parts of x - n * pi/2
+		 * @return n (only the low two bits are meaningful)
+		 */
+		int rem_pio2_large(double x, double *y);
+
+		/**
+		 * @brief Reduce a finite x by pi/2 with whichever method is exact
+		 * @return n mod 4
+		 */
+		inline int rem_pio2(double x, double &y0, double &y1) {
+			if( __builtin_fabs(x) <= PIO2_MEDIUM_MAX )
+				return (int) (to_bits(reduce_pio2(x, y0, y1)) & 3);
+
+			double y[2];
+			int    n = rem_pio2_large(x, y);
+			y0       = y[0];
+			y1       = y[1];
+			return n & 3;
+		}
+
+		/**
+		 * @brief asin(sqrt(z)) / sqrt(z) - 1 for z in [0, 0.25]
+		 */
+		inline double asin_rational(double z) {
+			double p = PS3 + z * (PS4 + z * PS5);
+			p        = z * (PS0 + z * (PS1 + z * (PS2 + z * p)));
+			double q = 1.0 + z * (QS1 + z * (QS2 + z * (QS3 + z * QS4)));
+			return p / q;
+		}
+
+		/**
+		 * @brief Core of exp(): split x = k * ln2 + r and return exp(r)
+		 * @param x_lo Low part of the argument (zero for a plain double)
+		 * @param k    Receives k as a double; the caller scales by 2^k
+		 */
+		template <typename T>
+		inline T exp_core(T x, T x_lo, T &k) {
+			k      = (x * INV_LN2 + ROUND_SHIFTER) - ROUND_SHIFTER;
+			T hi   = x - k * LN2_HI;
+			T lo   = k * LN2_LO - x_lo;
+			T r    = hi - lo;
+			T rr   = r * r;
+			T p    = P3 + rr * (P4 + rr * P5);
+			T c    = r - rr * (P1 + rr * (P2 + rr * p));
+			return 1.0 + (r * c / (2.0 - c) - lo + hi);
+		}
+
+		/**
+		 * @brief Core of log(): log(m) + k * ln2 for m in [sqrt(2)/2, sqrt(2))
+		 */
+		template <typename T>
+		inline T log_core(T m, T k) {
+			T f    = m - 1.0;
+			T hfsq = 0.5 * f * f;
+			T s    = f / (2.0 + f);
+			T z    = s * s;
+			T w    = z * z;
+			T t1   = w * (LG2 + w * (LG4 + w * LG6));
+			T t2   = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+			T r    = t2 + t1;
+			return s * (hfsq + r) + k * LN2_LO - hfsq + f + k * LN2_HI;
+		}
+
+		/**
+		 * @brief The tan polynomial: returns r with tan(x + y) ~ x + r
+		 *
+		 * For |x + y| <= 0.6744; x + r is the result and r its tail.
+		 */
+		template <typename T>
+		inline T tan_poly(T x, T y) {
+			T z = x * x;
+			T w = z * z;
+
+			// Odd and even coefficients are summed separately to shorten
+			// the chain
+			T r = TAN[9] + w * TAN[11];
+			r   = TAN[1] + w * (TAN[3] + w * (TAN[5] + w * (TAN[7] + w * r)));
+			T v = TAN[10] + w * TAN[12];
+			v   = TAN[2] + w * (TAN[4] + w * (TAN[6] + w * (TAN[8] + w * v)));
+			v   = z * v;
+			T s = z * x;
+			return y + z * (s * (r + v) + y) + s * TAN[0];
+		}
+
+		/**
+		 * @brief Core of pow(): log(m) + k * ln2 as a double-double
+		 *
+		 * Same split as log_core().  Good to about 2^-62 relative, so
+		 * y * log(x) is still accurate to well under an ulp of the result
+		 * when it gets close to the overflow threshold.
+		 */
+		template <typename T>
+		inline void log_extended(T m, T k, T &hi, T &lo) {
+			// log(m) = 2 * atanh(s) with s = f / (2 + f); keep the
+			// division error
+			T f = m - 1.0;
+			T d = 2.0 + f;
+			T s = f / d;
+			T ph, pl;
+			two_prod(s, f, ph, pl);
+			T s_lo = (((f - 2.0 * s) - ph) - pl) / d;
+
+			// The s^3 term is too large to round in plain double
+			T zh, zl, ch, cl, th, tl;
+			two_prod(s, s, zh, zl);
+			two_prod(zh, s, ch, cl);
+			cl += zl * s;
+			two_prod(ch, TWO_THIRDS_HI, th, tl);
+			tl += cl * TWO_THIRDS_HI + ch * TWO_THIRDS_LO;
+
+			// Remaining atanh terms, 2 / (2n + 1) * s^(2n + 1) for n >= 2
+			T z    = zh;
+			T poly = T{} + ATANH_TAIL[0];
+			for( size_t n = 1; n < sizeof(ATANH_TAIL) / sizeof(double); n++ )
+				poly = ATANH_TAIL[n] + z * poly;
+			T tail = s * z * z * poly;
+
+			// s_lo enters through d/ds 2 * atanh(s) = 2 / (1 - s^2)
+			T h, l, e;
+			two_sum(k * LN2_HI, 2.0 * s, h, l);
+			two_sum(h, th, h, e);
+			l += e + (tl + tail + 2.0 * s_lo / (1.0 - z) + k * LN2_LO);
+
+			hi = h + l;
+			lo = l - (hi - h);
+		}
+
+		/**
+		 * @brief y * 2^k, including results that overflow or go subnormal
+		 */
+		inline double scale(double y, int k) {
+			if( k > 1023 ) {
+				y *= 0x1p1023;
+				k -= 1023;
+				if( k > 1023 )
+					k = 1023;
+			} else if( k < -1022 ) {
+				// Two steps so only the final multiply rounds
+				y *= 0x1p-1022 * 0x1p53;
+				k += 1022 - 53;
+				if( k < -1022 )
+					k = -1022;
+			}
+			return y * from_bits((uint64_t) (0x3FF + k) << 52);
+		}
+	}  // namespace detail
+}  // namespace kmath
@@ -15,6 +15,7 @@
 #include "kasin.h"
 #include "katan.h"
 #include "katan2.h"
+#include "kbatch.h"
 #include "kcbrt.h"
 #include "kceil.h"
 #include "kcopysign.h"
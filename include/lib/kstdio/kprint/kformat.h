@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * Compile-time parsed format strings.
+ *
+ * A format string literal is turned into a list of `instr` by a consteval
+ * constructor, so a bad conversion or a wrong argument type is a build error
+ * and nothing is parsed at runtime.  Every instruction is "emit this slice of
+ * the literal, then (optionally) emit one argument".
+ *
+ * Supported syntax: %[-][width][.precision][ll](s|c|d|u|x|X|f) and %%.
+ * A leading '0' in the width is accepted but pads with spaces, as it always did.
+ */
+namespace kstd {
+	namespace fmt {
+		enum class conv : uint8_t {
+			none,  // Literal only (trailing text or a %% escape)
+			str,
+			chr,
+			sdec,
+			udec,
+			hex,
+			hex_upper,
+			flt
+		};
+
+		constexpr uint8_t FLAG_LEFT = 0x01;  // '-' (left align)
+		constexpr uint8_t FLAG_LL   = 0x02;  // 'll' (64-bit integer)
+
+		/*
+		 * Maximum number of %% escapes in a single format string.
+		 *
+		 * Every %% ends the current instruction, so a format costs one
+		 * instruction per argument, one per escape and one for the tail.
+		 * The instruction array is sized by the argument types alone: the
+		 * literal is not part of the type, so the escape count cannot be
+		 * derived from it and has to be a fixed bound. The tree uses at most
+		 * one escape per format, so four leaves headroom while keeping each
+		 * format_string only a few instructions larger than it needs to be.
+		 * Raise it here if a format trips error_escapes_over_MAX_ESCAPES.
+		 */
+		constexpr size_t MAX_ESCAPES = 4;
+
+		struct instr {
+			uint16_t lit_off;  // Offset of the literal text in the format string
+			uint16_t lit_len;  // Length of the literal text
+			conv     type;
+			uint8_t  flags;
+			uint8_t  width;
+			uint8_t  precision;
+		};
+
+		// One argument, already checked against its conversion at compile time
+		union value {
+			uint64_t    u;  // Integers, sign-extended to 64 bits
+			double      d;
+			const char *s;
+		};
+
+		enum class kind : uint8_t {
+			invalid,
+			integer,
+			floating,
+			string
+		};
+
+		template <typename T>
+		struct type_identity {
+			using type = T;
+		};
+
+		template <typename T>
+		using type_identity_t = typename type_identity<T>::type;
+
+		template <typename T>
+		struct arg_traits {
+			static constexpr kind k = __is_enum(T) ? kind::integer : kind::invalid;
+		};
+
+#define KFMT_ARG_TRAITS(T, K)                      \
+	template <>                                \
+	struct arg_traits<T> {                     \
+		static constexpr kind k = kind::K; \
+	}
+
+		KFMT_ARG_TRAITS(bool, integer);
+		KFMT_ARG_TRAITS(char, integer);
+		KFMT_ARG_TRAITS(signed char, integer);
+		KFMT_ARG_TRAITS(unsigned char, integer);
+		KFMT_ARG_TRAITS(short, integer);
+		KFMT_ARG_TRAITS(unsigned short, integer);
+		KFMT_ARG_TRAITS(int, integer);
+		KFMT_ARG_TRAITS(unsigned int, integer);
+		KFMT_ARG_TRAITS(long, integer);
+		KFMT_ARG_TRAITS(unsigned long, integer);
+		KFMT_ARG_TRAITS(long long, integer);
+		KFMT_ARG_TRAITS(unsigned long long, integer);
+		KFMT_ARG_TRAITS(float, floating);
+		KFMT_ARG_TRAITS(double, floating);
+		KFMT_ARG_TRAITS(char *, string);
+		KFMT_ARG_TRAITS(const char *, string);
+		KFMT_ARG_TRAITS(decltype(nullptr), string);
+
+#undef KFMT_ARG_TRAITS
+
+		/*
+		 * Not constexpr on purpose: reaching one of these while parsing makes
+		 * the consteval constructor ill-formed, and the compiler error points
+		 * at the name below.
+		 */
+		void error_unknown_conversion(void);
+		void error_unsupported_length(void);
+		void error_too_few_arguments(void);
+		void error_too_many_arguments(void);
+		void error_argument_type_mismatch(void);
+		void error_integer_needs_ll(void);
+		void error_width_too_large(void);
+		void error_escapes_over_MAX_ESCAPES(void);
+		void error_format_too_long(void);
+
+		template <typename... Args>
+		struct format_string {
+			static constexpr size_t CAPACITY = sizeof...(Args) + MAX_ESCAPES + 1;
+
+			const char *str;
+			instr       ops[CAPACITY];
+			uint16_t    count;
+
+			template <size_t N>
+			consteval format_string(const char (&s)[N])
+			    : str(s)
+			    , ops{}
+			    , count(0) {
+				if( N > 0xFFFF )
+					error_format_too_long();
+				parse(s);
+			}
+
+		    private:
+
+			consteval void push(instr op) {
+				if( count >= CAPACITY )
+					error_escapes_over_MAX_ESCAPES();
+				ops[count++] = op;
+			}
+
+			static consteval uint8_t parse_number(const char *s, size_t &i) {
+				unsigned n = 0;
+				while( s[i] >= '0' && s[i] <= '9' ) {
+					n = n * 10 + (unsigned) (s[i++] - '0');
+					if( n > 0xFF )
+						error_width_too_large();
+				}
+				return (uint8_t) n;
+			}
+
+			static consteval void check(conv c, uint8_t flags, size_t idx) {
+				constexpr kind   kinds[] = {arg_traits<Args>::k..., kind::invalid};
+				constexpr size_t sizes[] = {sizeof(Args)..., 0};
+
+				if( idx >= sizeof...(Args) )
+					error_too_few_arguments();
+
+				switch( c ) {
+					case conv::str:
+						if( kinds[idx] != kind::string )
+							error_argument_type_mismatch();
+						break;
+					case conv::flt:
+						if( kinds[idx] != kind::floating )
+							error_argument_type_mismatch();
+						break;
+					default:
+						if( kinds[idx] != kind::integer )
+							error_argument_type_mismatch();
+						if( !(flags & FLAG_LL) && sizes[idx] > 4 )
+							error_integer_needs_ll();
+						break;
+				}
+			}
+
+			consteval void parse(const char *s) {
+				size_t escapes   = 0;
+				size_t arg_idx   = 0;
+				size_t lit_start = 0;
+				size_t i         = 0;
+
+				while( s[i] ) {
+					if( s[i] != '%' ) {
+						i++;
+						continue;
+					}
+
+					instr op   = {};
+					op.lit_off = (uint16_t) lit_start;
+					op.lit_len = (uint16_t) (i - lit_start);
+					i++;
+
+					if( s[i] == '%' ) {
+						// Keep the first '%' as literal text
+						if( ++escapes > MAX_ESCAPES )
+							error_escapes_over_MAX_ESCAPES();
+						op.lit_len++;
+						op.type = conv::none;
+						push(op);
+						lit_start = ++i;
+						continue;
+					}
+
+					if( s[i] == '-' ) {
+						op.flags |= FLAG_LEFT;
+						i++;
+					}
+
+					op.width     = parse_number(s, i);
+					op.precision = 6;
+					if( s[i] == '.' ) {
+						i++;
+						op.precision = parse_number(s, i);
+					}
+
+					if( s[i] == 'l' ) {
+						if( s[i + 1] != 'l' )
+							error_unsupported_length();
+						op.flags |= FLAG_LL;
+						i += 2;
+					}
+
+					switch( s[i] ) {
+						case 's':
+							op.type = conv::str;
+							break;
+						case 'c':
+							op.type = conv::chr;
+							break;
+						case 'd':
+							op.type = conv::sdec;
+							break;
+						case 'u':
+							op.type = conv::udec;
+							break;
+						case 'x':
+							op.type = conv::hex;
+							break;
+						case 'X':
+							op.type = conv::hex_upper;
+							break;
+						case 'f':
+							op.type = conv::flt;
+							break;
+						default:
+							error_unknown_conversion();
+					}
+
+					check(op.type, op.flags, arg_idx++);
+					push(op);
+					lit_start = ++i;
+				}
+
+				if( arg_idx != sizeof...(Args) )
+					error_too_many_arguments();
+
+				if( i > lit_start ) {
+					instr op   = {};
+					op.lit_off = (uint16_t) lit_start;
+					op.lit_len = (uint16_t) (i - lit_start);
+					op.type    = conv::none;
+					push(op);
+				}
+			}
+		};
+
+		template <typename T>
+		inline value make_value(T v) {
+			value out;
+			if constexpr( arg_traits<T>::k == kind::floating )
+				out.d = (double) v;
+			else if constexpr( arg_traits<T>::k == kind::string )
+				out.s = v;
+			else
+				out.u = (uint64_t) v;
+			return out;
+		}
+
+		// Output target used by the format engine
+		struct sink {
+			void (*write)(sink *self, const char *s, size_t len);
+			int count;  // Characters accepted so far
+		};
+
+		/**
+		 * @brief Run a compiled format against its arguments
+		 * @param str    The format string the instructions were compiled from
+		 * @param ops    Compiled instructions
+		 * @param count  Number of instructions
+		 * @param values Arguments, in conversion order
+		 * @param out    Destination
+		 */
+		void run(const char  *str,
+		         const instr *ops,
+		         size_t       count,
+		         const value *values,
+		         sink        *out);
+	}  // namespace fmt
+}  // namespace kstd
@@ -11,7 +11,7 @@
  */
 #pragma once
 
-#include <kstdarg.h>
+#include <kformat.h>
 #include <kstddef.h>
 #include <kstdint.h>
 
@@ -20,8 +20,43 @@ namespace kstd {
 	void  putdec(uint32_t n);
 	char *format_double(char *buf, size_t bufsize, double value, int precision);
 	void  puts(const char *s);
-	int   vsnprintf(char *buffer, size_t size, const char *format, va_list args);
-	int   snprintf(char *buffer, size_t size, const char *format, ...);
-	int   printf(const char *format, ...);
 	void  putchar(int c);
+
+	namespace fmt {
+		int print(const char  *str,
+		          const instr *ops,
+		          size_t       count,
+		          const value *values);
+		int print_to(char        *buffer,
+		             size_t       size,
+		             const char  *str,
+		             const instr *ops,
+		             size_t       count,
+		             const value *values);
+	}  // namespace fmt
+
+	/**
+	 * @brief Print a formatted string to the console
+	 * @return Number of characters written
+	 */
+	template <typename... Args>
+	inline int printf(fmt::format_string<fmt::type_identity_t<Args>...> format,
+	                  Args... args) {
+		const fmt::value values[] = {fmt::make_value(args)..., {}};
+		return fmt::print(format.str, format.ops, format.count, values);
+	}
+
+	/**
+	 * @brief Format into @p buffer, truncating to @p size - 1 characters
+	 * @return Number of characters stored, not counting the terminator
+	 */
+	template <typename... Args>
+	inline int snprintf(char                                               *buffer,
+	                    size_t                                              size,
+	                    fmt::format_string<fmt::type_identity_t<Args>...> format,
+	                    Args... args) {
+		const fmt::value values[] = {fmt::make_value(args)..., {}};
+		return fmt::print_to(
+		    buffer, size, format.str, format.ops, format.count, values);
+	}
 }  // namespace kstd
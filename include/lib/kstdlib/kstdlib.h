@@ -13,5 +13,6 @@
 
 #include "katoi.h"
 #include "kitoa.h"
+#include "kmuldiv.h"
 #include "kstrtol.h"
 #include "kutoa.h"
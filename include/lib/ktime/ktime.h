@@ -32,9 +32,35 @@ namespace time {
 	void        get_datetime_string(char *buffer, size_t buffer_size);
 	const char *get_day_of_week_string(uint8_t day_of_week);
 
+	// Rate at which timer_init() programs the PIT to call uptime_tick()
+	constexpr uint64_t TICKS_PER_SECOND = 100;
+	constexpr uint64_t NS_PER_SECOND    = 1000000000ULL;
+
 	void     uptime_init(void);
 	void     uptime_tick(void);
+	uint64_t get_uptime_ticks(void);
 	uint64_t get_uptime_seconds(void);
 	double   get_uptime_precise(void);
 	void     get_uptime_string(char *buffer, size_t buffer_size);
+
+	// Counter behind now_ns(), best first
+	enum class clocksource : uint8_t {
+		tsc,   // Invariant TSC, calibrated at boot
+		hpet,  // HPET main counter
+		pit    // uptime_tick() count, 1 / TICKS_PER_SECOND resolution
+	};
+
+	// now_ns() = base_ns + (((counter - base_count) * mult) >> 32)
+	struct clock_params {
+		uint64_t base_count;
+		uint64_t base_ns;
+		uint64_t mult;
+	};
+
+	void        clock_init(void);
+	uint64_t    now_ns(void);
+	clocksource get_clocksource(void);
+	const char *get_clocksource_name(void);
+	uint64_t    get_clocksource_hz(void);
+	void        get_clock_params(clock_params *params);
 }  // namespace time
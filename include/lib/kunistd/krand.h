@@ -11,11 +11,28 @@
  */
 #pragma once
 
+#include <kstddef.h>
 #include <kstdint.h>
 
+// Number of independent per-CPU streams
+#define KRAND_MAX_CPUS 64
+
+/*
+ * Each CPU draws from its own PCG32 stream with preemption off, so
+ * threads never race on a stream.  Not for interrupt handlers.
+ */
+
 namespace unistd {
 	namespace rand {
 		uint32_t unsign(void);
 		int32_t  sign(void);
+
+		void fill(void *buf, size_t len);
+
+		void srand32(uint64_t seed, uint64_t seq);
+		void seed(uint64_t seed);
+		void advance(uint64_t delta);
+
+		const char *seed_source(void);
 	}  // namespace rand
 }  // namespace unistd
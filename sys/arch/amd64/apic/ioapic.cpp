@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "ioapic.h"
+
+#include <dbg/logger.h>
+
+#include "madt.h"
+
+// Indirect register access: select with IOREGSEL, then use IOWIN
+#define IOREGSEL 0x00
+#define IOWIN    0x10
+
+#define IOAPIC_VER   0x01
+#define IOAPIC_REDTB 0x10  // Entry n: low dword at 0x10 + 2n, high at +1
+
+#define REDTB_ACTIVE_LOW (1U << 13)
+#define REDTB_LEVEL      (1U << 15)
+#define REDTB_MASKED     (1U << 16)
+#define REDTB_DEST_SHIFT 24  // In the high dword
+
+#define MAX_APIC_ID 0xFF
+
+namespace amd64::ioapic {
+	struct chip {
+		volatile uint32_t *regs;
+		uint32_t           gsi_base;
+		uint32_t           inputs;
+	};
+
+	static chip     chips[madt::MAX_IOAPICS];
+	static uint32_t chip_count = 0;
+
+	static uint32_t read(const chip *c, uint32_t reg) {
+		c->regs[IOREGSEL / 4] = reg;
+		return c->regs[IOWIN / 4];
+	}
+
+	static void write(const chip *c, uint32_t reg, uint32_t val) {
+		c->regs[IOREGSEL / 4] = reg;
+		c->regs[IOWIN / 4]    = val;
+	}
+
+	/**
+	 * @brief Find the IOAPIC serving @p gsi and its input number
+	 */
+	static const chip *lookup(uint32_t gsi, uint32_t &pin) {
+		for( uint32_t i = 0; i < chip_count; i++ ) {
+			const chip *c = &chips[i];
+			if( gsi >= c->gsi_base && gsi < c->gsi_base + c->inputs ) {
+				pin = gsi - c->gsi_base;
+				return c;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Map every IOAPIC listed in the MADT and mask all its inputs
+	 *
+	 * madt::parse() must have run.
+	 *
+	 * @return False if there is no IOAPIC
+	 */
+	bool init(void) {
+		chip_count = 0;
+		for( uint32_t i = 0; i < madt::ioapic_count(); i++ ) {
+			const madt::ioapic_info *info = madt::get_ioapic(i);
+
+			chip *c     = &chips[chip_count++];
+			c->regs     = (volatile uint32_t *) (uintptr_t) info->address;
+			c->gsi_base = info->gsi_base;
+			c->inputs   = ((read(c, IOAPIC_VER) >> 16) & 0xFF) + 1;
+
+			for( uint32_t pin = 0; pin < c->inputs; pin++ ) {
+				write(c, IOAPIC_REDTB + 2 * pin, REDTB_MASKED);
+				write(c, IOAPIC_REDTB + 2 * pin + 1, 0);
+			}
+
+			logger::debug::printf("ioapic",
+			                      "info",
+			                      "IOAPIC %u at 0x%x: GSI %u-%u\n",
+			                      info->id,
+			                      info->address,
+			                      c->gsi_base,
+			                      c->gsi_base + c->inputs - 1);
+		}
+		return chip_count > 0;
+	}
+
+	bool is_enabled(void) {
+		return chip_count > 0;
+	}
+
+	/**
+	 * @brief Program the redirection entry of @p gsi; it is left masked
+	 * @return False if no IOAPIC has that input or @p apic_id is too large
+	 */
+	bool route(uint32_t gsi,
+	           uint8_t  vector,
+	           uint32_t apic_id,
+	           bool     active_low,
+	           bool     level) {
+		uint32_t    pin;
+		const chip *c = lookup(gsi, pin);
+		if( !c || apic_id > MAX_APIC_ID )
+			return false;
+
+		uint32_t low = vector | REDTB_MASKED;
+		if( active_low )
+			low |= REDTB_ACTIVE_LOW;
+		if( level )
+			low |= REDTB_LEVEL;
+
+		// Masked while the halves are written one at a time
+		write(c, IOAPIC_REDTB + 2 * pin, REDTB_MASKED);
+		write(c, IOAPIC_REDTB + 2 * pin + 1, apic_id << REDTB_DEST_SHIFT);
+		write(c, IOAPIC_REDTB + 2 * pin, low);
+		return true;
+	}
+
+	void set_masked(uint32_t gsi, bool masked) {
+		uint32_t    pin;
+		const chip *c = lookup(gsi, pin);
+		if( !c )
+			return;
+
+		uint32_t low = read(c, IOAPIC_REDTB + 2 * pin);
+		low = masked ? low | REDTB_MASKED : low & ~REDTB_MASKED;
+		write(c, IOAPIC_REDTB + 2 * pin, low);
+	}
+
+	/**
+	 * @brief Deliver @p gsi to the local APIC @p apic_id from now on
+	 */
+	bool set_destination(uint32_t gsi, uint32_t apic_id) {
+		uint32_t    pin;
+		const chip *c = lookup(gsi, pin);
+		if( !c || apic_id > MAX_APIC_ID )
+			return false;
+
+		write(c, IOAPIC_REDTB + 2 * pin + 1, apic_id << REDTB_DEST_SHIFT);
+		return true;
+	}
+}  // namespace amd64::ioapic
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * I/O APICs, found through the MADT.
+ *
+ * Each input (global system interrupt, GSI) has a redirection entry that
+ * names the vector and the local APIC it is delivered to, so every line
+ * can go to its own CPU.  Delivery is fixed, physical destination mode,
+ * which limits destinations to APIC IDs below 256.
+ */
+namespace amd64::ioapic {
+	bool init(void);
+	bool is_enabled(void);
+
+	bool route(uint32_t gsi,
+	           uint8_t  vector,
+	           uint32_t apic_id,
+	           bool     active_low,
+	           bool     level);
+	void set_masked(uint32_t gsi, bool masked);
+	bool set_destination(uint32_t gsi, uint32_t apic_id);
+}  // namespace amd64::ioapic
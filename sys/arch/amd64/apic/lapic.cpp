@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "lapic.h"
+
+#include <kmuldiv.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/cpu/cpuid.h>
+#include <arch/amd64/idt/idt.h>
+#include <dbg/logger.h>
+
+// Register offsets from the LAPIC base
+#define LAPIC_ID            0x020
+#define LAPIC_TPR           0x080
+#define LAPIC_EOI           0x0B0
+#define LAPIC_SVR           0x0F0
+#define LAPIC_ICR_LOW       0x300
+#define LAPIC_ICR_HIGH      0x310
+#define LAPIC_LVT_TIMER     0x320
+#define LAPIC_TIMER_INITIAL 0x380
+#define LAPIC_TIMER_CURRENT 0x390
+#define LAPIC_TIMER_DIVIDE  0x3E0
+
+#define APIC_BASE_X2APIC    (1ULL << 10)
+#define APIC_BASE_ENABLE    (1ULL << 11)
+#define APIC_BASE_ADDR_MASK 0x000FFFFFFFFFF000ULL
+
+#define SVR_ENABLE          (1U << 8)
+#define LVT_MASKED          (1U << 16)
+#define LVT_TIMER_DEADLINE  (2U << 17)
+#define TIMER_DIVIDE_BY_16  0x3
+#define ICR_FIXED           (0U << 8)
+#define ICR_INIT            (5U << 8)
+#define ICR_STARTUP         (6U << 8)
+#define ICR_PENDING         (1U << 12)
+#define ICR_ASSERT          (1U << 14)
+
+// In x2APIC mode register N is MSR 0x800 + N / 16
+#define X2APIC_MSR_BASE 0x800
+
+#define CALIBRATE_NS 10000000ULL  // 10 ms
+
+namespace amd64::lapic {
+	static volatile uint32_t *regs   = nullptr;
+	static bool               x2apic = false;
+
+	static timer_mode mode     = timer_mode::none;
+	static uint64_t   timer_hz = 0;  // TSC rate, or LAPIC ticks after the divider
+
+	static inline uint32_t read(uint32_t reg) {
+		if( x2apic )
+			return (uint32_t) rdmsr(X2APIC_MSR_BASE + reg / 16);
+		return regs[reg / 4];
+	}
+
+	static inline void write(uint32_t reg, uint32_t val) {
+		if( x2apic )
+			wrmsr(X2APIC_MSR_BASE + reg / 16, val);
+		else
+			regs[reg / 4] = val;
+	}
+
+	static inline uint64_t ns_to_ticks(uint64_t ns, uint64_t hz) {
+		return kstd::mul_div64(ns, hz, time::NS_PER_SECOND);
+	}
+
+	/**
+	 * @brief Enable the local APIC of the calling CPU
+	 *
+	 * x2APIC mode is turned on when the CPU has it: registers are then
+	 * MSRs, and EOI is a single wrmsr with no MMIO round trip.  LINT0/LINT1
+	 * are left as the firmware set them, so the 8259 keeps delivering
+	 * through virtual-wire mode until the IOAPIC takes over.
+	 *
+	 * @return False if the CPU has no local APIC
+	 */
+	bool init(void) {
+		if( !cpuid::instr::has_apic() )
+			return false;
+
+		uint64_t base = rdmsr(MSR_IA32_APIC_BASE);
+		if( !(base & APIC_BASE_ENABLE) ) {
+			base |= APIC_BASE_ENABLE;
+			wrmsr(MSR_IA32_APIC_BASE, base);
+		}
+
+		// xAPIC has to be enabled before switching to x2APIC
+		if( cpuid::instr::has_x2apic() ) {
+			base |= APIC_BASE_X2APIC;
+			wrmsr(MSR_IA32_APIC_BASE, base);
+			x2apic = true;
+		}
+
+		regs = (volatile uint32_t *) (base & APIC_BASE_ADDR_MASK);
+
+		write(LAPIC_TPR, 0);
+		write(LAPIC_LVT_TIMER, LVT_MASKED | irq::LAPIC_TIMER_VECTOR);
+		write(LAPIC_SVR, SVR_ENABLE | irq::SPURIOUS_VECTOR);
+
+		logger::debug::printf("lapic",
+		                      "info",
+		                      "LAPIC %u enabled (%s)\n",
+		                      id(),
+		                      x2apic ? "x2APIC" : "xAPIC");
+		return true;
+	}
+
+	bool is_enabled(void) {
+		return regs != nullptr;
+	}
+
+	bool is_x2apic(void) {
+		return x2apic;
+	}
+
+	uint32_t id(void) {
+		// x2APIC IDs are the full 32 bits
+		return x2apic ? read(LAPIC_ID) : read(LAPIC_ID) >> 24;
+	}
+
+	void eoi(void) {
+		write(LAPIC_EOI, 0);
+	}
+
+	/**
+	 * @brief Send an interprocessor interrupt to @p apic_id
+	 *
+	 * In xAPIC mode this waits for the previous IPI to leave first; the
+	 * x2APIC ICR is a single MSR write that never reports busy.
+	 */
+	static void send(uint32_t apic_id, uint32_t icr) {
+		if( x2apic ) {
+			wrmsr(X2APIC_MSR_BASE + LAPIC_ICR_LOW / 16,
+			      ((uint64_t) apic_id << 32) | icr);
+			return;
+		}
+
+		while( read(LAPIC_ICR_LOW) & ICR_PENDING )
+			__asm__ volatile("pause");
+		write(LAPIC_ICR_HIGH, apic_id << 24);
+		write(LAPIC_ICR_LOW, icr);
+	}
+
+	void send_ipi(uint32_t apic_id, uint8_t vector) {
+		send(apic_id, ICR_FIXED | ICR_ASSERT | vector);
+	}
+
+	/**
+	 * @brief INIT: reset @p apic_id into wait-for-SIPI
+	 */
+	void send_init(uint32_t apic_id) {
+		send(apic_id, ICR_INIT | ICR_ASSERT);
+	}
+
+	/**
+	 * @brief Start-up IPI: @p apic_id begins in real mode at @p page * 4 KiB
+	 */
+	void send_startup(uint32_t apic_id, uint8_t page) {
+		send(apic_id, ICR_STARTUP | ICR_ASSERT | page);
+	}
+
+	/**
+	 * @brief Count LAPIC timer ticks over CALIBRATE_NS of now_ns()
+	 * @return Timer frequency after the divider, in Hz
+	 */
+	static uint64_t calibrate_oneshot(void) {
+		write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
+		write(LAPIC_LVT_TIMER, LVT_MASKED | irq::LAPIC_TIMER_VECTOR);
+
+		write(LAPIC_TIMER_INITIAL, 0xFFFFFFFF);
+		uint64_t start = time::now_ns();
+		uint64_t elapsed;
+		do {
+			elapsed = time::now_ns() - start;
+		} while( elapsed < CALIBRATE_NS );
+		uint32_t remaining = read(LAPIC_TIMER_CURRENT);
+		write(LAPIC_TIMER_INITIAL, 0);
+
+		uint64_t ticks = 0xFFFFFFFFULL - remaining;
+		return kstd::mul_div64(ticks, time::NS_PER_SECOND, elapsed);
+	}
+
+	/**
+	 * @brief Set up the timer of the calling CPU
+	 *
+	 * TSC-deadline mode is used when the CPU has it and now_ns() runs off
+	 * the TSC, since the deadline is then a plain conversion with no
+	 * calibration of its own.  Otherwise the timer runs one-shot and is
+	 * calibrated against now_ns().  Both need a clocksource that advances
+	 * with interrupts off, so on the PIT fallback there is no LAPIC timer.
+	 *
+	 * @return The mode now in use
+	 */
+	timer_mode timer_init(void) {
+		if( !is_enabled() || time::get_clocksource() == time::clocksource::pit )
+			return timer_mode::none;
+
+		if( mode == timer_mode::none ) {
+			if( cpuid::instr::has_tsc_deadline()
+			    && time::get_clocksource() == time::clocksource::tsc ) {
+				mode     = timer_mode::tsc_deadline;
+				timer_hz = time::get_clocksource_hz();
+			} else {
+				timer_hz = calibrate_oneshot();
+				if( timer_hz )
+					mode = timer_mode::oneshot;
+			}
+
+			logger::debug::printf("lapic",
+			                      "info",
+			                      "timer %s, %llu Hz\n",
+			                      get_timer_mode_name(),
+			                      timer_hz);
+		}
+
+		if( mode == timer_mode::tsc_deadline ) {
+			write(LAPIC_LVT_TIMER,
+			      LVT_TIMER_DEADLINE | irq::LAPIC_TIMER_VECTOR);
+		} else if( mode == timer_mode::oneshot ) {
+			write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
+			write(LAPIC_LVT_TIMER, irq::LAPIC_TIMER_VECTOR);
+		}
+		return mode;
+	}
+
+	/**
+	 * @brief Fire the timer interrupt of the calling CPU at @p deadline_ns
+	 *
+	 * A deadline that has already passed fires right away.
+	 */
+	void timer_arm(uint64_t deadline_ns) {
+		uint64_t now   = time::now_ns();
+		uint64_t delta = deadline_ns > now ? deadline_ns - now : 0;
+
+		if( mode == timer_mode::tsc_deadline ) {
+			// The LVT write must land before the MSR write arms the timer
+			__asm__ volatile("mfence" : : : "memory");
+			uint64_t tsc = rdtsc_ordered() + ns_to_ticks(delta, timer_hz);
+			wrmsr(MSR_IA32_TSC_DEADLINE, tsc);
+		} else if( mode == timer_mode::oneshot ) {
+			uint64_t count = ns_to_ticks(delta, timer_hz);
+			if( count == 0 )
+				count = 1;
+			if( count > 0xFFFFFFFFULL )
+				count = 0xFFFFFFFFULL;
+			write(LAPIC_TIMER_INITIAL, (uint32_t) count);
+		}
+	}
+
+	void timer_stop(void) {
+		if( mode == timer_mode::tsc_deadline )
+			wrmsr(MSR_IA32_TSC_DEADLINE, 0);
+		else if( mode == timer_mode::oneshot )
+			write(LAPIC_TIMER_INITIAL, 0);
+	}
+
+	timer_mode get_timer_mode(void) {
+		return mode;
+	}
+
+	const char *get_timer_mode_name(void) {
+		switch( mode ) {
+			case timer_mode::tsc_deadline:
+				return "tsc-deadline";
+			case timer_mode::oneshot:
+				return "one-shot";
+			case timer_mode::none:
+				break;
+		}
+		return "none";
+	}
+
+	/**
+	 * @brief Rate of the timer: the TSC in deadline mode, else LAPIC ticks
+	 */
+	uint64_t get_timer_hz(void) {
+		return timer_hz;
+	}
+}  // namespace amd64::lapic
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Local APIC and its timer.
+ *
+ * Every core has its own LAPIC at the same physical address, so the
+ * functions below always act on the calling CPU.  The timer is calibrated
+ * once, on the first CPU that calls timer_init().
+ */
+namespace amd64::lapic {
+	enum class timer_mode : uint8_t {
+		none,         // No usable LAPIC timer
+		oneshot,      // Initial-count register, calibrated against now_ns()
+		tsc_deadline  // IA32_TSC_DEADLINE
+	};
+
+	bool     init(void);
+	bool     is_enabled(void);
+	bool     is_x2apic(void);
+	uint32_t id(void);
+	void     eoi(void);
+
+	void send_ipi(uint32_t apic_id, uint8_t vector);
+	void send_init(uint32_t apic_id);
+	void send_startup(uint32_t apic_id, uint8_t page);
+
+	timer_mode  timer_init(void);
+	void        timer_arm(uint64_t deadline_ns);
+	void        timer_stop(void);
+	timer_mode  get_timer_mode(void);
+	const char *get_timer_mode_name(void);
+	uint64_t    get_timer_hz(void);
+}  // namespace amd64::lapic
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "madt.h"
+
+#include <dbg/logger.h>
+#include <kern/acpi/acpi.h>
+
+#include "lapic.h"
+
+#define ISA_IRQS 16
+
+#define MADT_PCAT_COMPAT (1U << 0)
+#define MADT_CPU_ENABLED (1U << 0)
+
+// MPS INTI flags of an interrupt source override
+#define INTI_POLARITY_MASK 0x3
+#define INTI_ACTIVE_LOW    0x3
+#define INTI_TRIGGER_MASK  0xC
+#define INTI_LEVEL         0xC
+
+namespace amd64::madt {
+	static uint32_t    cpu_ids[MAX_CPUS];
+	static uint32_t    cpus = 0;
+	static ioapic_info ioapics[MAX_IOAPICS];
+	static uint32_t    ioapic_total = 0;
+	static isa_route   isa[ISA_IRQS];
+	static bool        pcat_compat = true;
+
+	static void add_cpu(uint32_t apic_id) {
+		for( uint32_t i = 0; i < cpus; i++ ) {
+			if( cpu_ids[i] == apic_id )
+				return;
+		}
+		if( cpus < MAX_CPUS )
+			cpu_ids[cpus++] = apic_id;
+	}
+
+	static void add_override(const acpi::madt_iso *o) {
+		if( o->bus != 0 || o->source >= ISA_IRQS )
+			return;
+
+		// "Conforms to the bus" is ISA's active-high, edge-triggered
+		isa_route &r = isa[o->source];
+		r.gsi        = o->gsi;
+		r.active_low = (o->flags & INTI_POLARITY_MASK) == INTI_ACTIVE_LOW;
+		r.level      = (o->flags & INTI_TRIGGER_MASK) == INTI_LEVEL;
+	}
+
+	/**
+	 * @brief Read the MADT
+	 *
+	 * The boot CPU is always listed first, so CPU 0 is the one running
+	 * this.
+	 *
+	 * @return False if there is no MADT
+	 */
+	bool parse(void) {
+		for( uint8_t i = 0; i < ISA_IRQS; i++ )
+			isa[i] = {i, false, false};
+
+		cpus = 0;
+		if( lapic::is_enabled() )
+			add_cpu(lapic::id());
+
+		const acpi::madt *m = (const acpi::madt *) acpi::find_table("APIC");
+		if( !m ) {
+			logger::debug::puts("madt", "warn", "No MADT, assuming one CPU");
+			if( !cpus )
+				add_cpu(0);
+			return false;
+		}
+
+		pcat_compat = m->flags & MADT_PCAT_COMPAT;
+
+		const uint8_t *p   = (const uint8_t *) (m + 1);
+		const uint8_t *end = (const uint8_t *) m + m->header.length;
+		while( p + sizeof(acpi::madt_entry) <= end ) {
+			const acpi::madt_entry *e = (const acpi::madt_entry *) p;
+			if( e->length < sizeof(acpi::madt_entry) || p + e->length > end )
+				break;
+
+			switch( e->type ) {
+				case acpi::MADT_LAPIC: {
+					const acpi::madt_lapic *l =
+					    (const acpi::madt_lapic *) e;
+					if( l->flags & MADT_CPU_ENABLED )
+						add_cpu(l->apic_id);
+					break;
+				}
+				case acpi::MADT_X2APIC: {
+					const acpi::madt_x2apic *x =
+					    (const acpi::madt_x2apic *) e;
+					if( x->flags & MADT_CPU_ENABLED )
+						add_cpu(x->x2apic_id);
+					break;
+				}
+				case acpi::MADT_IOAPIC: {
+					const acpi::madt_ioapic *io =
+					    (const acpi::madt_ioapic *) e;
+					if( ioapic_total < MAX_IOAPICS )
+						ioapics[ioapic_total++] = {io->ioapic_id,
+						                           io->address,
+						                           io->gsi_base};
+					break;
+				}
+				case acpi::MADT_ISO:
+					add_override((const acpi::madt_iso *) e);
+					break;
+				default:
+					break;
+			}
+			p += e->length;
+		}
+
+		logger::debug::printf("madt",
+		                      "info",
+		                      "%u CPU(s), %u IOAPIC(s)%s\n",
+		                      cpus,
+		                      ioapic_total,
+		                      pcat_compat ? ", 8259 present" : "");
+		return true;
+	}
+
+	uint32_t cpu_count(void) {
+		return cpus;
+	}
+
+	uint32_t cpu_apic_id(uint32_t cpu) {
+		return cpu < cpus ? cpu_ids[cpu] : 0;
+	}
+
+	uint32_t ioapic_count(void) {
+		return ioapic_total;
+	}
+
+	const ioapic_info *get_ioapic(uint32_t index) {
+		return index < ioapic_total ? &ioapics[index] : nullptr;
+	}
+
+	isa_route get_isa_route(uint8_t irq) {
+		if( irq >= ISA_IRQS )
+			return {irq, false, false};
+		return isa[irq];
+	}
+
+	bool has_8259(void) {
+		return pcat_compat;
+	}
+}  // namespace amd64::madt
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Interrupt topology from the ACPI MADT: which local APICs (CPUs) exist,
+ * where the IOAPICs are and which global system interrupt (GSI) each ISA
+ * IRQ arrives on.  Without a MADT the ISA IRQs map 1:1 and only the boot
+ * CPU is known.
+ */
+namespace amd64::madt {
+	constexpr uint32_t MAX_CPUS    = 64;
+	constexpr uint32_t MAX_IOAPICS = 8;
+
+	struct ioapic_info {
+		uint8_t  id;
+		uint32_t address;
+		uint32_t gsi_base;  // GSI of its first input
+	};
+
+	// How an ISA IRQ is wired to the IOAPIC
+	struct isa_route {
+		uint32_t gsi;
+		bool     active_low;
+		bool     level;
+	};
+
+	bool parse(void);
+
+	uint32_t           cpu_count(void);
+	uint32_t           cpu_apic_id(uint32_t cpu);
+	uint32_t           ioapic_count(void);
+	const ioapic_info *get_ioapic(uint32_t index);
+	isa_route          get_isa_route(uint8_t irq);
+	bool               has_8259(void);
+}  // namespace amd64::madt
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#define RFLAGS_IF (1ULL << 9)
+
+/**
+ * @brief Disable interrupts and return the previous RFLAGS
+ */
+static inline uint64_t
+    irq_save(void) {
+	uint64_t flags;
+	__asm__ volatile("pushfq\n\tpopq %0\n\tcli" : "=r"(flags) : : "memory");
+	return flags;
+}
+
+/**
+ * @brief Restore the interrupt state saved by irq_save()
+ */
+static inline void
+    irq_restore(uint64_t flags) {
+	__asm__ volatile("pushq %0\n\tpopfq" : : "r"(flags) : "memory", "cc");
+}
+
+static inline bool
+    irq_enabled(void) {
+	uint64_t flags;
+	__asm__ volatile("pushfq\n\tpopq %0" : "=r"(flags));
+	return flags & RFLAGS_IF;
+}
+
+/**
+ * @brief Halt until @p *flag is set by an interrupt handler
+ *
+ * The flag is tested with interrupts off and they are re-enabled by the
+ * "sti; hlt" pair: sti only takes effect once hlt has started, so the
+ * wakeup cannot slip in between the test and the halt.  Interrupts are
+ * on when this returns.
+ */
+static inline void
+    irq_wait_for(volatile bool *flag) {
+	__asm__ volatile("cli");
+	while( !*flag )
+		__asm__ volatile("sti; hlt; cli");
+	__asm__ volatile("sti");
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#define MSR_IA32_APIC_BASE    0x1B
+#define MSR_IA32_TSC_DEADLINE 0x6E0
+
+static inline uint64_t
+    rdmsr(uint32_t msr) {
+	uint32_t lo, hi;
+	__asm__ volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+	return ((uint64_t) hi << 32) | lo;
+}
+
+static inline void
+    wrmsr(uint32_t msr, uint64_t val) {
+	__asm__ volatile("wrmsr"
+	                 :
+	                 : "c"(msr), "a"((uint32_t) val), "d"((uint32_t) (val >> 32))
+	                 : "memory");
+}
+
+/**
+ * @brief Read the TSC, ordered after every earlier load
+ */
+static inline uint64_t
+    rdtsc_ordered(void) {
+	uint32_t lo, hi;
+	__asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+	return ((uint64_t) hi << 32) | lo;
+}
@@ -15,6 +15,8 @@
 #include <kstddef.h>
 #include <kstdint.h>
 
+#include <arch/amd64/cpu/percpu.h>
+
 char     cpu_brand_string[CPU_BRAND_STRING_LEN + 1] = "Unknown CPU";
 char     cpu_vendor_string[13]                      = "Unknown";  // 12 + null termination
 uint32_t cpu_core_id                                = 0;
@@ -27,10 +29,18 @@ namespace amd64::cpuid {
 		    : "a"(eax), "c"(ecx));
 	}
 
+	/**
+	 * @brief Raw CPUID: EAX, EBX, ECX, EDX of leaf @p eax, subleaf @p ecx
+	 */
+	void leaf(uint32_t eax, uint32_t ecx, uint32_t *regs) {
+		cpuid(eax, ecx, regs);
+	}
+
+	/**
+	 * @brief Index of the calling CPU (MADT order, boot CPU 0)
+	 */
 	uint32_t get_core_id(void) {
-		// TODO: Implement SMP (Symmetric Multiprocessing)
-		// For now, use a stub
-		return 0;
+		return percpu::id();
 	}
 
 	namespace instr {
@@ -53,6 +63,112 @@ namespace amd64::cpuid {
 			cpuid(1, 0, regs);
 			return regs[3] & (1 << 0);  // EDX bit 0 = FPU is present
 		}
+
+		/**
+ * @brief Checks if the CPU has the RDRAND instruction
+ * @return True if the CPU does have, false if not
+ */
+		bool has_rdrand(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[2] & (1 << 30);  // ECX bit 30 = RDRAND
+		}
+
+		/**
+ * @brief Checks if the CPU has the RDSEED instruction
+ * @return True if the CPU does have, false if not
+ */
+		bool has_rdseed(void) {
+			uint32_t regs[4];
+			cpuid(0, 0, regs);
+			if( regs[0] < 7 )
+				return false;
+			cpuid(7, 0, regs);
+			return regs[1] & (1 << 18);  // EBX bit 18 = RDSEED
+		}
+
+		/**
+ * @brief Checks if the CPU has a local APIC
+ * @return True if the CPU does have, false if not
+ */
+		bool has_apic(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[3] & (1 << 9);  // EDX bit 9 = APIC
+		}
+
+		/**
+ * @brief Checks if the local APIC can run in x2APIC (MSR) mode
+ * @return True if the CPU does have, false if not
+ */
+		bool has_x2apic(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[2] & (1 << 21);  // ECX bit 21 = x2APIC
+		}
+
+		/**
+ * @brief Checks if the local APIC timer supports TSC-deadline mode
+ * @return True if the CPU does have, false if not
+ */
+		bool has_tsc_deadline(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[2] & (1 << 24);  // ECX bit 24 = TSC-deadline
+		}
+
+		/**
+ * @brief Checks if the CPU has an invariant TSC
+ *
+ * An invariant TSC ticks at a constant rate in every P-, C- and T-state,
+ * so it can be used as a wall clock once its frequency is known.
+ *
+ * @return True if the CPU does have, false if not
+ */
+		bool has_invariant_tsc(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			if( !(regs[3] & (1 << 4)) )  // EDX bit 4 = TSC
+				return false;
+			cpuid(0x80000000, 0, regs);
+			if( regs[0] < 0x80000007 )
+				return false;
+			cpuid(0x80000007, 0, regs);
+			return regs[3] & (1 << 8);  // EDX bit 8 = Invariant TSC
+		}
+
+		/**
+ * @brief Checks if the CPU has XSAVE/XRSTOR and XCR0
+ * @return True if the CPU does have, false if not
+ */
+		bool has_xsave(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[2] & (1 << 26);  // ECX bit 26 = XSAVE
+		}
+
+		/**
+ * @brief Checks if the CPU has AVX (usable once XCR0 enables its state)
+ * @return True if the CPU does have, false if not
+ */
+		bool has_avx(void) {
+			uint32_t regs[4];
+			cpuid(1, 0, regs);
+			return regs[2] & (1 << 28);  // ECX bit 28 = AVX
+		}
+
+		/**
+ * @brief Checks if the CPU has AVX-512 Foundation
+ * @return True if the CPU does have, false if not
+ */
+		bool has_avx512f(void) {
+			uint32_t regs[4];
+			cpuid(0, 0, regs);
+			if( regs[0] < 7 )
+				return false;
+			cpuid(7, 0, regs);
+			return regs[1] & (1 << 16);  // EBX bit 16 = AVX512F
+		}
 	}  // namespace instr
 
 	namespace vendor {
@@ -19,9 +19,21 @@ extern char     cpu_vendor_string[13];
 extern uint32_t cpu_core_id;
 
 namespace amd64::cpuid {
+	uint32_t get_core_id(void);
+	void     leaf(uint32_t eax, uint32_t ecx, uint32_t *regs);
+
 	namespace instr {
 		bool has_sse2(void);
 		bool has_fpu(void);
+		bool has_rdrand(void);
+		bool has_rdseed(void);
+		bool has_apic(void);
+		bool has_x2apic(void);
+		bool has_tsc_deadline(void);
+		bool has_invariant_tsc(void);
+		bool has_xsave(void);
+		bool has_avx(void);
+		bool has_avx512f(void);
 	}  // namespace instr
 
 	namespace vendor {
@@ -1,6 +1,64 @@
+#include "fpu.h"
+
+#include <kmemset.h>
 #include <kstdint.h>
 
+#include <arch/amd64/cpu/cpuid.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <dbg/logger.h>
+
+#define CR0_TS      (1ULL << 3)
+#define CR4_OSXSAVE (1ULL << 18)
+
+#define XSTATE_AVX512 (XSTATE_OPMASK | XSTATE_ZMM_HI256 | XSTATE_HI16_ZMM)
+
+// Legacy area fields that differ from zero in the initial state
+#define FXSAVE_FCW_OFFSET   0
+#define FXSAVE_MXCSR_OFFSET 24
+#define FCW_DEFAULT         0x037F
+#define MXCSR_DEFAULT       0x1F80
+#define FXSAVE_SIZE         512
+
 namespace amd64::fpu {
+	enum class method : uint8_t {
+		fxsave,
+		xsave,
+		xsaveopt
+	};
+
+	static method   save_method = method::fxsave;
+	static uint64_t xcr0        = XSTATE_X87 | XSTATE_SSE;
+	static size_t   area_size   = FXSAVE_SIZE;
+	static bool     ready       = false;
+
+	/*
+	 * Each CPU tracks, in its percpu block, the context it runs
+	 * (fpu_current) and the one whose state is in its registers
+	 * (fpu_owner); CR0.TS is set exactly when they differ.  The boot code
+	 * runs on boot_context.  Other CPUs start with neither, so their own
+	 * kernel code clobbers nobody's state.
+	 */
+	static context boot_context;
+
+	static inline void xsetbv(uint32_t reg, uint64_t value) {
+		uint32_t lo = (uint32_t) value;
+		uint32_t hi = (uint32_t) (value >> 32);
+		__asm__ volatile("xsetbv" : : "c"(reg), "a"(lo), "d"(hi));
+	}
+
+	static inline void set_ts(percpu::cpu *c, bool on) {
+		if( on == c->fpu_ts_set )
+			return;
+		if( on ) {
+			uint64_t cr0;
+			__asm__ volatile("mov %%cr0, %0" : "=r"(cr0));
+			__asm__ volatile("mov %0, %%cr0" : : "r"(cr0 | CR0_TS));
+		} else {
+			__asm__ volatile("clts");
+		}
+		c->fpu_ts_set = on;
+	}
+
 	void enable(void) {
 		// Enable FPU
 		uint64_t cr0;
@@ -12,4 +70,195 @@ namespace amd64::fpu {
 		// Initialize FPU
 		__asm__ volatile("fninit");
 	}
+
+	/**
+	 * @brief Enable XSAVE and the AVX/AVX-512 state, and size the save area
+	 *
+	 * AVX-512 is left off if its area would not fit in AREA_MAX.  Must run
+	 * once on the boot CPU before anything saves or switches FPU state.
+	 */
+	void init(void) {
+		if( cpuid::instr::has_xsave() ) {
+			uint64_t cr4;
+			__asm__ volatile("mov %%cr4, %0" : "=r"(cr4));
+			__asm__ volatile("mov %0, %%cr4" : : "r"(cr4 | CR4_OSXSAVE));
+
+			uint32_t regs[4];
+			cpuid::leaf(0xD, 0, regs);
+			uint64_t supported = regs[0] | ((uint64_t) regs[3] << 32);
+
+			uint64_t want = XSTATE_X87 | XSTATE_SSE;
+			if( cpuid::instr::has_avx() )
+				want |= XSTATE_AVX;
+			if( cpuid::instr::has_avx512f() && (want & XSTATE_AVX) )
+				want |= XSTATE_AVX512;
+			want &= supported;
+			if( (want & XSTATE_AVX512) != XSTATE_AVX512 )
+				want &= ~XSTATE_AVX512;
+
+			for( ;; ) {
+				xsetbv(0, want);
+				cpuid::leaf(0xD, 0, regs);  // EBX: area size for XCR0
+				if( regs[1] <= AREA_MAX || !(want & XSTATE_AVX512) )
+					break;
+				want &= ~XSTATE_AVX512;
+			}
+
+			xcr0      = want;
+			area_size = regs[1];
+
+			cpuid::leaf(0xD, 1, regs);
+			save_method = (regs[0] & 1) ? method::xsaveopt : method::xsave;
+		}
+
+		init_context(&boot_context);
+		percpu::cpu *c = percpu::get();
+		c->fpu_current = &boot_context;
+		c->fpu_owner   = &boot_context;
+		ready          = true;
+
+		logger::debug::printf("fpu",
+		                      "info",
+		                      "%s, XCR0 0x%llx, %llu byte save area\n",
+		                      get_save_method(),
+		                      xcr0,
+		                      (uint64_t) area_size);
+	}
+
+	/**
+	 * @brief Turn on, on the calling CPU, the state init() chose
+	 *
+	 * For the other CPUs as they start; init() must have run.
+	 */
+	void init_cpu(void) {
+		enable();
+		if( save_method != method::fxsave ) {
+			uint64_t cr4;
+			__asm__ volatile("mov %%cr4, %0" : "=r"(cr4));
+			__asm__ volatile("mov %0, %%cr4" : : "r"(cr4 | CR4_OSXSAVE));
+			xsetbv(0, xcr0);
+		}
+	}
+
+	uint64_t get_features(void) {
+		return xcr0;
+	}
+
+	size_t get_area_size(void) {
+		return area_size;
+	}
+
+	const char *get_save_method(void) {
+		switch( save_method ) {
+			case method::xsaveopt:
+				return "xsaveopt";
+			case method::xsave:
+				return "xsave";
+			case method::fxsave:
+				break;
+		}
+		return "fxsave";
+	}
+
+	/**
+	 * @brief Put @p c in the initial FPU state
+	 *
+	 * An XSAVE header of zeros makes XRSTOR initialize every component;
+	 * FCW and MXCSR are read from the legacy area either way.
+	 */
+	void init_context(context *c) {
+		kstring::memset(c->area, 0, area_size);
+		uint16_t fcw   = FCW_DEFAULT;
+		uint32_t mxcsr = MXCSR_DEFAULT;
+		__builtin_memcpy(c->area + FXSAVE_FCW_OFFSET, &fcw, sizeof(fcw));
+		__builtin_memcpy(c->area + FXSAVE_MXCSR_OFFSET, &mxcsr, sizeof(mxcsr));
+	}
+
+	/**
+	 * @brief Save the registers into @p c now, whoever owns them
+	 */
+	void save(context *c) {
+		uint32_t lo = (uint32_t) xcr0;
+		uint32_t hi = (uint32_t) (xcr0 >> 32);
+		switch( save_method ) {
+			case method::xsaveopt:
+				__asm__ volatile("xsaveopt64 (%0)"
+				                 :
+				                 : "r"(c->area), "a"(lo), "d"(hi)
+				                 : "memory");
+				break;
+			case method::xsave:
+				__asm__ volatile("xsave64 (%0)"
+				                 :
+				                 : "r"(c->area), "a"(lo), "d"(hi)
+				                 : "memory");
+				break;
+			case method::fxsave:
+				__asm__ volatile(
+				    "fxsave64 (%0)" : : "r"(c->area) : "memory");
+				break;
+		}
+	}
+
+	/**
+	 * @brief Load the registers from @p c now
+	 */
+	void restore(const context *c) {
+		uint32_t lo = (uint32_t) xcr0;
+		uint32_t hi = (uint32_t) (xcr0 >> 32);
+		if( save_method == method::fxsave )
+			__asm__ volatile("fxrstor64 (%0)" : : "r"(c->area) : "memory");
+		else
+			__asm__ volatile("xrstor64 (%0)"
+			                 :
+			                 : "r"(c->area), "a"(lo), "d"(hi)
+			                 : "memory");
+	}
+
+	context *get_current(void) {
+		return percpu::get()->fpu_current;
+	}
+
+	/**
+	 * @brief Make @p next the context on this CPU
+	 *
+	 * Saves and loads nothing; see handle_nm().  Call with interrupts off.
+	 */
+	void switch_to(context *next) {
+		percpu::cpu *c = percpu::get();
+		c->fpu_current = next;
+		set_ts(c, c->fpu_owner != next);
+	}
+
+	/**
+	 * @brief Forget @p ctx before its memory is reused
+	 *
+	 * Call on the CPU @p ctx last ran on; only that CPU can hold it.
+	 */
+	void release(context *ctx) {
+		percpu::cpu *c = percpu::get();
+		if( c->fpu_owner == ctx )
+			c->fpu_owner = nullptr;
+	}
+
+	/**
+	 * @brief #NM: hand the registers to the current context
+	 *
+	 * @return False if the fault is not ours to handle (lazy switching is
+	 *         not set up), so the caller should treat it as fatal
+	 */
+	bool handle_nm(void) {
+		percpu::cpu *c = percpu::get();
+		if( !ready || !c->fpu_ts_set )
+			return false;
+
+		set_ts(c, false);
+		if( c->fpu_owner != c->fpu_current ) {
+			if( c->fpu_owner )
+				save(c->fpu_owner);
+			restore(c->fpu_current);
+			c->fpu_owner = c->fpu_current;
+		}
+		return true;
+	}
 }  // namespace amd64::fpu
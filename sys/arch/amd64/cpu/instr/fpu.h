@@ -1,5 +1,51 @@
 #pragma once
 
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * FPU/SIMD register state.
+ *
+ * init() turns on XSAVE when the CPU has it and enables the user state
+ * components up to AVX-512 in XCR0; the save area size then comes from
+ * CPUID leaf 0xD.  Without XSAVE the 512-byte FXSAVE area is used.
+ *
+ * Switching is lazy.  switch_to() only records the incoming context and
+ * sets CR0.TS if that context does not own the registers.  Its first
+ * FPU/SSE/AVX instruction raises #NM, and handle_nm() saves the owner
+ * (XSAVEOPT skips components that are unmodified or in their initial
+ * state) and loads the new context.  A context that never touches the
+ * FPU never pays for a save or a restore.
+ */
 namespace amd64::fpu {
-	void enable(void);
-}
\ No newline at end of file
+	// XCR0 state components
+	constexpr uint64_t XSTATE_X87       = 1ULL << 0;
+	constexpr uint64_t XSTATE_SSE       = 1ULL << 1;
+	constexpr uint64_t XSTATE_AVX       = 1ULL << 2;
+	constexpr uint64_t XSTATE_OPMASK    = 1ULL << 5;
+	constexpr uint64_t XSTATE_ZMM_HI256 = 1ULL << 6;
+	constexpr uint64_t XSTATE_HI16_ZMM  = 1ULL << 7;
+
+	// Largest save area a context holds; init() enables no more than fits
+	constexpr size_t AREA_MAX = 4096;
+
+	// Saved registers of one task
+	struct context {
+		alignas(64) uint8_t area[AREA_MAX];
+	};
+
+	void        enable(void);
+	void        init(void);
+	void        init_cpu(void);
+	uint64_t    get_features(void);
+	size_t      get_area_size(void);
+	const char *get_save_method(void);
+
+	void     init_context(context *c);
+	context *get_current(void);
+	void     switch_to(context *next);
+	void     release(context *c);
+	bool     handle_nm(void);
+	void     save(context *c);
+	void     restore(const context *c);
+}  // namespace amd64::fpu
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "percpu.h"
+
+#include <kmemset.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/msr.h>
+
+#define MSR_GS_BASE        0xC0000101
+#define MSR_KERNEL_GS_BASE 0xC0000102
+
+namespace amd64::percpu {
+	static_assert(__builtin_offsetof(cpu, kernel_rsp) == KERNEL_RSP_OFFSET
+	                  && __builtin_offsetof(cpu, user_rsp) == USER_RSP_OFFSET
+	                  && __builtin_offsetof(cpu, id) == ID_OFFSET,
+	              "syscall.asm hardcodes the layout");
+
+	static cpu cpus[madt::MAX_CPUS];
+
+	/**
+	 * @brief Point the calling CPU's GS base at block @p id
+	 *
+	 * The boot CPU calls this before anything else in start_kernel(), so
+	 * get() and id() are valid everywhere after it.  KERNEL_GS_BASE holds
+	 * the ring 3 base that swapgs exchanges in.  apic_id and online are
+	 * filled in by smp once the local APIC is up.
+	 */
+	void init(uint32_t id) {
+		cpu *c = &cpus[id];
+		kstring::memset(c, 0, sizeof(*c));
+		c->self = c;
+		c->id   = id;
+
+		wrmsr(MSR_GS_BASE, (uint64_t) c);
+		wrmsr(MSR_KERNEL_GS_BASE, 0);
+	}
+
+	/**
+	 * @brief Per-CPU block of CPU @p id, for reading another CPU's state
+	 */
+	cpu *of(uint32_t id) {
+		return id < madt::MAX_CPUS ? &cpus[id] : nullptr;
+	}
+}  // namespace amd64::percpu
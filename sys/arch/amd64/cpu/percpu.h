@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+namespace amd64::fpu {
+	struct context;
+}
+
+/*
+ * Per-CPU data, reached through GS.
+ *
+ * Every CPU points its GS base at its own cpu block, so the fields below
+ * are one gs-relative load away and never shared between CPUs.  Kernel
+ * code always runs with that base; the entry stubs swapgs on the way in
+ * from ring 3 and on the way back, so ring 3 gets its own (zero) base.
+ *
+ * Larger per-CPU caches (work queues, irqstat, RNG streams) stay in their
+ * own modules as cache-line aligned arrays indexed by id().
+ */
+namespace amd64::percpu {
+	struct alignas(64) cpu {
+		cpu     *self;        // Address of this block, for get()
+		uint64_t kernel_rsp;  // Stack syscall_entry switches to
+		uint64_t user_rsp;    // Ring 3 stack while in a syscall
+		uint32_t id;          // Index in MADT order; the boot CPU is 0
+		uint32_t apic_id;
+
+		void *task;  // Task running here, nullptr until there is one
+
+		// Lazy FPU state, see fpu::switch_to()
+		fpu::context *fpu_current;
+		fpu::context *fpu_owner;
+		bool          fpu_ts_set;
+
+		uint64_t timer_armed_ns;  // Local timer deadline, ~0 when idle
+
+		volatile bool online;  // Set once the CPU reaches its idle loop
+	};
+
+	// Offsets used by the assembly entry stubs
+	constexpr size_t KERNEL_RSP_OFFSET = 8;
+	constexpr size_t USER_RSP_OFFSET   = 16;
+	constexpr size_t ID_OFFSET         = 24;
+
+	void init(uint32_t id);
+	cpu *of(uint32_t id);
+
+	/**
+	 * @brief Per-CPU block of the calling CPU
+	 */
+	static inline cpu *get(void) {
+		cpu *c;
+		__asm__ volatile("movq %%gs:0, %0" : "=r"(c));
+		return c;
+	}
+
+	/**
+	 * @brief Index of the calling CPU, 0 to MAX_CPUS - 1
+	 */
+	static inline uint32_t id(void) {
+		uint32_t n;
+		__asm__ volatile("movl %%gs:%c1, %0" : "=r"(n) : "i"(ID_OFFSET));
+		return n;
+	}
+}  // namespace amd64::percpu
@@ -0,0 +1,49 @@
+; SPDX-License-Identifier: GPL-3.0-only
+;
+; -- BEGIN METADATA HEADER --
+; The Wind/Tempest Project
+;
+; File       : sys/arch/amd64/cpu/switch.asm
+; Author     : Tempik25 <tempik25@tempestfoundation.org>
+; Maintainer : Tempest Foundation <development@tempestfoundation.org>
+; Repo       : https://wtsrc.tempestfoundation.org
+;
+; Copyright (C) 2025 Tempest Foundation
+; -- END OF METADATA HEADER --
+;
+global context_switch, thread_entry
+
+section .text
+
+; void context_switch(uint64_t *prev_rsp, uint64_t next_rsp)
+;
+; Saves the callee-saved registers on the current stack, stores the stack
+; pointer in *prev_rsp and resumes the thread whose stack is next_rsp.
+; The caller-saved registers are already dead across the call, and RFLAGS
+; is not switched: both sides run with interrupts off here and restore
+; their own state once back in C++.
+context_switch:
+    push rbp
+    push rbx
+    push r12
+    push r13
+    push r14
+    push r15
+    mov [rdi], rsp
+    mov rsp, rsi
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbx
+    pop rbp
+    ret
+
+; First return of a new thread; sched::spawn() lays out a frame whose
+; r12 is the thread and r13 the C++ function to start it in.  The frame
+; ends 16-byte aligned, so the call lands with the alignment the ABI
+; expects.  That function never returns.
+thread_entry:
+    mov rdi, r12
+    call r13
+    ud2
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "gdt.h"
+
+#include <kmemset.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/cpu/percpu.h>
+
+namespace amd64::gdt {
+	struct tss {
+		uint32_t reserved0;
+		uint64_t rsp[3];  // Stack loaded on entry to ring 0-2
+		uint64_t reserved1;
+		uint64_t ist[7];
+		uint64_t reserved2;
+		uint16_t reserved3;
+		uint16_t iopb;  // Offset of the I/O bitmap; past the end means none
+	} __attribute__((packed));
+
+	struct gdt_ptr {
+		uint16_t limit;
+		uint64_t base;
+	} __attribute__((packed));
+
+	// Flat segments; only the type, DPL and L bits matter in long mode
+	constexpr uint64_t KERNEL_CODE_DESC = 0x00AF9A000000FFFFULL;
+	constexpr uint64_t KERNEL_DATA_DESC = 0x00CF92000000FFFFULL;
+	constexpr uint64_t USER_DATA_DESC   = 0x00CFF2000000FFFFULL;
+	constexpr uint64_t USER_CODE_DESC   = 0x00AFFA000000FFFFULL;
+
+	constexpr uint64_t TSS_PRESENT_AVAILABLE = 0x89;
+
+	// One GDT and TSS per CPU: the TSS descriptor turns busy once loaded,
+	// so no two CPUs can ltr the same one
+	struct cpu_tables {
+		tss      task_state;
+		uint64_t table[7];  // The TSS descriptor takes two slots
+	};
+
+	static cpu_tables cpus[madt::MAX_CPUS];
+
+	/**
+	 * @brief Replace the boot GDT of the calling CPU and load its TSS
+	 *
+	 * The kernel code selector stays 0x08, so the IDT gates set up before
+	 * or after this keep working.
+	 */
+	void init_cpu(uint32_t cpu) {
+		tss      &task_state = cpus[cpu].task_state;
+		uint64_t *table      = cpus[cpu].table;
+
+		kstring::memset(&task_state, 0, sizeof(task_state));
+		task_state.iopb = sizeof(task_state);
+
+		uint64_t base  = (uint64_t) &task_state;
+		uint64_t limit = sizeof(task_state) - 1;
+
+		table[0] = 0;
+		table[1] = KERNEL_CODE_DESC;
+		table[2] = KERNEL_DATA_DESC;
+		table[3] = USER_DATA_DESC;
+		table[4] = USER_CODE_DESC;
+		table[5] = (limit & 0xFFFF) | ((base & 0xFFFFFF) << 16)
+		         | (TSS_PRESENT_AVAILABLE << 40) | (((limit >> 16) & 0xF) << 48)
+		         | (((base >> 24) & 0xFF) << 56);
+		table[6] = base >> 32;
+
+		gdt_ptr ptr = {sizeof(cpus[cpu].table) - 1, (uint64_t) table};
+		__asm__ volatile("lgdt %0\n\t"
+		                 "pushq %1\n\t"
+		                 "leaq 1f(%%rip), %%rax\n\t"
+		                 "pushq %%rax\n\t"
+		                 "lretq\n"
+		                 "1:\n\t"
+		                 "movw %2, %%ax\n\t"
+		                 "movw %%ax, %%ss\n\t"
+		                 "movw %%ax, %%ds\n\t"
+		                 "movw %%ax, %%es\n\t"
+		                 "ltr %3"
+		                 :
+		                 : "m"(ptr),
+		                   "i"((uint64_t) KERNEL_CS),
+		                   "i"(KERNEL_DS),
+		                   "r"(TSS)
+		                 : "rax", "memory");
+	}
+
+	void init(void) {
+		init_cpu(0);
+	}
+
+	/**
+	 * @brief Stack the calling CPU switches to when an interrupt arrives
+	 *        in ring 3
+	 */
+	void set_kernel_stack(uint64_t rsp0) {
+		cpus[percpu::id()].task_state.rsp[0] = rsp0;
+	}
+}  // namespace amd64::gdt
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Long mode GDT and TSS.
+ *
+ * The order is fixed by SYSCALL/SYSRET, which derive every selector from
+ * the two bases in the STAR MSR: kernel code, then kernel data; user data,
+ * then user code, 16 bytes after the sysret base.
+ */
+namespace amd64::gdt {
+	constexpr uint16_t KERNEL_CS = 0x08;
+	constexpr uint16_t KERNEL_DS = 0x10;
+	constexpr uint16_t USER_DS   = 0x18 | 3;
+	constexpr uint16_t USER_CS   = 0x20 | 3;
+	constexpr uint16_t TSS       = 0x28;
+
+	// STAR[63:48]: SYSRET loads CS from this + 16 and SS from this + 8
+	constexpr uint16_t SYSRET_BASE = 0x10 | 3;
+
+	void init(void);
+	void init_cpu(uint32_t cpu);
+	void set_kernel_stack(uint64_t rsp0);
+}  // namespace amd64::gdt
@@ -10,12 +10,22 @@
  * -- END OF METADATA HEADER --
  */
 #include "idt.h"
+#include "irqstat.h"
 
 #include <kstdio.h>
 
+#include <arch/amd64/apic/ioapic.h>
+#include <arch/amd64/apic/lapic.h>
+#include <arch/amd64/apic/madt.h>
 #include <arch/amd64/asm/io.h>
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/cpu/instr/fpu.h>
 #include <dbg/logger.h>
 #include <kern/panic/panic.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/rcu.h>
+#include <kern/work/work.h>
 
 // PIC (Programmable Interrupt Controller) ports.
 #define PIC1_CMD  0x20
@@ -74,6 +84,12 @@ void
     irq14();
 void
     irq15();
+void
+    irq16();
+void
+    irq17();
+void
+    irq_spurious();
 
 void
     isr0();
@@ -144,8 +160,12 @@ void
     syscall_int_handler();
 }
 
-// Array of C-level interrupt handlers.
-static irq_handler_t irq_handlers[16];
+// Array of C-level interrupt handlers, published with RCU.  Handlers run
+// with interrupts off, which is a read-side section.
+static irq_handler_t irq_handlers[amd64::irq::COUNT];
+
+// Set once the ISA IRQs come through the IOAPIC and the PICs are masked
+static bool ioapic_routing = false;
 
 // IDT entry structure.
 struct idt_entry {
@@ -204,26 +224,44 @@ static int
 // Default C-level handlers.
 extern "C" void
     isr_handler(registers_t *regs) {
+	// Device Not Available: the first FPU use after a lazy switch
+	if( regs->int_no == 7 && amd64::fpu::handle_nm() )
+		return;
+
 	int panic_code = get_panic_code_for_interrupt((uint8_t) regs->int_no);
 	panic::init(panic_code, regs);
 }
 
 extern "C" void
     irq_handler(registers_t *regs) {
-	// If a custom handler is registered, call it.
-	if( regs->int_no >= idt_constants::IRQ_BASE && regs->int_no <= 47 ) {
-		irq_handler_t handler =
-		    irq_handlers[regs->int_no - idt_constants::IRQ_BASE];
+	// If a custom handler is registered, call it, timed for irqstat.
+	if( regs->int_no >= idt_constants::IRQ_BASE
+	    && regs->int_no < idt_constants::IRQ_BASE + amd64::irq::COUNT ) {
+		int           irq     = (int) (regs->int_no - idt_constants::IRQ_BASE);
+		irq_handler_t handler = rcu::dereference(&irq_handlers[irq]);
+		uint64_t      start   = rdtsc_ordered();
 		if( handler ) {
 			handler(regs);
 		}
+		amd64::irq::stats::record(irq, rdtsc_ordered() - start);
 	}
 
-	// Send End-of-Interrupt (EOI) to the PICs.
-	if( regs->int_no >= 40 ) {
-		outb(PIC2_CMD, PIC_EOI);  // EOI to slave PIC.
+	// IOAPIC and local APIC vectors are acknowledged at the LAPIC.
+	if( ioapic_routing || regs->int_no >= amd64::irq::LAPIC_TIMER_VECTOR ) {
+		amd64::lapic::eoi();
+	} else {
+		// Send End-of-Interrupt (EOI) to the PICs.
+		if( regs->int_no >= 40 ) {
+			outb(PIC2_CMD, PIC_EOI);  // EOI to slave PIC.
+		}
+		outb(PIC1_CMD, PIC_EOI);  // EOI to master PIC.
 	}
-	outb(PIC1_CMD, PIC_EOI);  // EOI to master PIC.
+
+	// Bottom halves the handler queued, with interrupts back on
+	work::irq_exit();
+
+	// Switch threads if the interrupt woke something more important
+	sched::irq_exit();
 }
 
 // Remap the PIC to avoid conflicts with CPU exceptions
@@ -241,10 +279,110 @@ static void
 	outb(PIC2_DATA, 0x0);
 }
 
+// Mask every line on both PICs
+static void
+    pic_disable(void) {
+	outb(PIC1_DATA, 0xFF);
+	outb(PIC2_DATA, 0xFF);
+}
+
 namespace amd64 {
 	namespace irq {
+		/*
+		 * IRQ 2 is the PIC cascade and is never raised by a device.  Its
+		 * IOAPIC input is where the HPET lands in legacy replacement mode,
+		 * standing in for IRQ 0, so it shares IRQ 0's vector and handler.
+		 */
+		static int handler_line(int irq) {
+			return irq == 2 ? 0 : irq;
+		}
+
+		static uint32_t gsi_of(int irq) {
+			return madt::get_isa_route((uint8_t) irq).gsi;
+		}
+
+		/**
+		 * @brief Unmask an ISA line at the IOAPIC iff it has a handler
+		 */
+		static void update_mask(int irq) {
+			bool masked = irq_handlers[handler_line(irq)] == nullptr;
+			ioapic::set_masked(gsi_of(irq), masked);
+		}
+
+		/**
+		 * @brief Install @p handler for @p irq, or remove it with nullptr
+		 *
+		 * The old handler may still be running on another CPU when this
+		 * returns; rcu::synchronize() waits until it is not.
+		 */
 		void bind(int irq, irq_handler_t handler) {
-			irq_handlers[irq] = handler;
+			rcu::assign_pointer(&irq_handlers[irq], handler);
+
+			if( ioapic_routing && irq < ISA_COUNT ) {
+				update_mask(irq);
+				if( irq == 0 )
+					update_mask(2);
+			}
+		}
+
+		/**
+		 * @brief Move the ISA IRQs from the 8259 pair to the IOAPIC
+		 *
+		 * Every line keeps its vector (IRQ_BASE + n) and is sent to the
+		 * boot CPU, with the polarity and trigger mode from the MADT
+		 * overrides.  Lines without a handler stay masked.  Once this
+		 * returns true every interrupt is acknowledged with a single LAPIC
+		 * EOI.  Needs the ACPI tables and the local APIC.
+		 *
+		 * @return False if the PICs stay in charge
+		 */
+		bool init_apic(void) {
+			madt::parse();
+
+			if( !lapic::is_enabled() || !ioapic::init() ) {
+				logger::debug::puts("irq", "info", "Using the 8259 PIC");
+				return false;
+			}
+
+			uint32_t boot_cpu = lapic::id();
+			for( int irq = 0; irq < ISA_COUNT; irq++ ) {
+				madt::isa_route r = madt::get_isa_route((uint8_t) irq);
+				ioapic::route(r.gsi,
+				              (uint8_t) (idt_constants::IRQ_BASE
+				                         + handler_line(irq)),
+				              boot_cpu,
+				              r.active_low,
+				              r.level);
+			}
+
+			uint64_t flags = irq_save();
+			pic_disable();
+			ioapic_routing = true;
+			for( int irq = 0; irq < ISA_COUNT; irq++ )
+				update_mask(irq);
+			irq_restore(flags);
+
+			logger::debug::puts("irq", "info", "Using the IOAPIC");
+			return true;
+		}
+
+		/**
+		 * @brief Deliver ISA @p irq to CPU number @p cpu (MADT order)
+		 * @return False under the PIC or if the CPU cannot be addressed
+		 */
+		bool set_affinity(int irq, uint32_t cpu) {
+			if( !ioapic_routing || irq < 0 || irq >= ISA_COUNT
+			    || cpu >= madt::cpu_count() )
+				return false;
+
+			uint32_t apic_id = madt::cpu_apic_id(cpu);
+			if( irq == 0 )
+				ioapic::set_destination(gsi_of(2), apic_id);
+			return ioapic::set_destination(gsi_of(irq), apic_id);
+		}
+
+		const char *get_controller_name(void) {
+			return ioapic_routing ? "ioapic" : "8259";
 		}
 	}  // namespace irq
 
@@ -330,10 +468,30 @@ namespace amd64 {
 				    idt_constants::GATE_KERNEL_INTERRUPT);
 			}
 
+			// Local APIC vectors
+			set_gate(irq::LAPIC_TIMER_VECTOR,
+			         (uint64_t) irq16,
+			         idt_constants::KERNEL_CODE_SELECTOR,
+			         idt_constants::GATE_KERNEL_INTERRUPT);
+			set_gate(irq::IPI_VECTOR,
+			         (uint64_t) irq17,
+			         idt_constants::KERNEL_CODE_SELECTOR,
+			         idt_constants::GATE_KERNEL_INTERRUPT);
+			set_gate(irq::SPURIOUS_VECTOR,
+			         (uint64_t) irq_spurious,
+			         idt_constants::KERNEL_CODE_SELECTOR,
+			         idt_constants::GATE_KERNEL_INTERRUPT);
+
 			// Set up syscalls
 			setup_syscall();
 
-			// Load the IDT.
+			init_cpu();
+		}
+
+		/**
+		 * @brief Load the IDT on the calling CPU; every CPU shares it
+		 */
+		void init_cpu(void) {
 			__asm__ volatile("lidt %0" : : "m"(idtp));
 		}
 	}  // namespace idt
@@ -21,11 +21,25 @@ extern "C" void
 
 namespace amd64 {
 	namespace irq {
-		void bind(int irq, irq_handler_t handler);
-	}
+		// Lines 0-15 are the ISA IRQs; the ones after it are local APIC vectors
+		constexpr int ISA_COUNT   = 16;
+		constexpr int LAPIC_TIMER = 16;
+		constexpr int IPI         = 17;
+		constexpr int COUNT       = 18;
+
+		constexpr uint8_t LAPIC_TIMER_VECTOR = 48;
+		constexpr uint8_t IPI_VECTOR         = 49;
+		constexpr uint8_t SPURIOUS_VECTOR    = 0xFF;
+
+		void        bind(int irq, irq_handler_t handler);
+		bool        init_apic(void);
+		bool        set_affinity(int irq, uint32_t cpu);
+		const char *get_controller_name(void);
+	}  // namespace irq
 
 	namespace idt {
 		void setup_syscall(void);
 		void init(void);
+		void init_cpu(void);
 	}  // namespace idt
 }  // namespace amd64
\ No newline at end of file
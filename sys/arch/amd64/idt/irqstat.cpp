@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "irqstat.h"
+
+#include <kmemset.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/cpu/percpu.h>
+
+namespace amd64::irq::stats {
+	// One cache-line aligned block per CPU, so CPUs never share a line
+	struct alignas(64) cpu_counters {
+		kstat::hist::counts irq[COUNT];
+	};
+
+	static cpu_counters per_cpu[madt::MAX_CPUS];
+
+	/**
+	 * @brief Account one run of the handler of @p irq
+	 *
+	 * Called from irq_handler() with interrupts off.
+	 */
+	void record(int irq, uint64_t cycles) {
+		kstat::hist::add(&per_cpu[percpu::id()].irq[irq], cycles);
+	}
+
+	/**
+	 * @brief Sum the counters of @p irq over every CPU
+	 *
+	 * Runs unlocked against record(), so a summary taken while the IRQ
+	 * fires may be off by the interrupt in flight.
+	 */
+	void collect(int irq, summary *out) {
+		kstring::memset(out, 0, sizeof(*out));
+		if( irq < 0 || irq >= COUNT )
+			return;
+
+		for( uint32_t cpu = 0; cpu < madt::MAX_CPUS; cpu++ )
+			kstat::hist::merge(out, &per_cpu[cpu].irq[irq]);
+	}
+}  // namespace amd64::irq::stats
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#include <kern/stat/histogram.h>
+
+#include "idt.h"
+
+/*
+ * Per-IRQ interrupt counts and handler times.
+ *
+ * irq_handler() times every handler with the TSC and records it on the
+ * CPU it ran on, so recording takes no lock.  Durations go into a log2
+ * histogram per CPU; readers add the CPUs up into a summary.
+ */
+namespace amd64::irq::stats {
+	using summary = kstat::hist::summary;
+
+	void record(int irq, uint64_t cycles);
+	void collect(int irq, summary *out);
+}  // namespace amd64::irq::stats
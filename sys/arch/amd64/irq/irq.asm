@@ -11,8 +11,11 @@
 ; Copyright (C) 2025 Tempest Foundation
 ; -- END OF METADATA HEADER --
 ;
+%include "arch/amd64/isr/swapgs.inc"
+
 global irq0, irq1, irq2, irq3, irq4, irq5, irq6, irq7
 global irq8, irq9, irq10, irq11, irq12, irq13, irq14, irq15
+global irq16, irq17, irq_spurious
 
 ; Common IRQ stub
 %macro IRQ 2
@@ -42,9 +45,19 @@ IRQ 13, 45
 IRQ 14, 46
 IRQ 15, 47
 
+; Local APIC vectors, dispatched like the PIC lines
+IRQ 16, 48      ; LAPIC timer
+IRQ 17, 49      ; Reschedule IPI
+
+; The LAPIC spurious vector must not be acknowledged with an EOI
+irq_spurious:
+    iretq
+
 ; Common IRQ stub
 extern irq_handler
 irq_common_stub:
+    SWAPGS_IF_USER 24   ; CS, above the error code and vector
+
     ; Save all registers (push order must be the reverse of registers_t
     ; field order so that the top of the stack (lowest address) begins
     ; with r15 and the layout matches the structure exactly).
@@ -90,6 +103,7 @@ irq_common_stub:
     
     ; Remove error code and interrupt number
     add rsp, 16
+    SWAPGS_IF_USER 8
     
     ; Return from interrupt
     iretq 
\ No newline at end of file
@@ -11,6 +11,8 @@
 ; Copyright (C) 2025 Tempest Foundation
 ; -- END OF METADATA HEADER --
 ;
+%include "arch/amd64/isr/swapgs.inc"
+
 global isr0, isr1, isr2, isr3, isr4, isr5, isr6, isr7
 global isr8, isr9, isr10, isr11, isr12, isr13, isr14, isr15
 global isr16, isr17, isr18, isr19, isr20, isr21, isr22, isr23
@@ -108,6 +110,8 @@ ISR_NOERRCODE 31    ; Reserved
 ; ============================================================================
 extern isr_handler
 isr_common_stub:
+    SWAPGS_IF_USER 24   ; CS, above the error code and vector
+
     ; Save all general-purpose registers
     ; Push order matches registers_t structure layout (see registers.h)
     push rax
@@ -150,6 +154,7 @@ isr_common_stub:
     
     ; Remove error code and interrupt number from stack
     add rsp, 16
+    SWAPGS_IF_USER 8
     
     ; Return from interrupt (pops CS, RIP, RFLAGS, SS, RSP)
     iretq
\ No newline at end of file
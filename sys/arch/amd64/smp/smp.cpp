@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "smp.h"
+
+#include <kmemcpy.h>
+#include <ktime.h>
+
+#include <arch/amd64/apic/lapic.h>
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/cpu/instr/fpu.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/gdt/gdt.h>
+#include <arch/amd64/idt/idt.h>
+#include <arch/amd64/syscall/entry.h>
+#include <dbg/logger.h>
+#include <kern/sched/sched.h>
+#include <kern/timer/timer.h>
+
+// MP specification timings
+#define INIT_DELAY_NS    10000000ULL  // 10 ms after INIT
+#define STARTUP_DELAY_NS 200000ULL    // 200 us after the first SIPI
+#define ONLINE_WAIT_NS   500000000ULL
+
+// The APs start with the boot CPU's CR0, minus the lazy FPU trap
+#define CR0_TS (1ULL << 3)
+
+extern "C" {
+extern const uint8_t ap_trampoline[];
+extern const uint8_t ap_trampoline_end[];
+extern const uint8_t ap_params[];
+extern const uint8_t ap_park[];
+extern const uint8_t ap_park_end[];
+}
+
+namespace amd64::smp {
+	// Layout of ap_params in trampoline.asm
+	struct trampoline_params {
+		uint64_t cr3;
+		uint64_t cr0;
+		uint64_t stack;
+		uint64_t entry;
+		uint64_t cpu;
+	};
+
+	alignas(16) static uint8_t ap_stacks[madt::MAX_CPUS - 1][AP_STACK_SIZE];
+
+	// What the trampoline copy overwrote, put back once every CPU is up
+	// (it stays overwritten if one never checks in, see init())
+	static uint8_t saved[4096];
+
+	static uint32_t online = 1;
+
+	static void spin_ns(uint64_t ns) {
+		uint64_t end = time::now_ns() + ns;
+		while( time::now_ns() < end )
+			__asm__ volatile("pause");
+	}
+
+	/**
+	 * @brief First C++ code on an application processor
+	 *
+	 * Same per-CPU setup the boot CPU did in start_kernel(), in the same
+	 * order: GS first, so everything after it may use percpu.
+	 */
+	[[noreturn]] static void ap_main(uint64_t cpu) {
+		uint32_t id = (uint32_t) cpu;
+		percpu::init(id);
+		gdt::init_cpu(id);
+		idt::init_cpu();
+		fpu::init_cpu();
+		lapic::init();
+		timer_init_cpu();
+		syscall::init_cpu();
+		sched::init_cpu();
+
+		percpu::cpu *c = percpu::get();
+		c->apic_id     = lapic::id();
+		__atomic_store_n(&c->online, true, __ATOMIC_RELEASE);
+
+		sched::idle();
+	}
+
+	/**
+	 * @brief Run INIT-SIPI-SIPI on CPU @p cpu and wait for it to check in
+	 *
+	 * A second start-up IPI is ignored by a CPU that took the first one,
+	 * so it is only skipped when the CPU is already known to be up.
+	 */
+	static bool start_cpu(uint32_t cpu, trampoline_params *params) {
+		params->stack = (uint64_t) (ap_stacks[cpu - 1] + AP_STACK_SIZE);
+		params->cpu   = cpu;
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		const percpu::cpu *c       = percpu::of(cpu);
+		uint32_t           apic_id = madt::cpu_apic_id(cpu);
+		uint8_t            page    = (uint8_t) (TRAMPOLINE_BASE >> 12);
+
+		lapic::send_init(apic_id);
+		spin_ns(INIT_DELAY_NS);
+
+		lapic::send_startup(apic_id, page);
+		spin_ns(STARTUP_DELAY_NS);
+		if( !__atomic_load_n(&c->online, __ATOMIC_ACQUIRE) )
+			lapic::send_startup(apic_id, page);
+
+		uint64_t end = time::now_ns() + ONLINE_WAIT_NS;
+		while( !__atomic_load_n(&c->online, __ATOMIC_ACQUIRE) ) {
+			if( time::now_ns() >= end )
+				return false;
+			__asm__ volatile("pause");
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Start every CPU the MADT lists
+	 *
+	 * Needs the MADT, the local APIC and a clocksource for the delays; on
+	 * the PIT fallback that means interrupts must be on.
+	 *
+	 * A CPU that does not check in may still be woken by its start-up IPI
+	 * later, so the trampoline page is then not given back: its entry
+	 * point is replaced with a halt loop for that CPU to park on.
+	 *
+	 * @return Number of CPUs online, the boot CPU included
+	 */
+	uint32_t init(void) {
+		percpu::get()->apic_id = lapic::id();
+		percpu::get()->online  = true;
+
+		uint32_t cpus = madt::cpu_count();
+		if( !lapic::is_enabled() || cpus < 2 ) {
+			logger::debug::puts("smp", "info", "Single CPU");
+			return online;
+		}
+
+		size_t   len  = (size_t) (ap_trampoline_end - ap_trampoline);
+		uint8_t *copy = (uint8_t *) TRAMPOLINE_BASE;
+		if( len > sizeof(saved) )
+			return online;
+		kstring::memcpy(saved, copy, len);
+		kstring::memcpy(copy, ap_trampoline, len);
+
+		trampoline_params *params =
+		    (trampoline_params *) (copy + (ap_params - ap_trampoline));
+		uint64_t cr3, cr0;
+		__asm__ volatile("mov %%cr3, %0" : "=r"(cr3));
+		__asm__ volatile("mov %%cr0, %0" : "=r"(cr0));
+		params->cr3   = cr3;
+		params->cr0   = cr0 & ~CR0_TS;
+		params->entry = (uint64_t) ap_main;
+
+		bool stray = false;
+		for( uint32_t cpu = 1; cpu < cpus; cpu++ ) {
+			if( start_cpu(cpu, params) ) {
+				online++;
+				continue;
+			}
+			stray = true;
+			logger::debug::printf("smp",
+			                      "warn",
+			                      "CPU %u (APIC %u) did not start\n",
+			                      cpu,
+			                      madt::cpu_apic_id(cpu));
+		}
+
+		if( stray )
+			kstring::memcpy(copy, ap_park, (size_t) (ap_park_end - ap_park));
+		else
+			kstring::memcpy(copy, saved, len);
+		logger::debug::printf(
+		    "smp", "info", "%u of %u CPUs online\n", online, cpus);
+		return online;
+	}
+
+	uint32_t online_count(void) {
+		return online;
+	}
+
+	bool is_online(uint32_t cpu) {
+		const percpu::cpu *c = percpu::of(cpu);
+		return c && __atomic_load_n(&c->online, __ATOMIC_ACQUIRE);
+	}
+
+	/**
+	 * @brief Send the reschedule IPI to CPU @p cpu
+	 *
+	 * It carries no message: the interrupt exit on the target runs the
+	 * work queued for it and switches threads if one was made ready there.
+	 */
+	void kick(uint32_t cpu) {
+		if( is_online(cpu) )
+			lapic::send_ipi(percpu::of(cpu)->apic_id, irq::IPI_VECTOR);
+	}
+}  // namespace amd64::smp
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Starting the application processors.
+ *
+ * Every CPU the MADT lists is woken with INIT and two start-up IPIs, one
+ * at a time.  It runs the real mode trampoline into long mode, loads its
+ * own GDT/TSS, the shared IDT, its per-CPU GS base, FPU state, local APIC
+ * and timer and SYSCALL MSRs, then becomes that CPU's idle thread
+ * (sched::idle()).  Device interrupts stay routed to the boot CPU, so the
+ * others only wake for IPIs and their own LAPIC timer.
+ */
+namespace amd64::smp {
+	// Physical page the trampoline is copied to; must be below 1 MiB
+	constexpr uint64_t TRAMPOLINE_BASE = 0x8000;
+
+	// Stack of each application processor; its idle thread keeps it
+	constexpr uint64_t AP_STACK_SIZE = 16384;
+
+	uint32_t init(void);
+	uint32_t online_count(void);
+	bool     is_online(uint32_t cpu);
+	void     kick(uint32_t cpu);
+}  // namespace amd64::smp
@@ -0,0 +1,114 @@
+; SPDX-License-Identifier: GPL-3.0-only
+;
+; -- BEGIN METADATA HEADER --
+; The Wind/Tempest Project
+;
+; File       : sys/arch/amd64/smp/trampoline.asm
+; Author     : Tempik25 <tempik25@tempestfoundation.org>
+; Maintainer : Tempest Foundation <development@tempestfoundation.org>
+; Repo       : https://wtsrc.tempestfoundation.org
+;
+; Copyright (C) 2025 Tempest Foundation
+; -- END OF METADATA HEADER --
+;
+; Where an application processor starts after its start-up IPI.
+;
+; smp::init() copies ap_trampoline..ap_trampoline_end to TRAMPOLINE_BASE
+; and fills in the parameter block before starting each CPU.  The CPU
+; wakes in real mode at TRAMPOLINE_BASE, turns on PAE, long mode and
+; paging in one go (with the boot CPU's page tables and CR0, so the
+; trampoline and the kernel are identity-mapped and WP/NE match), and
+; calls the C++ entry on its own stack with its CPU number in edi.
+; Everything is addressed through the copy, so nothing here may refer to
+; its link-time address.
+;
+; ap_park replaces the start of the copy when a CPU never checked in, so
+; one that wakes up late halts instead of running with another CPU's
+; stack.
+global ap_trampoline, ap_trampoline_end, ap_params
+global ap_park, ap_park_end
+
+TRAMPOLINE_BASE equ 0x8000      ; amd64::smp::TRAMPOLINE_BASE
+
+; Address of a label in the copy
+%define COPY(label) (TRAMPOLINE_BASE + (label) - ap_trampoline)
+
+CR4_VALUE   equ 0x620           ; PAE, OSFXSR, OSXMMEXCPT, as in boot.asm
+MSR_EFER    equ 0xC0000080
+EFER_LME    equ 1 << 8
+
+section .rodata
+align 16
+bits 16
+ap_trampoline:
+    cli
+    cld
+    xor ax, ax
+    mov ds, ax
+
+    lgdt [COPY(tramp_gdtr)]
+
+    mov eax, CR4_VALUE
+    mov cr4, eax
+    mov eax, [COPY(param_cr3)]
+    mov cr3, eax
+
+    mov ecx, MSR_EFER
+    rdmsr
+    or eax, EFER_LME
+    wrmsr
+
+    ; Protected mode and paging together land directly in long mode; the
+    ; boot CPU's CR0 also clears the CD/NW that INIT set
+    mov eax, [COPY(param_cr0)]
+    mov cr0, eax
+    jmp dword 0x08:COPY(ap_long_mode)
+
+bits 64
+ap_long_mode:
+    mov ax, 0x10
+    mov ds, ax
+    mov es, ax
+    mov ss, ax
+    xor eax, eax
+    mov fs, ax
+    mov gs, ax
+
+    mov rsp, [COPY(param_stack)]
+    mov edi, [COPY(param_cpu)]
+    mov rax, [COPY(param_entry)]
+    call rax        ; Does not return
+
+.hang:
+    cli
+    hlt
+    jmp .hang
+
+; Flat 64-bit code and data, until the CPU loads its own GDT
+align 8
+tramp_gdt:
+    dq 0
+    dq 0x00AF9A000000FFFF       ; 0x08: gdt::KERNEL_CODE_DESC
+    dq 0x00CF92000000FFFF       ; 0x10: gdt::KERNEL_DATA_DESC
+tramp_gdtr:
+    dw tramp_gdtr - tramp_gdt - 1
+    dd COPY(tramp_gdt)
+
+; smp::trampoline_params, written by smp::init()
+align 8
+ap_params:
+param_cr3:   dq 0               ; Below 4 GiB: loaded from 16-bit code
+param_cr0:   dq 0               ; Boot CPU's, without TS; low half loaded
+param_stack: dq 0
+param_entry: dq 0
+param_cpu:   dq 0
+ap_trampoline_end:
+
+; Position independent, copied over the entry point
+bits 16
+ap_park:
+    cli
+.halt:
+    hlt
+    jmp .halt
+ap_park_end:
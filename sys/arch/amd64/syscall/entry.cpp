@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "entry.h"
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/gdt/gdt.h>
+#include <dbg/logger.h>
+
+#define MSR_EFER   0xC0000080
+#define MSR_STAR   0xC0000081
+#define MSR_LSTAR  0xC0000082
+#define MSR_SFMASK 0xC0000084
+
+#define EFER_SCE (1ULL << 0)
+
+// RFLAGS bits cleared on entry: TF, IF, DF and AC
+#define SYSCALL_RFLAGS_MASK 0x40700ULL
+
+extern "C" void
+    syscall_entry(void);
+
+namespace amd64::syscall {
+	/**
+	 * @brief Enable the syscall instruction on the calling CPU
+	 *
+	 * Needs the GDT from gdt::init(), which STAR refers to.
+	 */
+	void init_cpu(void) {
+		uint64_t star = ((uint64_t) gdt::SYSRET_BASE << 48)
+		              | ((uint64_t) gdt::KERNEL_CS << 32);
+		wrmsr(MSR_STAR, star);
+		wrmsr(MSR_LSTAR, (uint64_t) syscall_entry);
+		wrmsr(MSR_SFMASK, SYSCALL_RFLAGS_MASK);
+		wrmsr(MSR_EFER, rdmsr(MSR_EFER) | EFER_SCE);
+	}
+
+	void init(void) {
+		init_cpu();
+		logger::debug::puts("syscall", "info", "SYSCALL/SYSRET entry enabled");
+	}
+
+	/**
+	 * @brief Stack syscall_entry switches to on the calling CPU
+	 */
+	void set_kernel_stack(uint64_t rsp) {
+		percpu::get()->kernel_rsp = rsp;
+	}
+}  // namespace amd64::syscall
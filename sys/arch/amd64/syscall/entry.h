@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * SYSCALL/SYSRET entry.
+ *
+ * The fast path saves only what the syscall ABI asks to keep (the argument
+ * registers, plus the return RIP and RFLAGS the CPU leaves in rcx and r11)
+ * and returns with sysret.  int 0x80 stays available with the full
+ * register frame.
+ */
+namespace amd64::syscall {
+	void init(void);
+	void init_cpu(void);
+	void set_kernel_stack(uint64_t rsp);
+}  // namespace amd64::syscall
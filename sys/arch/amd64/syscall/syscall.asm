@@ -13,11 +13,18 @@
 ;
 global syscall_int_handler
 
+%include "arch/amd64/isr/swapgs.inc"
+
+; amd64::percpu::cpu
+PERCPU_KERNEL_RSP equ 8
+PERCPU_USER_RSP   equ 16
+
 ; Syscall interrupt handler for int 0x80
 syscall_int_handler:
     cli
     push 0x0        ; Push dummy error code (syscalls don't have error codes)
     push 0x80       ; Push interrupt number (0x80 for syscalls)
+    SWAPGS_IF_USER 24
 
     ; Save all registers (push order must be the reverse of registers_t
     ; field order so that the layout matches the structure exactly).
@@ -69,7 +76,57 @@ syscall_int_handler:
 
     ; Remove error code and interrupt number from stack
     add rsp, 16
+    SWAPGS_IF_USER 8
 
     ; Return from interrupt
     sti             ; Re-enable interrupts
     iretq
+
+; SYSCALL entry (LSTAR)
+;
+; The CPU leaves the user RIP in rcx and RFLAGS in r11, with IF already
+; cleared by SFMASK, and does not switch stacks.  Only the registers the
+; syscall ABI preserves across the call are saved: the C handler keeps
+; rbx, rbp and r12-r15 itself.  The frame below the return state is a
+; syscall_args_t:
+;   rax(nr) rdi rsi rdx r10 r8 r9
+;
+; SYSCALL only ever comes from ring 3, so GS always needs swapping to
+; reach the per-CPU kernel stack.
+global syscall_entry
+extern syscall_fast_handler
+syscall_entry:
+    swapgs
+    mov [gs:PERCPU_USER_RSP], rsp
+    mov rsp, [gs:PERCPU_KERNEL_RSP]
+
+    push qword [gs:PERCPU_USER_RSP]
+    push rcx        ; User RIP
+    push r11        ; User RFLAGS
+    push r9
+    push r8
+    push r10        ; Fourth argument (rcx is taken by the return RIP)
+    push rdx
+    push rsi
+    push rdi
+    push rax
+
+    ; Ten pushes keep rsp 16-byte aligned for the call
+    mov rdi, rsp
+    sti
+    call syscall_fast_handler
+    cli
+
+    ; Result stays in rax
+    add rsp, 8      ; Skip the syscall number
+    pop rdi
+    pop rsi
+    pop rdx
+    pop r10
+    pop r8
+    pop r9
+    pop r11
+    pop rcx
+    swapgs
+    pop rsp
+    o64 sysret
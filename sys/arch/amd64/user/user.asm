@@ -0,0 +1,344 @@
+; SPDX-License-Identifier: GPL-3.0-only
+;
+; -- BEGIN METADATA HEADER --
+; The Wind/Tempest Project
+;
+; File       : sys/arch/amd64/user/user.asm
+; Author     : Tempik25 <tempik25@tempestfoundation.org>
+; Maintainer : Tempest Foundation <development@tempestfoundation.org>
+; Repo       : https://wtsrc.tempestfoundation.org
+;
+; Copyright (C) 2025 Tempest Foundation
+; -- END OF METADATA HEADER --
+;
+global user_enter, user_leave
+global user_syscall_bench, user_syscall_bench_end
+global user_ring_bench, user_ring_bench_end
+global user_vdso_bench, user_vdso_bench_end
+
+USER_CS     equ 0x23    ; amd64::gdt::USER_CS
+USER_DS     equ 0x1B    ; amd64::gdt::USER_DS
+USER_RFLAGS equ 0x202   ; IF, plus the always-set bit 1
+
+SYS_EXIT    equ 0
+SYS_GETPID  equ 5
+SYS_TIME    equ 16
+SYS_RING_ENTER equ 32
+
+; vDSO entry points, from the start of the window
+VDSO_CLOCK_NS equ 0x2000 + 2048 ; user::VDSO_OFFSET + vdso::ENTRY_CLOCK_NS
+VDSO_GETPID   equ 0x2000 + 2064 ; user::VDSO_OFFSET + vdso::ENTRY_GETPID
+
+; syscall::ring layout, as set up by test_ring
+RING_OFF     equ 64     ; Ring header, from the start of the data page
+RING_SQ_TAIL equ 4
+RING_CQ_HEAD equ 8
+RING_CQ_TAIL equ 12
+RING_BATCH   equ 32     ; Submission entries; completions are twice that
+RING_SQES    equ 64     ; sizeof(header)
+RING_CQES    equ RING_SQES + RING_BATCH * 64
+
+section .bss
+alignb 8
+kernel_rsp: resq 1      ; Kernel stack of the user_enter() caller; one run() at a time
+
+section .text
+
+; uint64_t user_enter(entry, user_rsp, arg0, arg1)
+;
+; Saves the callee-saved registers and RFLAGS on the kernel stack, then
+; iretq to ring 3 at entry with arg0/arg1 in rdi/rsi.  Returns when
+; user_leave() unwinds back to the saved stack.
+user_enter:
+    push rbx
+    push rbp
+    push r12
+    push r13
+    push r14
+    push r15
+    pushfq
+    mov [rel kernel_rsp], rsp
+
+    cli
+    push USER_DS
+    push rsi        ; User stack
+    push USER_RFLAGS
+    push USER_CS
+    push rdi        ; Entry point
+
+    mov rdi, rdx
+    mov rsi, rcx
+
+    ; Hand over no kernel values
+    xor eax, eax
+    xor ebx, ebx
+    xor ecx, ecx
+    xor edx, edx
+    xor ebp, ebp
+    xor r8d, r8d
+    xor r9d, r9d
+    xor r10d, r10d
+    xor r11d, r11d
+    xor r12d, r12d
+    xor r13d, r13d
+    xor r14d, r14d
+    xor r15d, r15d
+    swapgs          ; Ring 3 runs on the user GS base
+    iretq
+
+; void user_leave(status)
+;
+; Drops whatever kernel stack it runs on and returns status from the
+; pending user_enter().
+user_leave:
+    mov rsp, [rel kernel_rsp]
+    mov rax, rdi
+    popfq
+    pop r15
+    pop r14
+    pop r13
+    pop r12
+    pop rbp
+    pop rbx
+    ret
+
+; Ring 3 routine for test_syscall, copied into the user window
+;
+; rdi: iterations, rsi: where to store two cycle counts, for SYS_GETPID
+; through syscall/sysret and through int 0x80/iretq.  Position-independent.
+user_syscall_bench:
+    mov r12, rdi
+    mov r13, rsi
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.fast:
+    mov eax, SYS_GETPID
+    syscall
+    dec rbx
+    jnz .fast
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13], rax
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.legacy:
+    mov eax, SYS_GETPID
+    int 0x80
+    dec rbx
+    jnz .legacy
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13 + 8], rax
+
+    mov eax, SYS_EXIT
+    xor edi, edi
+    syscall
+.hang:
+    jmp .hang
+user_syscall_bench_end:
+
+; Ring 3 routine for test_ring, copied into the user window
+;
+; rdi: iterations, a multiple of RING_BATCH; rsi: the data page, whose
+; first word picks how SYS_GETPID is issued:
+;   0: one syscall per call
+;   1: RING_BATCH ring entries, then one SYS_RING_ENTER
+;   2: RING_BATCH ring entries, left for the kernel poller
+; Stores the cycle count at [rsi + 8] and the sum of all results at
+; [rsi + 16].  Position-independent.
+user_ring_bench:
+    mov r12, rdi
+    mov r13, rsi
+    lea r15, [rsi + RING_OFF]
+    xor ebp, ebp
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+    cmp qword [r13], 0
+    jne .batch
+.single:
+    mov eax, SYS_GETPID
+    syscall
+    add rbp, rax
+    dec rbx
+    jnz .single
+    jmp .done
+
+.batch:
+    mov edx, [r15 + RING_SQ_TAIL]
+    mov ecx, RING_BATCH
+.fill:
+    mov eax, edx
+    and eax, RING_BATCH - 1
+    shl eax, 6
+    mov qword [r15 + RING_SQES + rax], SYS_GETPID
+    mov [r15 + RING_SQES + rax + 56], rdx   ; user_data
+    inc edx
+    dec ecx
+    jnz .fill
+    mov [r15 + RING_SQ_TAIL], edx           ; Publish; x86 stores are ordered
+
+    cmp qword [r13], 1
+    jne .wait
+    mov eax, SYS_RING_ENTER
+    mov edi, RING_BATCH
+    syscall
+.wait:
+    mov ecx, [r15 + RING_CQ_TAIL]
+    sub ecx, [r15 + RING_CQ_HEAD]
+    cmp ecx, RING_BATCH
+    jae .reap
+    pause
+    jmp .wait
+.reap:
+    mov edx, [r15 + RING_CQ_HEAD]
+    mov ecx, RING_BATCH
+.next:
+    mov eax, edx
+    and eax, 2 * RING_BATCH - 1
+    shl eax, 4
+    add rbp, [r15 + RING_CQES + rax + 8]    ; result
+    inc edx
+    dec ecx
+    jnz .next
+    mov [r15 + RING_CQ_HEAD], edx
+    sub rbx, RING_BATCH
+    jnz .batch
+
+.done:
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13 + 8], rax
+    mov [r13 + 16], rbp
+
+    mov eax, SYS_EXIT
+    xor edi, edi
+    syscall
+.hang:
+    jmp .hang
+user_ring_bench_end:
+
+; Ring 3 routine for test_vdso, copied into the user window
+;
+; rdi: iterations, rsi: where to store the results: cycle counts for the
+; vDSO clock, SYS_TIME, the vDSO getpid and SYS_GETPID, then three
+; CLOCK_MONOTONIC readings taken vDSO, syscall, vDSO.  Position-independent.
+user_vdso_bench:
+    mov r12, rdi
+    mov r13, rsi
+    lea r15, [rel user_vdso_bench]          ; Start of the window
+
+    lea rbp, [r15 + VDSO_CLOCK_NS]
+    xor edi, edi
+    call rbp
+    mov [r13 + 32], rax
+    mov eax, SYS_TIME
+    xor edi, edi
+    syscall
+    mov [r13 + 40], rax
+    xor edi, edi
+    call rbp
+    mov [r13 + 48], rax
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.vclock:
+    xor edi, edi
+    call rbp
+    dec rbx
+    jnz .vclock
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13], rax
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.sclock:
+    mov eax, SYS_TIME
+    xor edi, edi
+    syscall
+    dec rbx
+    jnz .sclock
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13 + 8], rax
+
+    lea rbp, [r15 + VDSO_GETPID]
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.vpid:
+    call rbp
+    dec rbx
+    jnz .vpid
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13 + 16], rax
+
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    mov r14, rax
+    mov rbx, r12
+.spid:
+    mov eax, SYS_GETPID
+    syscall
+    dec rbx
+    jnz .spid
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r14
+    mov [r13 + 24], rax
+
+    mov eax, SYS_EXIT
+    xor edi, edi
+    syscall
+.hang:
+    jmp .hang
+user_vdso_bench_end:
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "user.h"
+
+#include <kmemcpy.h>
+
+#include <arch/amd64/gdt/gdt.h>
+#include <arch/amd64/syscall/entry.h>
+#include <dbg/logger.h>
+
+#define PTE_PRESENT  (1ULL << 0)
+#define PTE_WRITABLE (1ULL << 1)
+#define PTE_USER     (1ULL << 2)
+#define PTE_HUGE     (1ULL << 7)
+#define PTE_ADDR     0x000FFFFFFFFFF000ULL
+
+#define HUGE_PAGE_SIZE 0x200000ULL
+
+#define WINDOW_SIZE  (CODE_SIZE + DATA_SIZE + VDSO_SIZE + STACK_SIZE)
+#define WINDOW_ALIGN 0x8000ULL
+
+extern "C" {
+uint64_t
+    user_enter(uint64_t entry, uint64_t user_rsp, uint64_t arg0, uint64_t arg1);
+[[noreturn]] void
+    user_leave(uint64_t status);
+}
+
+namespace amd64::user {
+	// Code, data, vDSO, then stack.  Aligned past its size so it cannot
+	// straddle a 2 MiB page.
+	static_assert(WINDOW_SIZE <= WINDOW_ALIGN, "window outgrew its alignment");
+	alignas(WINDOW_ALIGN) static uint8_t window[WINDOW_SIZE];
+
+	// The 2 MiB page holding the window, split into 4 KiB pages
+	alignas(PAGE_SIZE) static uint64_t window_pt[512];
+
+	// Kernel stack for syscalls and interrupts taken in ring 3
+	alignas(16) static uint8_t kernel_stack[16384];
+
+	static bool ready = false;
+
+	// Claimed by run() for its whole duration; see user.h
+	static bool active = false;
+
+	static inline uint64_t *table_at(uint64_t entry) {
+		return (uint64_t *) (uintptr_t) (entry & PTE_ADDR);
+	}
+
+	/**
+	 * @brief Make the window, and nothing else, reachable from ring 3
+	 *
+	 * The boot page tables map the first 4 GiB with supervisor-only 2 MiB
+	 * pages.  The page holding the window is remapped with 4 KiB pages so
+	 * the user bit can be set on the window alone; the upper levels get the
+	 * user bit too, since it has to be set at every level.
+	 *
+	 * @return False if the window is not mapped as expected
+	 */
+	bool init(void) {
+		uint64_t cr3;
+		__asm__ volatile("mov %%cr3, %0" : "=r"(cr3));
+
+		uint64_t  va   = (uint64_t) window;
+		uint64_t *pml4 = table_at(cr3);
+		uint64_t *pml4e = &pml4[(va >> 39) & 0x1FF];
+		if( !(*pml4e & PTE_PRESENT) )
+			return false;
+
+		uint64_t *pdpte = &table_at(*pml4e)[(va >> 30) & 0x1FF];
+		if( !(*pdpte & PTE_PRESENT) || (*pdpte & PTE_HUGE) )
+			return false;
+
+		uint64_t *pde = &table_at(*pdpte)[(va >> 21) & 0x1FF];
+		if( !(*pde & PTE_PRESENT) || !(*pde & PTE_HUGE) )
+			return false;
+
+		uint64_t base = *pde & ~(HUGE_PAGE_SIZE - 1) & PTE_ADDR;
+		for( uint64_t i = 0; i < 512; i++ ) {
+			uint64_t pa  = base + i * PAGE_SIZE;
+			window_pt[i] = pa | PTE_PRESENT | PTE_WRITABLE;
+			if( pa >= va && pa < va + WINDOW_SIZE )
+				window_pt[i] |= PTE_USER;
+		}
+
+		*pde = (uint64_t) window_pt | PTE_PRESENT | PTE_WRITABLE | PTE_USER;
+		*pdpte |= PTE_USER;
+		*pml4e |= PTE_USER;
+		__asm__ volatile("mov %0, %%cr3" : : "r"(cr3) : "memory");
+
+		ready = true;
+		logger::debug::printf("user",
+		                      "info",
+		                      "User window at 0x%llx, %llu bytes\n",
+		                      va,
+		                      (uint64_t) WINDOW_SIZE);
+		return true;
+	}
+
+	/**
+	 * @brief Copy position-independent code to the start of the window
+	 */
+	bool load(const void *code, size_t len) {
+		if( !ready || len > CODE_SIZE )
+			return false;
+		kstring::memcpy(window, code, len);
+		return true;
+	}
+
+	/**
+	 * @brief The data page, readable and writable from both rings
+	 */
+	void *data(void) {
+		return window + CODE_SIZE;
+	}
+
+	/**
+	 * @brief Show @p page, read-only, in the vDSO slot of the window
+	 *
+	 * The kernel keeps writing the page through its own mapping; ring 3
+	 * only sees this alias.  The window's backing memory for the slot is
+	 * left unused.
+	 */
+	bool map_vdso(const void *page) {
+		uint64_t pa = (uint64_t) page;
+		if( !ready || (pa & (PAGE_SIZE - 1)) != 0 )
+			return false;
+
+		uint8_t *va = window + VDSO_OFFSET;
+		uint64_t i  = ((uint64_t) va >> 12) & 0x1FF;
+		window_pt[i] = pa | PTE_PRESENT | PTE_USER;
+		__asm__ volatile("invlpg (%0)" : : "r"(va) : "memory");
+		return true;
+	}
+
+	/**
+	 * @brief Run the loaded code in ring 3 until it calls SYS_EXIT
+	 *
+	 * The code starts with @p arg0 and @p arg1 in rdi and rsi and the
+	 * stack pointer at the top of the window.
+	 *
+	 * @return The status passed to SYS_EXIT, or ~0 if not initialized or
+	 *         another run() is in progress
+	 */
+	uint64_t run(uint64_t arg0, uint64_t arg1) {
+		if( !ready || __atomic_exchange_n(&active, true, __ATOMIC_ACQUIRE) )
+			return ~0ULL;
+
+		uint64_t stack_top = (uint64_t) (kernel_stack + sizeof(kernel_stack));
+		gdt::set_kernel_stack(stack_top);
+		syscall::set_kernel_stack(stack_top);
+
+		uint64_t status = user_enter((uint64_t) window,
+		                             (uint64_t) (window + WINDOW_SIZE),
+		                             arg0,
+		                             arg1);
+		__atomic_store_n(&active, false, __ATOMIC_RELEASE);
+		return status;
+	}
+
+	/**
+	 * @brief True when called on behalf of the ring 3 code of run()
+	 *
+	 * That is, while run() is in progress and the caller is on the kernel
+	 * stack of its syscalls and interrupts.  A SYS_EXIT from anywhere else
+	 * (another CPU, another thread) must not unwind that run().
+	 */
+	bool is_active(void) {
+		const uint8_t *sp = (const uint8_t *) __builtin_frame_address(0);
+		return __atomic_load_n(&active, __ATOMIC_ACQUIRE) && sp >= kernel_stack
+		       && sp < kernel_stack + sizeof(kernel_stack);
+	}
+
+	/**
+	 * @brief End the current run() with @p status
+	 *
+	 * Called from SYS_EXIT on the kernel stack of the ring 3 code, which is
+	 * simply dropped.
+	 */
+	void exit(uint64_t status) {
+		user_leave(status);
+	}
+}  // namespace amd64::user
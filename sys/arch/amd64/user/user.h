@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * Running code in ring 3.
+ *
+ * There are no processes yet.  A fixed window inside the kernel image is
+ * the only user-accessible memory: a code page, a data page, a read-only
+ * vDSO page and a stack.  run() drops to ring 3 at the start of the code
+ * page and returns once that code calls SYS_EXIT, with the exit status.
+ *
+ * The window, the kernel stack that syscalls and interrupts from ring 3
+ * run on, and the saved stack pointer SYS_EXIT unwinds to exist once for
+ * the whole system, so only one run() can be in progress at a time.  A
+ * second run(), from any CPU or thread, fails straight away.  run() points
+ * RSP0 and the SYSCALL stack of the calling CPU at that kernel stack;
+ * threads never migrate, so they stay right until run() returns.
+ */
+namespace amd64::user {
+	constexpr size_t PAGE_SIZE  = 4096;
+	constexpr size_t CODE_SIZE  = PAGE_SIZE;
+	constexpr size_t DATA_SIZE  = PAGE_SIZE;
+	constexpr size_t VDSO_SIZE  = PAGE_SIZE;
+	constexpr size_t STACK_SIZE = 2 * PAGE_SIZE;
+
+	// Offset of the vDSO page from the start of the window
+	constexpr size_t VDSO_OFFSET = CODE_SIZE + DATA_SIZE;
+
+	bool     init(void);
+	bool     load(const void *code, size_t len);
+	void    *data(void);
+	bool     map_vdso(const void *page);
+	uint64_t run(uint64_t arg0, uint64_t arg1);
+	bool     is_active(void);
+
+	[[noreturn]] void exit(uint64_t status);
+}  // namespace amd64::user
@@ -0,0 +1,91 @@
+; SPDX-License-Identifier: GPL-3.0-only
+;
+; -- BEGIN METADATA HEADER --
+; The Wind/Tempest Project
+;
+; File       : sys/arch/amd64/user/vdso.asm
+; Author     : Tempik25 <tempik25@tempestfoundation.org>
+; Maintainer : Tempest Foundation <development@tempestfoundation.org>
+; Repo       : https://wtsrc.tempestfoundation.org
+;
+; Copyright (C) 2025 Tempest Foundation
+; -- END OF METADATA HEADER --
+;
+; Code half of the vDSO page.  vdso::init() copies it to TEXT_OFFSET, so
+; it must stay position-independent and find its data relative to rip.
+; Called from ring 3 with the SysV ABI; clobbers only caller-saved
+; registers.
+global vdso_text, vdso_text_end
+
+TEXT_OFFSET     equ 2048    ; vdso::TEXT_OFFSET
+
+; vdso::data
+VD_SEQ          equ 0
+VD_CLOCK_MODE   equ 4
+VD_BASE_COUNT   equ 8
+VD_BASE_NS      equ 16
+VD_MULT         equ 24
+VD_BOOT_EPOCH   equ 32
+VD_PID          equ 40
+
+CLOCK_MODE_TSC  equ 0
+CLOCK_REALTIME  equ 1
+SYS_TIME        equ 16
+
+section .text
+
+; Entry points at fixed offsets (vdso::ENTRY_*)
+vdso_text:
+    jmp clock_ns
+align 16
+    jmp getpid
+
+; uint64_t clock_ns(clock)
+;
+; CLOCK_MONOTONIC or CLOCK_REALTIME in nanoseconds, like SYS_TIME.
+align 16
+clock_ns:
+    lea r8, [rel vdso_text - TEXT_OFFSET]
+.retry:
+    mov ecx, [r8 + VD_SEQ]
+    test ecx, 1
+    jnz .busy
+    cmp dword [r8 + VD_CLOCK_MODE], CLOCK_MODE_TSC
+    jne .trap
+
+    ; x86 keeps loads in order, so these cannot pass the seq read
+    mov r9, [r8 + VD_BASE_COUNT]
+    mov r10, [r8 + VD_MULT]
+    mov r11, [r8 + VD_BASE_NS]
+    xor esi, esi
+    cmp edi, CLOCK_REALTIME
+    jne .read
+    mov rsi, [r8 + VD_BOOT_EPOCH]
+.read:
+    lfence
+    rdtsc
+    shl rdx, 32
+    or rax, rdx
+    sub rax, r9
+    mul r10
+    shrd rax, rdx, 32
+    add rax, r11
+    add rax, rsi
+
+    cmp ecx, [r8 + VD_SEQ]
+    jne .retry
+    ret
+.busy:
+    pause
+    jmp .retry
+.trap:
+    mov eax, SYS_TIME
+    syscall
+    ret
+
+; uint64_t getpid(void)
+align 16
+getpid:
+    mov rax, [rel vdso_text - TEXT_OFFSET + VD_PID]
+    ret
+vdso_text_end:
@@ -9,9 +9,9 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#include <kformat.h>
 #include <kstdio.h>
 #include <ktime.h>
-#include <kutoa.h>
 
 #include <dbg/logger.h>
 #include <drv/serial/serial.h>
@@ -61,19 +61,24 @@ namespace logger {
 			serial::write('\n');
 		}
 
-		/*
-	 * This code is so bad...
-	 */
-		int printf(const char *subsystem,
-		           const char *type,
-		           const char *format,
-		           ...) {
-			if( !d_enabled )
-				return 0;
-			va_list args;
-			k_va_start(args, format);
-			int count = 0;
+		static void serial_sink_write(kstd::fmt::sink *self,
+		                              const char       *s,
+		                              size_t            len) {
+			for( size_t i = 0; i < len; ++i )
+				serial::write(s[i]);
+			self->count += (int) len;
+		}
 
+		/**
+		 * @brief Backend of logger::debug::printf(), runs an already compiled format
+		 * @return Number of characters written after the header
+		 */
+		int print(const char             *subsystem,
+		          const char             *type,
+		          const char             *str,
+		          const kstd::fmt::instr *ops,
+		          size_t                  count,
+		          const kstd::fmt::value *values) {
 			serial::write('[');
 			// uptime
 			char timebuf[32];
@@ -97,256 +102,9 @@ namespace logger {
 			}
 			serial::writes("] ");
 
-			for( const char *p = format; *p; ++p ) {
-				if( *p != '%' ) {
-					serial::write(*p);
-					count++;
-					continue;
-				}
-				p++;
-
-				int left_align = 0;
-				int width      = 0;
-				if( *p == '-' ) {
-					left_align = 1;
-					p++;
-				}
-				while( *p >= '0' && *p <= '9' ) {
-					width = width * 10 + (*p - '0');
-					p++;
-				}
-
-				// Check for precision (for floats)
-				int precision = 6;
-				if( *p == '.' ) {
-					p++;
-					precision = 0;
-					while( *p >= '0' && *p <= '9' ) {
-						precision = precision * 10 + (*p - '0');
-						p++;
-					}
-				}
-
-				int long_long = 0;
-				if( *p == 'l' && *(p + 1) == 'l' ) {
-					long_long = 1;
-					p += 2;
-				}
-
-				switch( *p ) {
-					case 's': {
-						const char *s =
-						    k_va_arg(args, const char *);
-						if( !s )
-							s = "(null)";
-						int         len = 0;
-						const char *t   = s;
-						while( *t++ )
-							len++;
-						int pad = (width > len) ? (width - len)
-						                        : 0;
-						if( !left_align )
-							for( int i = 0; i < pad; ++i ) {
-								serial::write(' ');
-								count++;
-							}
-						for( int i = 0; i < len; ++i ) {
-							serial::write(s[i]);
-							count++;
-						}
-						if( left_align )
-							for( int i = 0; i < pad; ++i ) {
-								serial::write(' ');
-								count++;
-							}
-						break;
-					}
-
-					case 'f': {
-						double val = k_va_arg(args, double);
-						char   buf[64];
-						kstd::format_double(
-						    buf, sizeof(buf), val, precision);
-						const char *s = buf;
-						while( *s ) {
-							serial::write(*s++);
-							count++;
-						}
-						break;
-					}
-
-					case 'd': {
-						if( long_long ) {
-							int64_t n =
-							    k_va_arg(args, int64_t);
-							if( n < 0 ) {
-								serial::write('-');
-								count++;
-								n = -n;
-							}
-							char buf[21];
-							int  idx = 20;
-							buf[idx] = '\0';
-							if( n == 0 )
-								buf[--idx] = '0';
-							else {
-								uint64_t un =
-								    (uint64_t) n;
-								while( un ) {
-									buf[--idx] =
-									    (char) ('0'
-									            + (un
-									               % 10));
-									un /= 10;
-								}
-							}
-							int len = 20 - idx;
-							int pad = (width > len)
-							              ? width - len
-							              : 0;
-							if( !left_align )
-								for( int i = 0; i < pad;
-								     ++i ) {
-									serial::write(
-									    ' ');
-									count++;
-								}
-							for( int i = idx; i < 20; ++i ) {
-								serial::write(buf[i]);
-								count++;
-							}
-							if( left_align )
-								for( int i = 0; i < pad;
-								     ++i ) {
-									serial::write(
-									    ' ');
-									count++;
-								}
-						} else {
-							int n = k_va_arg(args, int);
-							if( n < 0 ) {
-								serial::write('-');
-								count++;
-								n = -n;
-							}
-							// measure digits to update count
-							int temp = n, digits = 1;
-							while( temp >= 10 ) {
-								temp /= 10;
-								digits++;
-								serial::write((char) n);
-							}
-							count += digits;
-						}
-						break;
-					}
-
-					case 'x': {
-						if( long_long ) {
-							uint64_t n =
-							    k_va_arg(args, uint64_t);
-							serial::write((char) n);
-							uint64_t temp   = n;
-							int      digits = 1;
-							while( temp >= 16 ) {
-								temp /= 16;
-								digits++;
-							}
-							count += digits;
-						} else {
-							unsigned int n =
-							    k_va_arg(args, unsigned int);
-							serial::write((char) n);
-							unsigned int temp   = n;
-							int          digits = 1;
-							while( temp >= 16 ) {
-								temp /= 16;
-								digits++;
-							}
-							count += digits;
-						}
-						break;
-					}
-
-					case 'c': {
-						char c = (char) k_va_arg(args, int);
-						serial::write(c);
-						count++;
-						break;
-					}
-
-					case '%': {
-						serial::write('%');
-						count++;
-						break;
-					}
-
-					case 'u': {
-						if( long_long ) {
-							uint64_t n =
-							    k_va_arg(args, uint64_t);
-							char buf[21];
-							int  idx = 20;
-							buf[idx] = '\0';
-							if( n == 0 )
-								buf[--idx] = '0';
-							else {
-								while( n ) {
-									buf[--idx] =
-									    (char) ('0'
-									            + (n
-									               % 10));
-									n /= 10;
-								}
-							}
-							int len = 20 - idx;
-							int pad = (width > len)
-							              ? width - len
-							              : 0;
-							if( !left_align )
-								for( int i = 0; i < pad;
-								     ++i ) {
-									serial::write(
-									    ' ');
-									count++;
-								}
-							for( int i = idx; i < 20; ++i ) {
-								serial::write(buf[i]);
-								count++;
-							}
-							if( left_align )
-								for( int i = 0; i < pad;
-								     ++i ) {
-									serial::write(
-									    ' ');
-									count++;
-								}
-						} else {
-							unsigned int n =
-							    k_va_arg(args, unsigned int);
-							serial::write((char) n);
-							unsigned int temp   = n;
-							int          digits = 1;
-							while( temp >= 10 ) {
-								temp /= 10;
-								digits++;
-							}
-							count += digits;
-						}
-						break;
-					}
-
-					default: {
-						serial::write('%');
-						serial::write(*p);
-						count += 2;
-						break;
-					}
-				}
-			}
-
-			k_va_end(args);
-			return count;
+			kstd::fmt::sink out = {serial_sink_write, 0};
+			kstd::fmt::run(str, ops, count, values, &out);
+			return out.count;
 		}
 	}  // namespace debug
 
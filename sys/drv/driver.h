@@ -12,6 +12,7 @@
 #pragma once
 
 #include <drv/ata/ata.h>
+#include <drv/hpet/hpet.h>
 #include <drv/keyboard/keyboard.h>
 #include <drv/serial/serial.h>
 #include <drv/video/video.h>
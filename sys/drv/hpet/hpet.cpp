@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "hpet.h"
+
+#include <kmuldiv.h>
+#include <ktime.h>
+
+#include <dbg/logger.h>
+#include <kern/acpi/acpi.h>
+
+// Register offsets from the HPET base
+#define HPET_CAP_ID       0x000
+#define HPET_GEN_CONF     0x010
+#define HPET_MAIN_COUNTER 0x0F0
+#define HPET_TIMER_CONF   0x100  // Timer 0; timer n is 0x20 * n further
+#define HPET_TIMER_CMP    0x108
+
+#define HPET_CAP_COUNT_64       (1ULL << 13)
+#define HPET_CAP_LEGACY_ROUTE   (1ULL << 15)
+#define HPET_GEN_CONF_ENABLE    (1ULL << 0)
+#define HPET_GEN_CONF_LEGACY_RT (1ULL << 1)
+
+#define HPET_TN_INT_ENABLE (1ULL << 2)
+#define HPET_TN_PERIODIC   (1ULL << 3)
+#define HPET_TN_SIZE_64    (1ULL << 5)
+#define HPET_TN_32BIT_MODE (1ULL << 8)
+
+#define HPET_MAX_PERIOD_FS 100000000ULL  // 100 ns, the limit set by the spec
+#define FS_PER_NS          1000000ULL
+
+namespace hpet {
+	static volatile uint64_t *regs      = nullptr;
+	static uint64_t           period_fs = 0;
+	static bool               wide      = false;  // 64-bit main counter
+	static bool               cmp_wide  = false;  // 64-bit comparator 0
+	static uint64_t           min_delta = 0;      // Smallest safe comparator lead
+
+	static inline uint64_t read(uint32_t reg) {
+		return regs[reg / 8];
+	}
+
+	static inline void write(uint32_t reg, uint64_t val) {
+		regs[reg / 8] = val;
+	}
+
+	/**
+	 * @brief Find the HPET in the ACPI tables and start its main counter
+	 * @return False if there is no usable HPET
+	 */
+	bool init(void) {
+		const acpi::hpet_table *table =
+		    (const acpi::hpet_table *) acpi::find_table("HPET");
+		if( !table || table->base.address_space != 0 || !table->base.address )
+			return false;
+
+		regs          = (volatile uint64_t *) (uintptr_t) table->base.address;
+		uint64_t cap  = read(HPET_CAP_ID);
+		period_fs     = cap >> 32;
+		wide          = cap & HPET_CAP_COUNT_64;
+
+		if( period_fs == 0 || period_fs > HPET_MAX_PERIOD_FS ) {
+			regs = nullptr;
+			return false;
+		}
+
+		// Enough ticks to cover the comparator write and the check after it
+		min_delta = table->min_tick ? table->min_tick : 1;
+
+		uint64_t conf = read(HPET_GEN_CONF);
+		if( !(conf & HPET_GEN_CONF_ENABLE) )
+			write(HPET_GEN_CONF, conf | HPET_GEN_CONF_ENABLE);
+
+		logger::debug::printf("hpet",
+		                      "info",
+		                      "HPET at 0x%llx, %llu fs/tick, %s counter\n",
+		                      table->base.address,
+		                      period_fs,
+		                      wide ? "64-bit" : "32-bit");
+		return true;
+	}
+
+	bool is_available(void) {
+		return regs != nullptr;
+	}
+
+	bool is_64bit(void) {
+		return wide;
+	}
+
+	/**
+	 * @brief Counter period in femtoseconds, or 0 without an HPET
+	 */
+	uint64_t get_period_fs(void) {
+		return period_fs;
+	}
+
+	uint64_t read_counter(void) {
+		return read(HPET_MAIN_COUNTER);
+	}
+
+	/**
+	 * @brief Set up comparator 0 as a one-shot interrupt on IRQ0
+	 *
+	 * Legacy replacement takes IRQ0 away from the PIT (and IRQ8 from the
+	 * RTC), so only call this once the PIT tick is no longer needed.
+	 *
+	 * @return False if the HPET cannot route comparator 0 to IRQ0
+	 */
+	bool event_init(void) {
+		if( !regs || !(read(HPET_CAP_ID) & HPET_CAP_LEGACY_ROUTE) )
+			return false;
+
+		uint64_t tconf = read(HPET_TIMER_CONF);
+		cmp_wide       = wide && (tconf & HPET_TN_SIZE_64);
+
+		tconf &= ~(HPET_TN_PERIODIC | HPET_TN_32BIT_MODE);
+		if( !cmp_wide )
+			tconf |= HPET_TN_32BIT_MODE;
+		write(HPET_TIMER_CONF, tconf | HPET_TN_INT_ENABLE);
+		write(HPET_TIMER_CMP, ~0ULL);
+
+		uint64_t conf = read(HPET_GEN_CONF) | HPET_GEN_CONF_ENABLE;
+		write(HPET_GEN_CONF, conf | HPET_GEN_CONF_LEGACY_RT);
+		return true;
+	}
+
+	/**
+	 * @brief Raise the comparator 0 interrupt at @p deadline_ns
+	 *
+	 * The comparator only fires when the counter passes it, so a deadline
+	 * that slipped into the past while it was being written is pushed out
+	 * until the write lands ahead of the counter.  A 32-bit comparator can
+	 * only look ~2^31 ticks ahead; a later deadline fires early and the
+	 * caller re-arms.
+	 */
+	void event_arm(uint64_t deadline_ns) {
+		uint64_t now   = time::now_ns();
+		uint64_t delta = deadline_ns > now ? deadline_ns - now : 0;
+		uint64_t ticks = kstd::mul_div64(delta, FS_PER_NS, period_fs);
+
+		if( !cmp_wide && ticks > 0x7FFFFFFFULL )
+			ticks = 0x7FFFFFFFULL;
+
+		for( ;; ) {
+			if( ticks < min_delta )
+				ticks = min_delta;
+
+			uint64_t target = read_counter() + ticks;
+			write(HPET_TIMER_CMP, cmp_wide ? target : (uint32_t) target);
+
+			uint64_t diff = target - read_counter();
+			int64_t  ahead =
+			    cmp_wide ? (int64_t) diff : (int32_t) (uint32_t) diff;
+			if( ahead > 0 )
+				return;
+			ticks *= 2;
+		}
+	}
+}  // namespace hpet
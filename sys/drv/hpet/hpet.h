@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * High Precision Event Timer, located through the ACPI "HPET" table.
+ *
+ * The main counter backs time::now_ns() when there is no invariant TSC,
+ * and comparator 0 can serve as the one-shot timer interrupt.  It is
+ * routed with legacy replacement, so it arrives on IRQ0 in place of the
+ * PIT.
+ */
+namespace hpet {
+	bool     init(void);
+	bool     is_available(void);
+	bool     is_64bit(void);
+	uint64_t get_period_fs(void);
+	uint64_t read_counter(void);
+
+	bool event_init(void);
+	void event_arm(uint64_t deadline_ns);
+}  // namespace hpet
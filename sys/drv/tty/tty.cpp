@@ -13,40 +13,98 @@
 
 #include <drv/keyboard/keyboard.h>
 #include <drv/video/video.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/spinlock.h>
+#include <kern/work/work.h>
 
 struct Main_tty main_tty;
 
+// Characters waiting to be echoed; drawing them is left to echo_work
+static char         echo_buf[TTY_BUF_SIZE];
+static volatile int echo_head = 0;
+static volatile int echo_tail = 0;
+static work::item   echo_work;
+
+// Readers blocked in read_char()
+static sched::wait_queue input_wait;
+
+// Guards the input ring indices; the keyboard interrupt takes it too
+static sync::lock_stats  input_stats("tty.input");
+static sync::ticket_lock input_lock(&input_stats);
+
 namespace tty {
+	static void echo_flush(void *arg) {
+		(void) arg;
+
+		while( echo_tail != echo_head ) {
+			char c    = echo_buf[echo_tail];
+			echo_tail = (echo_tail + 1) % TTY_BUF_SIZE;
+
+			// ONLY echo safe characters - NEVER echo control chars
+			unsigned char uc = (unsigned char) c;
+			if( c == '\b' || c == 127 ) {
+				main_tty.write_char('\b');
+				main_tty.write_char(' ');
+				main_tty.write_char('\b');
+			} else if( uc >= 32 && uc <= 126 ) {
+				main_tty.write_char(c);
+			}
+			// Everything else: NO ECHO (includes \r, \n, \t, ESC, etc)
+		}
+	}
+
+	/**
+	 * @brief Take a character from the keyboard interrupt
+	 *
+	 * Only buffers it and wakes the reader: the echo is drawn by deferred
+	 * work once the interrupt has been acknowledged.
+	 */
 	void receive_char(char c) {
-		int next = (main_tty.head + 1) % TTY_BUF_SIZE;
-		if( next != main_tty.tail ) {
+		sync::lock(&input_lock);
+		int  next   = (main_tty.head + 1) % TTY_BUF_SIZE;
+		bool stored = next != main_tty.tail;
+		if( stored ) {
 			main_tty.input_buf[main_tty.head] = c;
 			main_tty.head                     = next;
+		}
+		sync::unlock(&input_lock);
+		if( !stored )
+			return;
 
-			// ONLY echo safe characters - NEVER echo control chars
-			if( main_tty.echo ) {
-				unsigned char uc = (unsigned char) c;
-
-				if( c == '\b' || c == 127 ) {
-					main_tty.write_char('\b');
-					main_tty.write_char(' ');
-					main_tty.write_char('\b');
-				} else if( uc >= 32 && uc <= 126 ) {
-					main_tty.write_char(c);
-				}
-				// Everything else: NO ECHO (includes \r, \n, \t, ESC, etc)
-			}
+		int echo_next = (echo_head + 1) % TTY_BUF_SIZE;
+		if( main_tty.echo && echo_next != echo_tail ) {
+			echo_buf[echo_head] = c;
+			echo_head           = echo_next;
+			work::queue(&echo_work);
 		}
+		sched::wake_all(&input_wait);
 	}
 
+	static bool has_input(void *arg) {
+		(void) arg;
+		return main_tty.head != main_tty.tail;
+	}
+
+	/**
+	 * @brief Take the next input character, blocking until there is one
+	 *
+	 * Other threads run while the reader waits.  When several readers
+	 * wake for one character, the ones that lose go back to waiting.
+	 */
 	int read_char(void) {
-		while( main_tty.head == main_tty.tail )
-			__asm__ volatile("sti; hlt");
+		int  c     = 0;
+		bool taken = false;
+		while( !taken ) {
+			sched::wait(&input_wait, has_input, nullptr);
 
-		__asm__ volatile("cli");
-		int c         = main_tty.input_buf[main_tty.tail];
-		main_tty.tail = (main_tty.tail + 1) % TTY_BUF_SIZE;
-		__asm__ volatile("sti");
+			uint64_t flags = sync::lock_irqsave(&input_lock);
+			taken          = main_tty.head != main_tty.tail;
+			if( taken ) {
+				c             = main_tty.input_buf[main_tty.tail];
+				main_tty.tail = (main_tty.tail + 1) % TTY_BUF_SIZE;
+			}
+			sync::unlock_irqrestore(&input_lock, flags);
+		}
 
 		// Convert CR to LF
 		if( c == '\r' )
@@ -65,6 +123,7 @@ namespace tty {
 		main_tty.tail       = 0;
 		main_tty.echo       = 1;
 		main_tty.write_char = video::putchar;
+		work::setup(&echo_work, echo_flush, nullptr);
 
 		keyboard::init();
 		video::clear(0x000000);
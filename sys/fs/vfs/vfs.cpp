@@ -17,7 +17,13 @@
 #include "vfs_fs_ops.h"
 
 #include <fs/ext2/ext2.h>
+#include <kern/sync/rcu.h>
 
+/*
+ * root_fs is published with RCU so it can be swapped while other CPUs use
+ * it.  The operation tables are static and never freed, so readers only
+ * need to load the pointer once and keep using what they loaded.
+ */
 static char                 cwd_path[256] = "/";
 static vfs_fs_operations_t *root_fs       = nullptr;
 
@@ -35,14 +41,14 @@ namespace vfs {
  * @brief Sets the active root filesystem
  */
 	void set_root_fs(vfs_fs_operations_t *fs_ops) {
-		root_fs = fs_ops;
+		rcu::assign_pointer(&root_fs, fs_ops);
 	}
 
 	/**
  * @brief Gets the current root filesystem operations
  */
 	vfs_fs_operations_t *get_root_fs(void) {
-		return root_fs;
+		return rcu::dereference(&root_fs);
 	}
 
 	/**
@@ -188,25 +194,26 @@ namespace vfs {
  *           - A filesystem-specific error occurs.
  */
 	int chdir(const char *path) {
-		if( !root_fs || !root_fs->open || !root_fs->is_directory )
+		vfs_fs_operations_t *fs = get_root_fs();
+		if( !fs || !fs->open || !fs->is_directory )
 			return -1;  // No filesystem registered
 
 		char resolved[256] = {0};
 		resolve(path, resolved, sizeof(resolved));
 
 		vfs_file_t file{};
-		int        rc = root_fs->open(resolved, &file);
+		int        rc = fs->open(resolved, &file);
 		if( rc != 0 )
 			return rc;  // Propagate filesystem error
 
-		if( !root_fs->is_directory(&file) ) {
-			if( root_fs->close )
-				root_fs->close(&file);
+		if( !fs->is_directory(&file) ) {
+			if( fs->close )
+				fs->close(&file);
 			return -1;  // Not a directory
 		}
 
-		if( root_fs->close )
-			root_fs->close(&file);
+		if( fs->close )
+			fs->close(&file);
 
 		kstring::strcpy(cwd_path, resolved);
 		return 0;
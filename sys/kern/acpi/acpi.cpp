@@ -14,15 +14,17 @@
 #ifdef ARCH_AMD64
 #	include <arch/amd64/asm/io.h>
 #endif
+#include <kmemcmp.h>
+#include <kmemcpy.h>
 #include <ksleep.h>
 #include <kstddef.h>
 
 #include <dbg/logger.h>
 
 /*
- * This is not ACPI yet, this is a placeholder for ACPI.
- * Since I will polish the Tempest kernel before I decide
- * to lose my precious time on ACPI.
+ * Only table discovery for now: find the RSDP, walk the XSDT (or RSDT) and
+ * hand out tables by signature.  There is no AML interpreter, so power
+ * management below still goes through the legacy ports.
  */
 
 // ? Maybe use uACPI?
@@ -30,7 +32,141 @@
 // Define timeout for poweroff in milliseconds
 #define POWEROFF_TIMEOUT_MS 5000
 
+// Where the BIOS may put the RSDP: the first KiB of the EBDA, then the ROM area
+#define EBDA_SEGMENT_PTR 0x40E
+#define BIOS_ROM_START   0xE0000
+#define BIOS_ROM_END     0x100000
+
+// Tables have to sit in the identity-mapped first 4 GiB
+#define ACPI_MAPPED_LIMIT 0x100000000ULL
+
 namespace acpi {
+	static const rsdp       *root_pointer = nullptr;
+	static const sdt_header *root_table   = nullptr;
+	static bool              root_is_xsdt = false;
+
+	static bool checksum_ok(const void *p, size_t len) {
+		const uint8_t *b   = (const uint8_t *) p;
+		uint8_t        sum = 0;
+		for( size_t i = 0; i < len; i++ )
+			sum = (uint8_t) (sum + b[i]);
+		return sum == 0;
+	}
+
+	static bool valid_rsdp(const rsdp *r) {
+		// The ACPI 1.0 checksum only covers the first 20 bytes
+		return kstring::memcmp(r->signature, "RSD PTR ", 8) == 0
+		    && checksum_ok(r, 20);
+	}
+
+	static const rsdp *scan_rsdp(uintptr_t start, uintptr_t end) {
+		// The RSDP is always on a 16-byte boundary
+		for( uintptr_t p = start; p + sizeof(rsdp) <= end; p += 16 ) {
+			if( valid_rsdp((const rsdp *) p) )
+				return (const rsdp *) p;
+		}
+		return nullptr;
+	}
+
+	static const sdt_header *map_table(uint64_t phys) {
+		if( phys == 0 || phys >= ACPI_MAPPED_LIMIT )
+			return nullptr;
+
+		const sdt_header *h = (const sdt_header *) (uintptr_t) phys;
+		if( h->length < sizeof(sdt_header) || !checksum_ok(h, h->length) )
+			return nullptr;
+		return h;
+	}
+
+	/**
+	 * @brief Use the RSDP copy handed over by the bootloader
+	 *
+	 * Takes priority over the BIOS area scan in init(), and is the only
+	 * way to find it on UEFI machines.  The copy is saved, since the boot
+	 * information it lives in is not kept.
+	 *
+	 * @param p RSDP, ACPI 1.0 (20 bytes) or 2.0+ (36 bytes)
+	 */
+	void set_rsdp(const void *p) {
+		static rsdp saved;
+
+		const rsdp *r = (const rsdp *) p;
+		if( !r || !valid_rsdp(r) )
+			return;
+		if( root_pointer && root_pointer->revision > r->revision )
+			return;
+
+		kstring::memcpy(&saved, r, r->revision >= 2 ? sizeof(rsdp) : 20);
+		root_pointer = &saved;
+	}
+
+	/**
+	 * @brief Locate the root table
+	 * @return False if there are no usable ACPI tables
+	 */
+	bool init(void) {
+		if( !root_pointer ) {
+			// Hide the constant from the compiler; it is a real address here
+			uintptr_t bda = EBDA_SEGMENT_PTR;
+			__asm__("" : "+r"(bda));
+			uintptr_t ebda = (uintptr_t) *(const uint16_t *) bda << 4;
+			if( ebda )
+				root_pointer = scan_rsdp(ebda, ebda + 1024);
+		}
+		if( !root_pointer )
+			root_pointer = scan_rsdp(BIOS_ROM_START, BIOS_ROM_END);
+		if( !root_pointer ) {
+			logger::debug::puts("acpi", "warn", "No RSDP found");
+			return false;
+		}
+
+		const rsdp *r = root_pointer;
+		if( r->revision >= 2 && checksum_ok(r, r->length) ) {
+			root_table   = map_table(r->xsdt_address);
+			root_is_xsdt = root_table != nullptr;
+		}
+		if( !root_table )
+			root_table = map_table(r->rsdt_address);
+
+		if( !root_table ) {
+			logger::debug::puts("acpi", "warn", "No valid RSDT/XSDT");
+			return false;
+		}
+
+		logger::debug::printf("acpi",
+		                      "info",
+		                      "ACPI rev %u, %s at 0x%llx\n",
+		                      r->revision,
+		                      root_is_xsdt ? "XSDT" : "RSDT",
+		                      (uint64_t) (uintptr_t) root_table);
+		return true;
+	}
+
+	/**
+	 * @brief Find a table by its 4-character signature
+	 * @return The table, checksum verified, or nullptr
+	 */
+	const sdt_header *find_table(const char *signature) {
+		if( !root_table )
+			return nullptr;
+
+		// Entries are 64-bit in the XSDT and 32-bit in the RSDT, unaligned
+		size_t         entry_size = root_is_xsdt ? 8 : 4;
+		const uint8_t *entries    = (const uint8_t *) (root_table + 1);
+		size_t         count =
+		    (root_table->length - sizeof(sdt_header)) / entry_size;
+
+		for( size_t i = 0; i < count; i++ ) {
+			uint64_t phys = 0;
+			kstring::memcpy(&phys, entries + i * entry_size, entry_size);
+
+			const sdt_header *h = map_table(phys);
+			if( h && kstring::memcmp(h->signature, signature, 4) == 0 )
+				return h;
+		}
+		return nullptr;
+	}
+
 	/**
  * @brief Legacy poweroff function that uses the legacy BIOS ports
  * @warning If the ports fail, the machine may not power off because of modern hardware
@@ -11,7 +11,106 @@
  */
 #pragma once
 
+#include <kstdint.h>
+
 namespace acpi {
+	// Root System Description Pointer (ACPI 2.0+ layout)
+	struct rsdp {
+		char     signature[8];  // "RSD PTR "
+		uint8_t  checksum;
+		char     oem_id[6];
+		uint8_t  revision;  // 0 for ACPI 1.0, which ends after rsdt_address
+		uint32_t rsdt_address;
+		uint32_t length;
+		uint64_t xsdt_address;
+		uint8_t  extended_checksum;
+		uint8_t  reserved[3];
+	} __attribute__((packed));
+
+	// Header shared by every System Description Table
+	struct sdt_header {
+		char     signature[4];
+		uint32_t length;
+		uint8_t  revision;
+		uint8_t  checksum;
+		char     oem_id[6];
+		char     oem_table_id[8];
+		uint32_t oem_revision;
+		uint32_t creator_id;
+		uint32_t creator_revision;
+	} __attribute__((packed));
+
+	struct generic_address {
+		uint8_t  address_space;  // 0 = system memory, 1 = system I/O
+		uint8_t  bit_width;
+		uint8_t  bit_offset;
+		uint8_t  access_size;
+		uint64_t address;
+	} __attribute__((packed));
+
+	// "HPET": High Precision Event Timer description
+	struct hpet_table {
+		sdt_header      header;
+		uint32_t        event_timer_block_id;
+		generic_address base;
+		uint8_t         hpet_number;
+		uint16_t        min_tick;  // Smallest safe periodic tick, in ticks
+		uint8_t         page_protection;
+	} __attribute__((packed));
+
+	// "APIC": Multiple APIC Description Table, followed by madt_entry records
+	struct madt {
+		sdt_header header;
+		uint32_t   lapic_address;
+		uint32_t   flags;  // Bit 0: the 8259 pair is also present
+	} __attribute__((packed));
+
+	struct madt_entry {
+		uint8_t type;
+		uint8_t length;
+	} __attribute__((packed));
+
+	// madt_entry::type values
+	constexpr uint8_t MADT_LAPIC  = 0;
+	constexpr uint8_t MADT_IOAPIC = 1;
+	constexpr uint8_t MADT_ISO    = 2;  // Interrupt source override
+	constexpr uint8_t MADT_X2APIC = 9;
+
+	struct madt_lapic {
+		madt_entry entry;
+		uint8_t    processor_id;
+		uint8_t    apic_id;
+		uint32_t   flags;  // Bit 0: enabled, bit 1: can be brought online
+	} __attribute__((packed));
+
+	struct madt_ioapic {
+		madt_entry entry;
+		uint8_t    ioapic_id;
+		uint8_t    reserved;
+		uint32_t   address;
+		uint32_t   gsi_base;
+	} __attribute__((packed));
+
+	struct madt_iso {
+		madt_entry entry;
+		uint8_t    bus;  // Always 0 (ISA)
+		uint8_t    source;
+		uint32_t   gsi;
+		uint16_t   flags;  // MPS INTI polarity (bits 0-1) and trigger (bits 2-3)
+	} __attribute__((packed));
+
+	struct madt_x2apic {
+		madt_entry entry;
+		uint16_t   reserved;
+		uint32_t   x2apic_id;
+		uint32_t   flags;
+		uint32_t   processor_uid;
+	} __attribute__((packed));
+
+	void              set_rsdp(const void *rsdp);
+	bool              init(void);
+	const sdt_header *find_table(const char *signature);
+
 	void poweroff(void);
 	void reboot(void);
 }  // namespace acpi
\ No newline at end of file
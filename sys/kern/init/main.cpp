@@ -10,10 +10,16 @@
  * -- END OF METADATA HEADER --
  */
 #ifdef ARCH_AMD64
+#	include <arch/amd64/apic/lapic.h>
+#	include <arch/amd64/gdt/gdt.h>
+#	include <arch/amd64/syscall/entry.h>
+#	include <arch/amd64/user/user.h>
 #	include <arch/amd64/cpu/cpuid.h>
 #	include <arch/amd64/cpu/instr/instr.h>
 #	include <arch/amd64/idt/idt.h>
 #	include <arch/amd64/cpu/halt.h>
+#	include <arch/amd64/cpu/percpu.h>
+#	include <arch/amd64/smp/smp.h>
 #endif
 #include <kprint.h>
 
@@ -21,11 +27,15 @@
 #include <drv/driver.h>
 #include <drv/tty/tty.h>
 #include <fs/ext2/ext2.h>
+#include <kern/acpi/acpi.h>
 #include <kern/framebuf/framebuf.h>
 #include <kern/mb/mb.h>
 #include <kern/memory/memory.h>
+#include <kern/sched/sched.h>
+#include <kern/sched/tasks.h>
 #include <kern/syscall/integration.h>
 #include <kern/timer/timer.h>
+#include <kern/vdso/vdso.h>
 #include <kshell/kernSh.h>
 
 static void
@@ -69,16 +79,29 @@ static void
  */
 extern "C" void
     start_kernel(void *mb_info) {
+#ifdef ARCH_AMD64
+	amd64::percpu::init(0);  // GS base; everything after may use percpu
+#endif
 	serial::init();
 
 	isHardware_minReq();
 
 #ifdef ARCH_AMD64
+	amd64::fpu::init();  // XSAVE, XCR0 and the save area size
+	amd64::gdt::init();
 	amd64::idt::init();
+	amd64::lapic::init();
 #endif
+	// ACPI tables may come from the multiboot info; the timers need them
+	multiboot::parse(mb_info);
+	acpi::init();
+#ifdef ARCH_AMD64
+	amd64::irq::init_apic();  // IOAPIC routing, from the MADT
+#endif
+	hpet::init();
+
 	timer_init();  // Initialize the uptime timer
 
-	multiboot::parse(mb_info);
 	video::init(&fb_info);
 	tty::init();
 
@@ -87,6 +110,11 @@ extern "C" void
 
 	// Initialize syscall infrastructure
 	syscall::infrastructure::init();
+#ifdef ARCH_AMD64
+	amd64::syscall::init();
+	amd64::user::init();
+#endif
+	vdso::init();
 
 	ext2::set_block_device(ata::pio_read, nullptr);
 	if( ext2::mount(0) != 0 )
@@ -96,7 +124,14 @@ extern "C" void
 	amd64::cpuid::init();  // Initialize the vendor and brand of the CPU
 #endif
 
+	sched::init();  // This code becomes the "main" thread
+
 	__asm__ volatile("sti");
 
+#ifdef ARCH_AMD64
+	amd64::smp::init();  // Needs interrupts for the delays on the PIT
+#endif
+	sched::tasks::init();  // A worker thread on every other CPU
+
 	kshell();
 }
@@ -13,6 +13,7 @@
 
 #include <kstdio.h>
 
+#include "kern/acpi/acpi.h"
 #include "kern/framebuf/framebuf.h"
 #ifdef ARCH_AMD64
 #	include <arch/amd64/cpu/halt.h>
@@ -48,9 +49,17 @@ struct multiboot_tag_framebuffer {
 	uint8_t  reserved[2];
 } __attribute__((aligned(8)));
 
+struct multiboot_tag_acpi {
+	uint32_t type;
+	uint32_t size;
+	uint8_t  rsdp[36];  // Copy of the RSDP; only 20 bytes for ACPI 1.0
+};
+
 typedef enum {
 	MULTIBOOT_TAG_TYPE_END         = 0,
-	MULTIBOOT_TAG_TYPE_FRAMEBUFFER = 8
+	MULTIBOOT_TAG_TYPE_FRAMEBUFFER = 8,
+	MULTIBOOT_TAG_TYPE_ACPI_OLD    = 14,
+	MULTIBOOT_TAG_TYPE_ACPI_NEW    = 15
 } multiboot_tag_type_t;
 
 namespace multiboot {
@@ -114,6 +123,14 @@ namespace multiboot {
 					break;
 				}
 
+				case MULTIBOOT_TAG_TYPE_ACPI_OLD:
+				case MULTIBOOT_TAG_TYPE_ACPI_NEW: {
+					struct multiboot_tag_acpi *acpi_tag =
+					    (struct multiboot_tag_acpi *) tag;
+					acpi::set_rsdp(acpi_tag->rsdp);
+					break;
+				}
+
 				default:
 					// Unhandled tag
 					// ! DO NOT FUCKING PRINT A ERROR MESSAGE
@@ -15,6 +15,8 @@
 #include <kstring.h>
 
 #include <kern/panic/panic.h>
+#include <kern/stat/kstat.h>
+#include <kern/sync/spinlock.h>
 
 struct multiboot_tag {
 	uint32_t type;
@@ -25,14 +27,27 @@ struct multiboot_tag {
 static page_frame_t *free_page_list = nullptr;
 static page_frame_t *page_frames    = nullptr;
 static uint64_t      total_pages    = 0;
-static uint64_t      free_pages     = 0;
-static uint64_t      used_pages     = 0;
+
+KSTAT_GAUGE(free_pages, "memory.pages.free");
+KSTAT_GAUGE(used_pages, "memory.pages.used");
+KSTAT_COUNTER(page_allocs, "memory.pages.allocs");
+KSTAT_COUNTER(page_frees, "memory.pages.frees");
+
+static sync::lock_stats  frame_stats("memory.frames");
+static sync::ticket_lock frame_lock(&frame_stats);
 
 // Heap state
 static heap_block_t *heap_start = nullptr;
 static heap_block_t *heap_end   = nullptr;
 static uint64_t      heap_size  = 0;
-static uint64_t      heap_used  = 0;
+
+KSTAT_GAUGE(heap_used, "memory.heap.used");
+KSTAT_COUNTER(heap_allocs, "memory.heap.allocs");
+KSTAT_COUNTER(heap_frees, "memory.heap.frees");
+KSTAT_COUNTER(heap_failures, "memory.heap.failures");
+
+static sync::lock_stats  heap_stats("memory.heap");
+static sync::ticket_lock heap_lock(&heap_stats);
 
 // Current page table
 static pml4_t *current_pml4 = nullptr;
@@ -98,9 +113,6 @@ namespace memory {
 			}
 		}
 
-		free_pages = total_pages;
-		used_pages = 0;
-
 		// Initialize page frame array
 		page_frames = (page_frame_t *) KERNEL_HEAP_BASE;
 
@@ -122,19 +134,21 @@ namespace memory {
 		}
 
 		// Build free page list
-		free_page_list = nullptr;
+		free_page_list        = nullptr;
+		uint64_t kernel_pages = 0;
 		for( uint64_t i = 0; i < total_pages; i++ ) {
 			// Skip pages used by kernel
 			if( page_frames[i].physical_addr < KERNEL_HEAP_BASE ) {
 				page_frames[i].is_free = false;
-				used_pages++;
-				free_pages--;
+				kernel_pages++;
 				continue;
 			}
 
 			page_frames[i].next = free_page_list;
 			free_page_list      = &page_frames[i];
 		}
+		kstat::add(&free_pages, (int64_t) (total_pages - kernel_pages));
+		kstat::add(&used_pages, (int64_t) kernel_pages);
 
 		// Initialize virtual memory
 		vm::init();
@@ -144,7 +158,9 @@ namespace memory {
 	}
 
 	page_frame_t *allocate_page_frame(void) {
+		uint64_t flags = sync::lock_irqsave(&frame_lock);
 		if( !free_page_list ) {
+			sync::unlock_irqrestore(&frame_lock, flags);
 			return nullptr;  // Out of memory
 		}
 
@@ -155,28 +171,34 @@ namespace memory {
 		frame->ref_count = 1;
 		frame->is_free   = false;
 
-		free_pages--;
-		used_pages++;
+		sync::unlock_irqrestore(&frame_lock, flags);
 
+		kstat::inc(&page_allocs);
+		kstat::dec(&free_pages);
+		kstat::inc(&used_pages);
 		return frame;
 	}
 
 	void free_page_frame(page_frame_t *frame) {
-		if( !frame || frame->is_free ) {
+		if( !frame )
 			return;
-		}
 
-		frame->ref_count--;
-		if( frame->ref_count > 0 ) {
-			return;  // Still referenced
+		uint64_t flags = sync::lock_irqsave(&frame_lock);
+		if( frame->is_free || --frame->ref_count > 0 ) {
+			// Already free, or still referenced
+			sync::unlock_irqrestore(&frame_lock, flags);
+			return;
 		}
 
 		frame->next    = free_page_list;
 		free_page_list = frame;
 		frame->is_free = true;
 
-		free_pages++;
-		used_pages--;
+		sync::unlock_irqrestore(&frame_lock, flags);
+
+		kstat::inc(&page_frees);
+		kstat::inc(&free_pages);
+		kstat::dec(&used_pages);
 	}
 
 	uint64_t get_physical_addr(page_frame_t *frame) {
@@ -384,7 +406,6 @@ namespace memory {
 		void init(void) {
 			heap_start = (heap_block_t *) KERNEL_HEAP_BASE;
 			heap_size  = KERNEL_HEAP_SIZE;
-			heap_used  = 0;
 
 			// Initialize first block
 			heap_start->size    = heap_size - sizeof(heap_block_t);
@@ -396,6 +417,8 @@ namespace memory {
 		}
 
 		void defrag(void) {
+			uint64_t flags = sync::lock_irqsave(&heap_lock);
+
 			// Simple defragmentation: move all free blocks to the end
 			heap_block_t *current   = heap_start;
 			heap_block_t *last_free = nullptr;
@@ -431,6 +454,8 @@ namespace memory {
 					current = current->next;
 				}
 			}
+
+			sync::unlock_irqrestore(&heap_lock, flags);
 		}
 	}  // namespace heap
 
@@ -438,11 +463,11 @@ namespace memory {
 		memory_stats_t get(void) {
 			memory_stats_t stats;
 			stats.total_physical_pages = total_pages;
-			stats.free_physical_pages  = free_pages;
-			stats.used_physical_pages  = used_pages;
+			stats.free_physical_pages  = (uint64_t) kstat::read(&free_pages);
+			stats.used_physical_pages  = (uint64_t) kstat::read(&used_pages);
 			stats.total_heap_size      = heap_size;
-			stats.free_heap_size       = heap_size - heap_used;
-			stats.used_heap_size       = heap_used;
+			stats.used_heap_size       = (uint64_t) kstat::read(&heap_used);
+			stats.free_heap_size       = heap_size - stats.used_heap_size;
 			return stats;
 		}
 
@@ -469,6 +494,8 @@ namespace memory {
 		// Add header size and align to 8 bytes
 		size_t total_size = (size + sizeof(heap_block_t) + 7) & ~(size_t) 0x7;
 
+		uint64_t      flags   = sync::lock_irqsave(&heap_lock);
+		void         *ptr     = nullptr;
 		heap_block_t *current = heap_start;
 		while( current ) {
 			if( current->is_free && current->size >= total_size ) {
@@ -493,14 +520,18 @@ namespace memory {
 				}
 
 				current->is_free = false;
-				heap_used += current->size;
+				kstat::add(&heap_used, (int64_t) current->size);
 
-				return (uint8_t *) current + sizeof(heap_block_t);
+				ptr = (uint8_t *) current + sizeof(heap_block_t);
+				break;
 			}
 			current = current->next;
 		}
 
-		return nullptr;  // Out of memory
+		sync::unlock_irqrestore(&heap_lock, flags);
+
+		kstat::inc(ptr ? &heap_allocs : &heap_failures);
+		return ptr;  // nullptr when out of memory
 	}
 
 	void *calloc(size_t count, size_t size) {
@@ -540,11 +571,16 @@ namespace memory {
 
 		heap_block_t *block =
 		    (heap_block_t *) ((uint8_t *) ptr - sizeof(heap_block_t));
-		if( block->is_free )
+
+		uint64_t flags = sync::lock_irqsave(&heap_lock);
+		if( block->is_free ) {
+			sync::unlock_irqrestore(&heap_lock, flags);
 			return;  // Already freed
+		}
 
 		block->is_free = true;
-		heap_used -= block->size;
+		kstat::add(&heap_used, -(int64_t) block->size);
+		kstat::inc(&heap_frees);
 
 		// Merge with next block if it's free
 		if( block->next && block->next->is_free ) {
@@ -563,6 +599,7 @@ namespace memory {
 				block->next->prev = block->prev;
 			}
 		}
+		sync::unlock_irqrestore(&heap_lock, flags);
 	}
 
 	// Memory mapping
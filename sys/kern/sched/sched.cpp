@@ -0,0 +1,689 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "sched.h"
+
+#include <ktime.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/sync/rcu.h>
+#include <kern/timer/hrtimer.h>
+#include <kern/work/work.h>
+
+extern "C" {
+void context_switch(uint64_t *prev_rsp, uint64_t next_rsp);
+void thread_entry(void);
+}
+
+namespace sched {
+	namespace fpu    = amd64::fpu;
+	namespace percpu = amd64::percpu;
+
+	constexpr uint32_t MAX_CPUS = amd64::madt::MAX_CPUS;
+
+	struct fifo {
+		thread *head;
+		thread *tail;
+	};
+
+	struct alignas(64) run_queue {
+		sync::ticket_lock lock;
+		uint32_t          ready_mask;  // Bit n set while queue[n] is not empty
+		fifo              queue[PRIORITIES];
+
+		thread        *current;
+		thread        *idle;  // nullptr until the CPU calls init_cpu()
+		thread        *dead;  // Exited thread, freed once off its stack
+		volatile bool  need_resched;
+		uint32_t       preempt_count;
+		hrtimer::entry slice;
+		cpu_stats      stats;
+	};
+
+	static run_queue        queues[MAX_CPUS];
+	static sync::lock_stats runqueue_stats("sched.runqueue");
+
+	// spawn() pool
+	static thread            threads[MAX_THREADS];
+	static fpu::context      thread_fpus[MAX_THREADS];
+	alignas(16) static uint8_t stacks[MAX_THREADS][STACK_SIZE];
+	static sync::lock_stats  pool_stats("sched.pool");
+	static sync::ticket_lock pool_lock(&pool_stats);  // Taken with interrupts off
+	static uint32_t          next_id = 0;
+
+	// What start_kernel() runs on, and one idle thread per CPU
+	static thread              main_thread;
+	static thread              idle_threads[MAX_CPUS];
+	static fpu::context        idle_fpus[MAX_CPUS];
+	alignas(16) static uint8_t boot_idle_stack[STACK_SIZE];
+
+	static bool running = false;
+
+	static inline run_queue *this_rq(void) {
+		return &queues[percpu::id()];
+	}
+
+	static void enqueue(run_queue *rq, thread *t) {
+		fifo *q = &rq->queue[t->prio];
+		t->next = nullptr;
+		if( q->tail )
+			q->tail->next = t;
+		else
+			q->head = t;
+		q->tail = t;
+		rq->ready_mask |= 1U << t->prio;
+		rq->stats.ready++;
+	}
+
+	static thread *dequeue(run_queue *rq) {
+		if( !rq->ready_mask )
+			return nullptr;
+
+		fifo   *q = &rq->queue[__builtin_ctz(rq->ready_mask)];
+		thread *t = q->head;
+		q->head   = t->next;
+		if( !q->head ) {
+			q->tail = nullptr;
+			rq->ready_mask &= ~(1U << t->prio);
+		}
+		rq->stats.ready--;
+		return t;
+	}
+
+	/**
+	 * @brief True if a ready thread could take the CPU from one at @p prio
+	 */
+	static inline bool contended(const run_queue *rq, uint8_t prio) {
+		return rq->ready_mask & ((2U << prio) - 1);
+	}
+
+	static void start_slice(run_queue *rq) {
+		hrtimer::start(
+		    &rq->slice, time::now_ns() + SLICE_NS, hrtimer::MAX_SLACK_NS);
+	}
+
+	static void kick(uint32_t cpu) {
+		if( cpu != percpu::id() )
+			amd64::smp::kick(cpu);
+	}
+
+	/**
+	 * @brief Slice timer: make the running thread take turns
+	 *
+	 * Only armed while another thread of the same level is ready, and
+	 * harmless if that has changed by the time it fires.
+	 */
+	static void slice_expired(void *arg) {
+		run_queue *rq  = (run_queue *) arg;
+		uint32_t   cpu = (uint32_t) (rq - queues);
+
+		sync::lock(&rq->lock);
+		bool turn = !rq->current->idle && contended(rq, rq->current->prio);
+		if( turn )
+			rq->need_resched = true;
+		sync::unlock(&rq->lock);
+
+		if( turn )
+			kick(cpu);
+	}
+
+	/**
+	 * @brief Move a blocked thread to its run queue
+	 *
+	 * Asks for the thread running there to be preempted if the woken one
+	 * is more important: another CPU gets a reschedule IPI, this one
+	 * switches in irq_exit() or preempt_check().  A thread that is not
+	 * blocked (the wakeup raced with it giving up on its wait) is left
+	 * alone.
+	 */
+	static void make_ready(thread *t) {
+		run_queue *rq    = &queues[t->cpu];
+		uint64_t   flags = irq_save();
+
+		sync::lock(&rq->lock);
+		if( t->st != state::blocked ) {
+			sync::unlock(&rq->lock);
+			irq_restore(flags);
+			return;
+		}
+
+		t->st = state::ready;
+		enqueue(rq, t);
+		rq->stats.wakeups++;
+
+		thread *cur     = rq->current;
+		bool    preempt = cur->idle || t->prio < cur->prio;
+		bool    slice   = !preempt && t->prio == cur->prio
+		             && !hrtimer::is_queued(&rq->slice);
+		if( preempt )
+			rq->need_resched = true;
+		sync::unlock(&rq->lock);
+
+		if( slice )
+			start_slice(rq);
+		if( preempt )
+			kick(t->cpu);
+		irq_restore(flags);
+	}
+
+	/**
+	 * @brief Free the thread that exited on the way to this one
+	 */
+	static void finish_switch(void) {
+		run_queue *rq   = this_rq();
+		thread    *dead = rq->dead;
+		if( !dead )
+			return;
+
+		rq->dead = nullptr;
+		fpu::release(dead->fpu);
+		sync::lock(&pool_lock);
+		dead->in_use = false;
+		sync::unlock(&pool_lock);
+	}
+
+	/**
+	 * @brief Pick the next thread on this CPU and switch to it
+	 *
+	 * Call with interrupts off.  A running thread goes to the back of its
+	 * level; a blocked or dead one is just left.  Returns once the calling
+	 * thread is picked again.  A switch is a quiescent state for RCU.
+	 */
+	static void schedule(void) {
+		run_queue *rq   = this_rq();
+		thread    *prev = rq->current;
+
+		rcu::quiescent();
+		sync::lock(&rq->lock);
+		rq->need_resched = false;
+		if( prev->st == state::running ) {
+			prev->st = state::ready;
+			if( !prev->idle )
+				enqueue(rq, prev);
+		}
+
+		thread *next = dequeue(rq);
+		if( !next )
+			next = rq->idle;
+		next->st    = state::running;
+		rq->current = next;
+
+		bool slice = !next->idle && contended(rq, next->prio)
+		          && !hrtimer::is_queued(&rq->slice);
+		sync::unlock(&rq->lock);
+
+		if( next == prev )
+			return;
+
+		if( prev->st == state::dead )
+			rq->dead = prev;
+		rq->stats.switches++;
+		next->switches++;
+
+		if( slice )
+			start_slice(rq);
+		percpu::get()->task = next;
+		fpu::switch_to(next->fpu);
+		context_switch(&prev->rsp, next->rsp);
+		finish_switch();
+	}
+
+	/**
+	 * @brief Switch now if a wakeup asked for it and switching is allowed
+	 *
+	 * Interrupt handlers run with interrupts off and deferred work with
+	 * preemption off, so passing both checks means thread context.
+	 * Interrupt handlers leave the switch to irq_exit().
+	 */
+	static void preempt_check(void) {
+		run_queue *rq = this_rq();
+		if( !rq->need_resched || rq->preempt_count || !rq->current
+		    || !irq_enabled() )
+			return;
+
+		uint64_t flags = irq_save();
+		schedule();
+		irq_restore(flags);
+	}
+
+	/**
+	 * @brief Where a new thread first runs, called by thread_entry
+	 */
+	[[noreturn]] static void thread_start(thread *t) {
+		finish_switch();
+		__asm__ volatile("sti" : : : "memory");
+		t->fn(t->arg);
+		exit();
+	}
+
+	/**
+	 * @brief Lay out a first switch into thread_entry on @p stack_top
+	 *
+	 * Matches the pops in context_switch: r15, r14, r13, r12, rbx, rbp
+	 * and the return address.
+	 */
+	static void make_frame(thread *t, uint8_t *stack_top) {
+		uint64_t *sp = (uint64_t *) stack_top - 7;
+		sp[0]        = 0;
+		sp[1]        = 0;
+		sp[2]        = (uint64_t) thread_start;
+		sp[3]        = (uint64_t) t;
+		sp[4]        = 0;
+		sp[5]        = 0;
+		sp[6]        = (uint64_t) thread_entry;
+		t->rsp       = (uint64_t) sp;
+	}
+
+	static uint32_t new_id(void) {
+		uint64_t flags = sync::lock_irqsave(&pool_lock);
+		uint32_t id = next_id++;
+		sync::unlock_irqrestore(&pool_lock, flags);
+		return id;
+	}
+
+	static void idle_main(void *arg) {
+		(void) arg;
+		idle();
+	}
+
+	static thread *setup_idle(uint32_t cpu) {
+		thread *t = &idle_threads[cpu];
+		t->name   = "idle";
+		t->fn     = idle_main;
+		t->fpu    = &idle_fpus[cpu];
+		t->id     = new_id();
+		t->cpu    = cpu;
+		t->prio   = PRIO_LOW;
+		t->st     = state::ready;
+		t->idle   = true;
+		t->in_use = true;
+		fpu::init_context(t->fpu);
+
+		run_queue *rq  = &queues[cpu];
+		rq->lock.stats = &runqueue_stats;
+		hrtimer::setup(&rq->slice, slice_expired, rq);
+		return t;
+	}
+
+	/**
+	 * @brief Start scheduling on the boot CPU
+	 *
+	 * The code that calls this becomes the "main" thread; the boot CPU's
+	 * idle thread gets a stack of its own and first runs when main blocks.
+	 * Call once the FPU is set up and before other CPUs are started.
+	 */
+	void init(void) {
+		run_queue *rq = this_rq();
+
+		thread *idle_thread = setup_idle(0);
+		make_frame(idle_thread, boot_idle_stack + STACK_SIZE);
+		rq->idle = idle_thread;
+
+		thread *t = &main_thread;
+		t->name   = "main";
+		t->fpu    = fpu::get_current();
+		t->id     = new_id();
+		t->cpu    = 0;
+		t->prio   = PRIO_DEFAULT;
+		t->st     = state::running;
+		t->in_use = true;
+
+		rq->current         = t;
+		percpu::get()->task = t;
+		running             = true;
+		rcu::init_cpu();
+	}
+
+	/**
+	 * @brief Start scheduling on an application processor
+	 *
+	 * The calling code becomes the CPU's idle thread; it should go on to
+	 * idle() and never return from it.
+	 */
+	void init_cpu(void) {
+		uint32_t   cpu = percpu::id();
+		run_queue *rq  = &queues[cpu];
+		thread    *t   = setup_idle(cpu);
+
+		t->st               = state::running;
+		rq->current         = t;
+		percpu::get()->task = t;
+		fpu::switch_to(t->fpu);
+		rcu::init_cpu();
+		__atomic_store_n(&rq->idle, t, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Idle loop: run deferred work, then halt until an interrupt
+	 *
+	 * The run queue is checked with interrupts off and "sti; hlt" halts
+	 * before any interrupt is taken, so a wakeup cannot slip in between.
+	 */
+	void idle(void) {
+		for( ;; ) {
+			work::run();
+			rcu::quiescent();
+			__asm__ volatile("cli" : : : "memory");
+			if( this_rq()->ready_mask ) {
+				schedule();
+				__asm__ volatile("sti" : : : "memory");
+			} else {
+				__asm__ volatile("sti; hlt" : : : "memory");
+			}
+		}
+	}
+
+	bool is_running(void) {
+		return running;
+	}
+
+	/**
+	 * @brief Start a thread running fn(arg) on CPU @p cpu
+	 *
+	 * The thread exits when @p fn returns.  The pointer returned is only
+	 * good while the thread is known to be alive.
+	 *
+	 * @return nullptr if the pool is full or the CPU is not scheduling
+	 */
+	thread *spawn(
+	    const char *name, thread_fn fn, void *arg, uint8_t prio, uint32_t cpu) {
+		if( cpu == THIS_CPU )
+			cpu = percpu::id();
+		if( !running || prio >= PRIORITIES || cpu >= MAX_CPUS
+		    || !__atomic_load_n(&queues[cpu].idle, __ATOMIC_ACQUIRE) )
+			return nullptr;
+
+		uint64_t flags = sync::lock_irqsave(&pool_lock);
+		uint32_t slot = 0;
+		while( slot < MAX_THREADS && threads[slot].in_use )
+			slot++;
+		if( slot == MAX_THREADS ) {
+			sync::unlock_irqrestore(&pool_lock, flags);
+			return nullptr;
+		}
+		thread *t = &threads[slot];
+		t->in_use = true;
+		t->id     = next_id++;
+		sync::unlock_irqrestore(&pool_lock, flags);
+
+		t->name     = name;
+		t->fn       = fn;
+		t->arg      = arg;
+		t->fpu      = &thread_fpus[slot];
+		t->cpu      = cpu;
+		t->prio     = prio;
+		t->st       = state::blocked;
+		t->idle     = false;
+		t->switches = 0;
+		fpu::init_context(t->fpu);
+		make_frame(t, stacks[slot] + STACK_SIZE);
+
+		make_ready(t);
+		preempt_check();
+		return t;
+	}
+
+	thread *current(void) {
+		return (thread *) percpu::get()->task;
+	}
+
+	/**
+	 * @brief Let the other ready threads of the same level run first
+	 */
+	void yield(void) {
+		uint64_t   flags = irq_save();
+		run_queue *rq    = this_rq();
+		if( running && rq->current && !rq->preempt_count )
+			schedule();
+		irq_restore(flags);
+	}
+
+	/**
+	 * @brief End the calling thread
+	 */
+	void exit(void) {
+		__asm__ volatile("cli" : : : "memory");
+		current()->st = state::dead;
+		schedule();
+		__builtin_unreachable();
+	}
+
+	static bool can_block(void) {
+		run_queue *rq = this_rq();
+		return running && rq->current && !rq->current->idle && !rq->preempt_count
+		    && irq_enabled();
+	}
+
+	/**
+	 * @brief Sleep on @p wq until done(arg) returns true
+	 *
+	 * @p done runs with the queue locked and interrupts off, so a waker
+	 * that changes the condition and then calls wake_one() or wake_all()
+	 * cannot be missed.  Interrupts are on when this returns.
+	 */
+	void wait(wait_queue *wq, wait_cond done, void *arg) {
+		if( !can_block() ) {
+			__asm__ volatile("cli" : : : "memory");
+			while( !done(arg) )
+				__asm__ volatile("sti; hlt; cli" : : : "memory");
+			// The waker may still hold the lock; wait for it to let go
+			sync::lock(&wq->lock);
+			sync::unlock(&wq->lock);
+			__asm__ volatile("sti" : : : "memory");
+			return;
+		}
+
+		thread *t = current();
+		for( ;; ) {
+			uint64_t flags = irq_save();
+			sync::lock(&wq->lock);
+			if( done(arg) ) {
+				sync::unlock(&wq->lock);
+				irq_restore(flags);
+				return;
+			}
+
+			t->st   = state::blocked;
+			t->next = nullptr;
+			if( wq->tail )
+				wq->tail->next = t;
+			else
+				wq->head = t;
+			wq->tail = t;
+			sync::unlock(&wq->lock);
+
+			schedule();
+			irq_restore(flags);
+		}
+	}
+
+	static thread *detach(wait_queue *wq, bool all) {
+		thread *list = wq->head;
+		if( list && !all ) {
+			wq->head = list->next;
+			if( !wq->head )
+				wq->tail = nullptr;
+			list->next = nullptr;
+		} else {
+			wq->head = nullptr;
+			wq->tail = nullptr;
+		}
+		return list;
+	}
+
+	static uint32_t wake_list(thread *list) {
+		uint32_t n = 0;
+		while( list ) {
+			thread *next = list->next;
+			make_ready(list);
+			list = next;
+			n++;
+		}
+		return n;
+	}
+
+	/**
+	 * @brief Wake the longest waiter on @p wq; safe from interrupt handlers
+	 * @return False if nobody was waiting
+	 */
+	bool wake_one(wait_queue *wq) {
+		uint64_t flags = irq_save();
+		sync::lock(&wq->lock);
+		thread *t = detach(wq, false);
+		sync::unlock(&wq->lock);
+		bool woke = wake_list(t) != 0;
+		irq_restore(flags);
+		preempt_check();
+		return woke;
+	}
+
+	/**
+	 * @brief Wake every waiter on @p wq; safe from interrupt handlers
+	 * @return Number of threads woken
+	 */
+	uint32_t wake_all(wait_queue *wq) {
+		uint64_t flags = irq_save();
+		sync::lock(&wq->lock);
+		thread *list = detach(wq, true);
+		sync::unlock(&wq->lock);
+		uint32_t n = wake_list(list);
+		irq_restore(flags);
+		preempt_check();
+		return n;
+	}
+
+	/**
+	 * @brief Mark @p c done and wake its waiters; safe from interrupt handlers
+	 *
+	 * The flag is set under the queue lock and @p c is not touched after
+	 * it is dropped, so a waiter may free @p c as soon as it returns.
+	 */
+	void complete(completion *c) {
+		uint64_t flags = irq_save();
+		sync::lock(&c->waiters.lock);
+		c->done      = true;
+		thread *list = detach(&c->waiters, true);
+		sync::unlock(&c->waiters.lock);
+		wake_list(list);
+		irq_restore(flags);
+		preempt_check();
+	}
+
+	static bool is_done(void *arg) {
+		return ((completion *) arg)->done;
+	}
+
+	void wait_for(completion *c) {
+		wait(&c->waiters, is_done, c);
+	}
+
+	/**
+	 * @brief Keep the calling thread on this CPU until preempt_enable()
+	 *
+	 * Nests.  Interrupts still arrive; a wakeup they cause takes effect
+	 * at the outermost preempt_enable().  That one is also a quiescent
+	 * state for RCU unless interrupts are off, which rcu::read_unlock()
+	 * relies on.
+	 */
+	void preempt_disable(void) {
+		this_rq()->preempt_count++;
+		__asm__ volatile("" : : : "memory");
+	}
+
+	void preempt_enable(void) {
+		__asm__ volatile("" : : : "memory");
+		if( --this_rq()->preempt_count == 0 ) {
+			if( irq_enabled() )
+				rcu::quiescent();
+			preempt_check();
+		}
+	}
+
+	/**
+	 * @brief Preempt the running thread if an interrupt asked for it
+	 *
+	 * Called by the interrupt dispatcher last, with interrupts off.  The
+	 * interrupted thread resumes here when it is picked again and then
+	 * returns from the interrupt as usual.  Interrupting code that could
+	 * have been preempted is a quiescent state for RCU.
+	 */
+	void irq_exit(void) {
+		run_queue *rq = this_rq();
+		if( !rq->preempt_count )
+			rcu::quiescent();
+		if( !rq->need_resched || rq->preempt_count || !rq->current )
+			return;
+
+		if( !rq->current->idle )
+			rq->stats.preemptions++;
+		schedule();
+	}
+
+	bool get_cpu_stats(uint32_t cpu, cpu_stats *out) {
+		if( cpu >= MAX_CPUS
+		    || !__atomic_load_n(&queues[cpu].idle, __ATOMIC_ACQUIRE) )
+			return false;
+		*out = queues[cpu].stats;
+		return true;
+	}
+
+	static void describe(const thread *t, thread_info *out) {
+		out->id       = t->id;
+		out->cpu      = t->cpu;
+		out->prio     = t->prio;
+		out->st       = t->st;
+		out->switches = t->switches;
+		out->name     = t->name;
+	}
+
+	/**
+	 * @brief Snapshot of up to @p max threads: main, the idle threads,
+	 *        then the spawned ones
+	 * @return Number of entries filled in
+	 */
+	uint32_t list(thread_info *out, uint32_t max) {
+		uint32_t n = 0;
+		if( !running )
+			return 0;
+
+		if( n < max )
+			describe(&main_thread, &out[n++]);
+		for( uint32_t cpu = 0; cpu < MAX_CPUS && n < max; cpu++ ) {
+			if( __atomic_load_n(&queues[cpu].idle, __ATOMIC_ACQUIRE) )
+				describe(&idle_threads[cpu], &out[n++]);
+		}
+
+		uint64_t flags = sync::lock_irqsave(&pool_lock);
+		for( uint32_t i = 0; i < MAX_THREADS && n < max; i++ ) {
+			if( threads[i].in_use )
+				describe(&threads[i], &out[n++]);
+		}
+		sync::unlock_irqrestore(&pool_lock, flags);
+		return n;
+	}
+
+	const char *get_state_name(state st) {
+		switch( st ) {
+			case state::ready:
+				return "ready";
+			case state::running:
+				return "running";
+			case state::blocked:
+				return "blocked";
+			case state::dead:
+				return "dead";
+		}
+		return "?";
+	}
+}  // namespace sched
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+#include <arch/amd64/cpu/instr/fpu.h>
+#include <kern/sync/spinlock.h>
+
+/*
+ * Kernel threads.
+ *
+ * Every CPU runs its own threads from its own run queue: one FIFO per
+ * priority level and a bitmap of the non-empty ones, so picking the next
+ * thread is a bit scan.  Threads never migrate; a thread is started on a
+ * CPU and stays there.  When nothing is ready the CPU runs its idle
+ * thread, which drains deferred work and halts.
+ *
+ * Scheduling is preemptive.  An interrupt that wakes a more important
+ * thread switches to it on the way out (irq_exit()), and threads of the
+ * same level take turns every SLICE_NS while more than one is ready.  A
+ * wakeup aimed at another CPU is delivered with a reschedule IPI.
+ *
+ * Blocking goes through wait queues: wait() sleeps until a condition
+ * holds and wake_one()/wake_all() rerun it.  A completion is a one-shot
+ * flag with a wait queue, safe to complete from an interrupt handler.
+ * Before init(), or with interrupts or preemption off, waiting halts the
+ * CPU in place the way it always did.
+ */
+namespace sched {
+	// Priority levels, 0 the most important
+	constexpr uint8_t PRIORITIES   = 8;
+	constexpr uint8_t PRIO_HIGH    = 0;
+	constexpr uint8_t PRIO_DEFAULT = 4;
+	constexpr uint8_t PRIO_LOW     = PRIORITIES - 1;
+
+	// Threads spawn() can have alive at once
+	constexpr uint32_t MAX_THREADS = 32;
+
+	constexpr size_t   STACK_SIZE = 16384;
+	constexpr uint64_t SLICE_NS   = 10000000ULL;
+
+	// spawn() on the calling CPU
+	constexpr uint32_t THIS_CPU = ~0U;
+
+	using thread_fn = void (*)(void *arg);
+
+	enum class state : uint8_t {
+		ready,    // In its run queue
+		running,  // Current on its CPU
+		blocked,  // In a wait queue, or sleeping on a timer
+		dead      // Exited; its slot is freed by the next thread
+	};
+
+	struct thread {
+		uint64_t    rsp;   // Saved stack pointer while switched out
+		thread     *next;  // Run queue or wait queue link
+		const char *name;
+		thread_fn   fn;
+		void       *arg;
+
+		amd64::fpu::context *fpu;
+
+		uint32_t       id;
+		uint32_t       cpu;
+		uint8_t        prio;
+		volatile state st;
+		bool           idle;
+		bool           in_use;
+
+		uint64_t switches;  // Times it was switched in
+	};
+
+	struct wait_queue {
+		sync::ticket_lock lock;
+		thread           *head;
+		thread           *tail;
+	};
+
+	// A zero-initialized completion is ready to use
+	struct completion {
+		volatile bool done;
+		wait_queue    waiters;
+	};
+
+	// Returns true once the waiter may go on
+	using wait_cond = bool (*)(void *arg);
+
+	struct cpu_stats {
+		uint64_t switches;     // Context switches
+		uint64_t preemptions;  // Of those, forced on the way out of an interrupt
+		uint64_t wakeups;      // Threads made ready on this CPU
+		uint32_t ready;        // Threads waiting to run right now
+	};
+
+	struct thread_info {
+		uint32_t    id;
+		uint32_t    cpu;
+		uint8_t     prio;
+		state       st;
+		uint64_t    switches;
+		const char *name;
+	};
+
+	void              init(void);
+	void              init_cpu(void);
+	[[noreturn]] void idle(void);
+	bool              is_running(void);
+
+	thread *spawn(const char *name,
+	              thread_fn   fn,
+	              void       *arg,
+	              uint8_t     prio = PRIO_DEFAULT,
+	              uint32_t    cpu  = THIS_CPU);
+	thread *current(void);
+	void    yield(void);
+
+	[[noreturn]] void exit(void);
+
+	void     wait(wait_queue *wq, wait_cond done, void *arg);
+	bool     wake_one(wait_queue *wq);
+	uint32_t wake_all(wait_queue *wq);
+
+	void complete(completion *c);
+	void wait_for(completion *c);
+
+	void preempt_disable(void);
+	void preempt_enable(void);
+	void irq_exit(void);
+
+	bool        get_cpu_stats(uint32_t cpu, cpu_stats *out);
+	uint32_t    list(thread_info *out, uint32_t max);
+	const char *get_state_name(state st);
+}  // namespace sched
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "tasks.h"
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/smp/smp.h>
+#include <dbg/logger.h>
+
+#include "sched.h"
+
+namespace sched::tasks {
+	constexpr uint32_t MAX_CPUS = amd64::madt::MAX_CPUS;
+
+	static_assert((DEQUE_SIZE & (DEQUE_SIZE - 1)) == 0,
+	              "DEQUE_SIZE must be a power of two");
+
+	/*
+	 * Chase-Lev deque (in the C11 formulation of Le et al.).  The owner
+	 * is the CPU: push() and pop() run with preemption off, so whichever
+	 * thread is on the CPU is the only one at the bottom end.
+	 */
+	struct alignas(64) deque {
+		int64_t top;  // Thieves take from here
+		alignas(64) int64_t bottom;
+		job      *slots[DEQUE_SIZE];
+		cpu_stats stats;
+	};
+
+	static deque deques[MAX_CPUS];
+
+	static bool     has_worker[MAX_CPUS];
+	static uint32_t width   = MAX_CPUS;  // Only CPUs below this take jobs
+	static uint32_t sharing = 0;         // Workers below width
+
+	// Jobs sitting in deques, and workers asleep waiting for one
+	static int64_t    queued   = 0;
+	static int64_t    sleeping = 0;
+	static wait_queue idle_workers;
+
+	static bool push(deque *d, job *j) {
+		int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+		int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+		if( b - t >= (int64_t) DEQUE_SIZE )
+			return false;
+
+		__atomic_store_n(&d->slots[b & (DEQUE_SIZE - 1)], j, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		__atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+		return true;
+	}
+
+	static job *pop(deque *d) {
+		int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+		__atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int64_t t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+
+		if( t > b ) {
+			__atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+			return nullptr;
+		}
+
+		job *j = __atomic_load_n(&d->slots[b & (DEQUE_SIZE - 1)],
+		                         __ATOMIC_RELAXED);
+		if( t == b ) {
+			// Last one: race the thieves for it
+			if( !__atomic_compare_exchange_n(&d->top,
+			                                 &t,
+			                                 t + 1,
+			                                 false,
+			                                 __ATOMIC_SEQ_CST,
+			                                 __ATOMIC_RELAXED) )
+				j = nullptr;
+			__atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+		}
+		return j;
+	}
+
+	static job *steal(deque *d) {
+		int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+		if( t >= b )
+			return nullptr;
+
+		job *j = __atomic_load_n(&d->slots[t & (DEQUE_SIZE - 1)],
+		                         __ATOMIC_RELAXED);
+		if( !__atomic_compare_exchange_n(
+		        &d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) )
+			return nullptr;
+		return j;
+	}
+
+	static void count_sharing(void) {
+		uint32_t n = 0;
+		for( uint32_t cpu = 0; cpu < width && cpu < MAX_CPUS; cpu++ )
+			n += has_worker[cpu];
+		__atomic_store_n(&sharing, n, __ATOMIC_RELAXED);
+	}
+
+	// Unlocked peek, so a scan of empty deques does no atomic writes
+	static inline bool is_empty(const deque *d) {
+		return __atomic_load_n(&d->bottom, __ATOMIC_RELAXED)
+		    <= __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+	}
+
+	static bool participates(uint32_t cpu) {
+		return cpu < __atomic_load_n(&width, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * @brief Take a job for the calling CPU: its own newest, else the
+	 *        oldest of another CPU, trying each victim once
+	 */
+	static job *take(void) {
+		sched::preempt_disable();
+		uint32_t self = amd64::percpu::id();
+		job     *j    = pop(&deques[self]);
+		if( !j && participates(self) ) {
+			for( uint32_t i = 1; i < MAX_CPUS && !j; i++ ) {
+				uint32_t victim = (self + i) % MAX_CPUS;
+				if( is_empty(&deques[victim]) )
+					continue;
+				j = steal(&deques[victim]);
+				if( j )
+					deques[self].stats.stolen++;
+			}
+		}
+		if( j ) {
+			__atomic_sub_fetch(&queued, 1, __ATOMIC_SEQ_CST);
+			deques[self].stats.executed++;
+		}
+		sched::preempt_enable();
+		return j;
+	}
+
+	static void run(job *j) {
+		latch *done = j->done;
+		j->fn(j->arg);
+		if( done )
+			__atomic_sub_fetch(&done->count, 1, __ATOMIC_RELEASE);
+	}
+
+	static bool has_work(void *arg) {
+		uint32_t cpu = (uint32_t) (uint64_t) arg;
+		return participates(cpu)
+		    && __atomic_load_n(&queued, __ATOMIC_SEQ_CST) > 0;
+	}
+
+	static void worker(void *arg) {
+		for( ;; ) {
+			job *j = take();
+			if( j ) {
+				run(j);
+				continue;
+			}
+
+			__atomic_add_fetch(&sleeping, 1, __ATOMIC_SEQ_CST);
+			sched::wait(&idle_workers, has_work, arg);
+			__atomic_sub_fetch(&sleeping, 1, __ATOMIC_SEQ_CST);
+		}
+	}
+
+	/**
+	 * @brief Start a worker thread on every application processor
+	 *
+	 * Call once the other CPUs are up.
+	 */
+	void init(void) {
+		uint32_t started = 0;
+		for( uint32_t cpu = 1; cpu < MAX_CPUS; cpu++ ) {
+			if( !amd64::smp::is_online(cpu) )
+				continue;
+			void   *arg = (void *) (uint64_t) cpu;
+			thread *t   = spawn("worker", worker, arg, PRIO_DEFAULT, cpu);
+			has_worker[cpu] = t != nullptr;
+			started += has_worker[cpu];
+		}
+		count_sharing();
+		logger::debug::printf("tasks", "info", "%u worker threads\n", started);
+	}
+
+	/**
+	 * @brief Queue @p j on the calling CPU for whichever CPU gets to it
+	 *
+	 * Counts j->done up first.  With no other CPU to share with, or a full
+	 * deque, the job runs right here instead.
+	 */
+	void fork(job *j) {
+		if( j->done )
+			__atomic_add_fetch(&j->done->count, 1, __ATOMIC_RELAXED);
+
+		sched::preempt_disable();
+		bool queued_it = __atomic_load_n(&sharing, __ATOMIC_RELAXED)
+		              && push(&deques[amd64::percpu::id()], j);
+		if( queued_it )
+			__atomic_add_fetch(&queued, 1, __ATOMIC_SEQ_CST);
+		sched::preempt_enable();
+
+		if( !queued_it ) {
+			run(j);
+			return;
+		}
+		if( __atomic_load_n(&sleeping, __ATOMIC_SEQ_CST) > 0 )
+			sched::wake_one(&idle_workers);
+	}
+
+	/**
+	 * @brief Run jobs until every job counted on @p l has finished
+	 *
+	 * Pops the caller's own jobs first, which is usually exactly what it
+	 * forked, then helps the other CPUs.  With nothing left to take, the
+	 * remaining jobs are running elsewhere and it yields until they end.
+	 */
+	void join(latch *l) {
+		while( __atomic_load_n(&l->count, __ATOMIC_ACQUIRE) > 0 ) {
+			job *j = take();
+			if( j ) {
+				run(j);
+				continue;
+			}
+			sched::yield();
+			__asm__ volatile("pause");
+		}
+	}
+
+	struct range_body {
+		range_fn fn;
+		void    *ctx;
+		uint64_t grain;
+	};
+
+	struct range_job {
+		job               j;
+		latch             done;
+		const range_body *body;
+		uint64_t          begin;
+		uint64_t          end;
+	};
+
+	static void split(const range_body *body, uint64_t begin, uint64_t end);
+
+	static void run_range(void *arg) {
+		range_job *r = (range_job *) arg;
+		split(r->body, r->begin, r->end);
+	}
+
+	/**
+	 * @brief Fork the upper half, recurse into the lower one, then join
+	 */
+	static void split(const range_body *body, uint64_t begin, uint64_t end) {
+		if( end - begin <= body->grain ) {
+			body->fn(body->ctx, begin, end);
+			return;
+		}
+
+		uint64_t  mid   = begin + (end - begin) / 2;
+		range_job upper = {};
+		upper.j         = {run_range, &upper, &upper.done};
+		upper.body      = body;
+		upper.begin     = mid;
+		upper.end       = end;
+
+		fork(&upper.j);
+		split(body, begin, mid);
+		join(&upper.done);
+	}
+
+	void for_range(
+	    uint64_t begin, uint64_t end, uint64_t grain, range_fn fn, void *ctx) {
+		if( begin >= end )
+			return;
+
+		// Nobody to share with: one call, no splitting
+		if( get_width() <= 1 ) {
+			fn(ctx, begin, end);
+			return;
+		}
+
+		range_body body = {fn, ctx, grain ? grain : 1};
+		split(&body, begin, end);
+	}
+
+	/**
+	 * @brief Number of CPUs that take jobs: the boot CPU, which has no
+	 *        worker but joins in from whatever thread forks there, and
+	 *        the workers below the width limit
+	 */
+	uint32_t get_width(void) {
+		return 1 + __atomic_load_n(&sharing, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * @brief Let only CPUs 0 to @p cpus - 1 take jobs (for benchmarks)
+	 *
+	 * Workers past the limit finish the job in hand and go to sleep.
+	 * 0 lifts the limit.
+	 */
+	void set_width(uint32_t cpus) {
+		__atomic_store_n(&width, cpus ? cpus : MAX_CPUS, __ATOMIC_RELAXED);
+		count_sharing();
+		sched::wake_all(&idle_workers);
+	}
+
+	bool get_cpu_stats(uint32_t cpu, cpu_stats *out) {
+		if( cpu >= MAX_CPUS )
+			return false;
+		*out = deques[cpu].stats;
+		return true;
+	}
+}  // namespace sched::tasks
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Fork-join jobs spread over the CPUs by work stealing.
+ *
+ * Every CPU has a Chase-Lev deque of jobs.  fork() pushes onto the
+ * calling CPU's deque, where the forking code pops its jobs back newest
+ * first; idle CPUs steal the oldest (and, with recursive splitting, the
+ * largest) from the other end.  Each application processor has a worker
+ * thread that steals while there is anything to take and sleeps
+ * otherwise.  A thread waiting in join() runs jobs too, so the caller's
+ * CPU is never idle while its jobs are pending.
+ *
+ * Jobs and latches live in the forking code's frame; join() is what
+ * keeps them alive until every job has run.
+ */
+namespace sched::tasks {
+	// Jobs one deque holds; fork() runs a job inline when its deque is full
+	constexpr uint32_t DEQUE_SIZE = 256;
+
+	using job_fn = void (*)(void *arg);
+
+	// Pending jobs; zero-initialized means none
+	struct latch {
+		int64_t count;
+	};
+
+	struct job {
+		job_fn fn;
+		void  *arg;
+		latch *done;  // Counted down once fn returns; may be nullptr
+	};
+
+	struct cpu_stats {
+		uint64_t executed;  // Jobs run on this CPU
+		uint64_t stolen;    // Of those, taken from another CPU's deque
+	};
+
+	void init(void);
+	void fork(job *j);
+	void join(latch *l);
+
+	using range_fn = void (*)(void *ctx, uint64_t begin, uint64_t end);
+
+	void for_range(
+	    uint64_t begin, uint64_t end, uint64_t grain, range_fn fn, void *ctx);
+
+	/**
+	 * @brief Call fn(lo, hi) over [begin, end) in pieces run in parallel
+	 *
+	 * The range is split in halves until a piece is at most @p grain
+	 * long; the pieces cover the range exactly once, in no set order.
+	 * Returns once all of them have run.
+	 */
+	template <typename F>
+	inline void
+	    parallel_for(uint64_t begin, uint64_t end, uint64_t grain, const F &fn) {
+		range_fn call = [](void *ctx, uint64_t lo, uint64_t hi) {
+			(*(const F *) ctx)(lo, hi);
+		};
+		for_range(begin, end, grain, call, (void *) &fn);
+	}
+
+	uint32_t get_width(void);
+	void     set_width(uint32_t cpus);
+	bool     get_cpu_stats(uint32_t cpu, cpu_stats *out);
+}  // namespace sched::tasks
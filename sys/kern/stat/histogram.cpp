@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "histogram.h"
+
+namespace kstat::hist {
+	/**
+	 * @brief Add the counts of @p h to @p out
+	 */
+	void merge(summary *out, const counts *h) {
+		out->count += h->count;
+		out->cycles += h->cycles;
+		if( h->max_cycles > out->max_cycles )
+			out->max_cycles = h->max_cycles;
+		for( uint32_t b = 0; b < BUCKETS; b++ )
+			out->hist[b] += h->hist[b];
+	}
+
+	/**
+	 * @brief Duration below which @p pct percent of the samples fall
+	 *
+	 * Resolved to the upper edge of a log2 bucket (never above the
+	 * maximum seen), so it overestimates by less than a factor of two.
+	 */
+	uint64_t percentile(const summary *s, uint32_t pct) {
+		if( s->count == 0 )
+			return 0;
+
+		uint64_t target = (s->count * pct + 99) / 100;
+		uint64_t seen   = 0;
+		for( uint32_t b = 0; b < BUCKETS; b++ ) {
+			seen += s->hist[b];
+			if( seen >= target ) {
+				uint64_t edge = (2ULL << b) - 1;
+				return edge < s->max_cycles ? edge : s->max_cycles;
+			}
+		}
+		return s->max_cycles;
+	}
+}  // namespace kstat::hist
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Log2 histograms of durations in TSC cycles.
+ *
+ * Bucket b counts durations in [2^b, 2^(b+1)) cycles and the last bucket
+ * is open, so recording is a bit scan and three adds.  A histogram has a
+ * single writer: the owner keeps one per CPU and records with interrupts
+ * off.  Readers add the histograms up into a summary, which is also what
+ * percentiles are taken from.
+ */
+namespace kstat::hist {
+	constexpr uint32_t BUCKETS = 32;
+
+	struct counts {
+		uint64_t count;
+		uint64_t cycles;  // Total of all durations
+		uint64_t max_cycles;
+		uint32_t hist[BUCKETS];
+	};
+
+	// Several histograms added up
+	struct summary {
+		uint64_t count;
+		uint64_t cycles;
+		uint64_t max_cycles;
+		uint64_t hist[BUCKETS];
+	};
+
+	inline uint32_t bucket_of(uint64_t cycles) {
+		uint32_t b = 63 - (uint32_t) __builtin_clzll(cycles | 1);
+		return b < BUCKETS ? b : BUCKETS - 1;
+	}
+
+	inline void add(counts *h, uint64_t cycles) {
+		h->count++;
+		h->cycles += cycles;
+		if( cycles > h->max_cycles )
+			h->max_cycles = cycles;
+		h->hist[bucket_of(cycles)]++;
+	}
+
+	void     merge(summary *out, const counts *h);
+	uint64_t percentile(const summary *s, uint32_t pct);
+}  // namespace kstat::hist
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "kstat.h"
+
+#include <arch/amd64/apic/madt.h>
+
+namespace kstat {
+	constexpr uint32_t MAX_CPUS = amd64::madt::MAX_CPUS;
+
+	namespace detail {
+		// Row n belongs to CPU n; a row is a whole number of cache lines
+		alignas(64) int64_t slots[MAX_CPUS][MAX_STATS];
+	}  // namespace detail
+
+	using detail::slots;
+
+	/**
+	 * @brief Sum of @p s over every CPU
+	 *
+	 * Each slot is read once on its own, so a value that moves meanwhile
+	 * may be off by what moved during the read.
+	 */
+	int64_t read(const stat *s) {
+		uint32_t i = detail::index(s);
+		if( i >= MAX_STATS )
+			return 0;
+
+		int64_t sum = 0;
+		for( uint32_t cpu = 0; cpu < MAX_CPUS; cpu++ )
+			sum += __atomic_load_n(&slots[cpu][i], __ATOMIC_RELAXED);
+		return sum;
+	}
+
+	/**
+	 * @brief Zero @p s on every CPU
+	 *
+	 * Meant for counters.  An add() on another CPU racing with it may be
+	 * lost; a gauge cleared while in use is wrong from then on.
+	 */
+	void clear(const stat *s) {
+		uint32_t i = detail::index(s);
+		if( i >= MAX_STATS )
+			return;
+
+		for( uint32_t cpu = 0; cpu < MAX_CPUS; cpu++ )
+			__atomic_store_n(&slots[cpu][i], 0, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * @brief Number of statistics with a slot
+	 *
+	 * Declarations past MAX_STATS are left out and count nothing.
+	 */
+	uint32_t count(void) {
+		uint32_t n = (uint32_t) (detail::__kstat_end - detail::__kstat_start);
+		return n < MAX_STATS ? n : MAX_STATS;
+	}
+
+	/**
+	 * @brief Copy up to @p max statistics and their sums into @p out
+	 * @return Number of entries filled in, in link order
+	 */
+	uint32_t collect(entry *out, uint32_t max) {
+		uint32_t n = count();
+		if( n > max )
+			n = max;
+
+		for( uint32_t i = 0; i < n; i++ ) {
+			const stat *s = &detail::__kstat_start[i];
+			out[i].name   = s->name;
+			out[i].type   = s->type;
+			out[i].value  = read(s);
+		}
+		return n;
+	}
+
+	const char *get_kind_name(kind type) {
+		switch( type ) {
+			case kind::counter:
+				return "counter";
+			case kind::gauge:
+				return "gauge";
+		}
+		return "unknown";
+	}
+}  // namespace kstat
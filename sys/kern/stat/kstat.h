@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#include <arch/amd64/cpu/percpu.h>
+
+/*
+ * Kernel statistics.
+ *
+ * A subsystem declares each statistic once with KSTAT_COUNTER() or
+ * KSTAT_GAUGE().  The declarations are gathered in the .kstat section by
+ * the linker, so every statistic is listed from boot on and its position
+ * there is its slot number.  Every CPU has a row of slots of its own and
+ * only ever adds to its own row, with one instruction that an interrupt
+ * cannot split, so counting needs no lock, no atomic and no shared cache
+ * line.  Reading sums the rows.
+ *
+ * A counter only goes up.  A gauge goes up and down, possibly on
+ * different CPUs, so single rows may go negative; only the sum means
+ * anything.  A gauge that starts at some total gets it with add() during
+ * init.
+ *
+ * Names are dotted, subsystem first ("memory.pages.free").
+ */
+namespace kstat {
+	// Slots per CPU; the .kstat section must not hold more statistics
+	constexpr uint32_t MAX_STATS = 256;
+
+	enum class kind : uint8_t {
+		counter,
+		gauge
+	};
+
+	struct alignas(16) stat {
+		const char *name;
+		kind        type;
+	};
+
+	// One statistic summed over the CPUs
+	struct entry {
+		const char *name;
+		kind        type;
+		int64_t     value;
+	};
+
+	namespace detail {
+		// Bounds of the .kstat section, from the linker script
+		extern "C" const stat __kstat_start[];
+		extern "C" const stat __kstat_end[];
+
+		extern int64_t slots[][MAX_STATS];
+
+		inline uint32_t index(const stat *s) {
+			return (uint32_t) (s - __kstat_start);
+		}
+	}  // namespace detail
+
+	/**
+	 * @brief Add @p n to the calling CPU's slot of @p s
+	 *
+	 * Safe from any context, interrupt handlers included.
+	 */
+	inline void add(const stat *s, int64_t n) {
+		uint32_t i = detail::index(s);
+		if( i >= MAX_STATS ) [[unlikely]]
+			return;
+
+		int64_t *slot = &detail::slots[amd64::percpu::id()][i];
+		__asm__ volatile("addq %1, %0" : "+m"(*slot) : "er"(n));
+	}
+
+	inline void inc(const stat *s) {
+		add(s, 1);
+	}
+
+	inline void dec(const stat *s) {
+		add(s, -1);
+	}
+
+	int64_t     read(const stat *s);
+	void        clear(const stat *s);
+	uint32_t    count(void);
+	uint32_t    collect(entry *out, uint32_t max);
+	const char *get_kind_name(kind type);
+}  // namespace kstat
+
+#define KSTAT_DECLARE(var, stat_name, stat_kind)                 \
+	[[gnu::section(".kstat"), gnu::used]] static constinit const \
+	    kstat::stat var = {stat_name, stat_kind}
+
+// Declare a statistic with static storage; count with kstat::inc(&var)
+#define KSTAT_COUNTER(var, stat_name) \
+	KSTAT_DECLARE(var, stat_name, kstat::kind::counter)
+#define KSTAT_GAUGE(var, stat_name) KSTAT_DECLARE(var, stat_name, kstat::kind::gauge)
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "rcu.h"
+
+#include <kbitmap.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/stat/kstat.h>
+#include <kern/sync/spinlock.h>
+#include <kern/work/work.h>
+
+namespace rcu {
+	namespace percpu = amd64::percpu;
+
+	constexpr uint32_t MAX_CPUS = amd64::madt::MAX_CPUS;
+
+	// Callbacks in the order they were queued
+	struct batch {
+		head *first;
+		head *last;
+	};
+
+	struct alignas(64) cpu_state {
+		uint64_t seen;  // Last grace period this CPU reported for
+	};
+
+	static cpu_state cpus[MAX_CPUS];
+
+	/*
+	 * gp_seq numbers the current grace period, or the last one while none
+	 * is in progress.  pending holds the CPUs that still owe it a
+	 * quiescent state and online the CPUs that called init_cpu().
+	 */
+	static uint64_t gp_seq  = 0;
+	static uint64_t pending = 0;
+	static uint64_t online  = 0;
+
+	static sync::lock_stats  cb_stats("rcu.callbacks");
+	static sync::ticket_lock cb_lock(&cb_stats);  // Taken with interrupts off
+	static batch             next_batch;          // Queued during this grace period
+	static batch             waiting;             // Waiting for this grace period
+	static batch             done;                // Ready to run
+	static bool              in_progress = false;
+
+	KSTAT_COUNTER(completed, "rcu.grace_periods");
+	KSTAT_COUNTER(queued, "rcu.callbacks.queued");
+	KSTAT_COUNTER(invoked, "rcu.callbacks.invoked");
+
+	static void       reclaim(void *arg);
+	static work::item reclaim_work = {nullptr, reclaim, nullptr, false};
+
+	static void append(batch *to, batch *from) {
+		if( !from->first )
+			return;
+		if( to->last )
+			to->last->next = from->first;
+		else
+			to->first = from->first;
+		to->last    = from->last;
+		from->first = nullptr;
+		from->last  = nullptr;
+	}
+
+	/**
+	 * @brief Hand the callbacks of the current grace period to reclaim()
+	 *
+	 * Call with cb_lock held.
+	 */
+	static void finish_gp(void) {
+		append(&done, &waiting);
+		in_progress = false;
+		kstat::inc(&completed);
+		work::queue(&reclaim_work);
+	}
+
+	/**
+	 * @brief Start a grace period for the callbacks in next_batch
+	 *
+	 * Call with cb_lock held and none in progress.  pending is filled in
+	 * before the new number is published, so a CPU that sees the number
+	 * also sees its bit.
+	 */
+	static void start_gp(void) {
+		append(&waiting, &next_batch);
+		in_progress = true;
+
+		uint64_t cpus_mask = __atomic_load_n(&online, __ATOMIC_ACQUIRE);
+		if( !cpus_mask ) {
+			// No CPU has started reading yet
+			finish_gp();
+			return;
+		}
+
+		__atomic_store_n(&pending, cpus_mask, __ATOMIC_RELAXED);
+		__atomic_store_n(&gp_seq, gp_seq + 1, __ATOMIC_RELEASE);
+		for( uint32_t cpu = 0; cpu < MAX_CPUS; cpu++ ) {
+			if( cpus_mask & (1ULL << cpu) )
+				amd64::smp::kick(cpu);
+		}
+	}
+
+	/**
+	 * @brief Run the callbacks whose grace period has ended, oldest first
+	 */
+	static void reclaim(void *arg) {
+		(void) arg;
+
+		uint64_t flags = sync::lock_irqsave(&cb_lock);
+		head    *h     = done.first;
+		done.first     = nullptr;
+		done.last      = nullptr;
+		sync::unlock_irqrestore(&cb_lock, flags);
+
+		uint64_t n = 0;
+		while( h ) {
+			head *next = h->next;  // The callback may free h
+			h->fn(h->arg);
+			h = next;
+			n++;
+		}
+		kstat::add(&invoked, (int64_t) n);
+	}
+
+	/**
+	 * @brief Take part in grace periods from now on
+	 *
+	 * Called by sched::init() and sched::init_cpu() before the CPU reads
+	 * anything published with assign_pointer().
+	 */
+	void init_cpu(void) {
+		uint32_t cpu   = percpu::id();
+		cpus[cpu].seen = __atomic_load_n(&gp_seq, __ATOMIC_ACQUIRE);
+		__atomic_fetch_or(&online, 1ULL << cpu, __ATOMIC_ACQ_REL);
+	}
+
+	/**
+	 * @brief Report that the calling CPU holds no references right now
+	 *
+	 * Cheap when there is nothing to report: one load and a compare.
+	 * The CPU that reports last ends the grace period.
+	 */
+	void quiescent(void) {
+		cpu_state *me = &cpus[percpu::id()];
+		if( me->seen == __atomic_load_n(&gp_seq, __ATOMIC_ACQUIRE) )
+			return;
+
+		// With interrupts off so that an interrupt exit cannot report in between
+		uint64_t flags = irq_save();
+		uint64_t gp    = __atomic_load_n(&gp_seq, __ATOMIC_ACQUIRE);
+		if( me->seen != gp ) {
+			me->seen     = gp;
+			uint64_t bit = 1ULL << percpu::id();
+			uint64_t old =
+			    __atomic_fetch_and(&pending, ~bit, __ATOMIC_ACQ_REL);
+			if( old == bit ) {
+				sync::lock(&cb_lock);
+				finish_gp();
+				if( next_batch.first )
+					start_gp();
+				sync::unlock(&cb_lock);
+			}
+		}
+		irq_restore(flags);
+	}
+
+	/**
+	 * @brief Run fn(arg) once every reader that may see the old version
+	 *        is done with it
+	 *
+	 * Safe from interrupt handlers and read-side sections.  @p h must stay
+	 * alive until the callback runs; the callback may free it.
+	 */
+	void call(head *h, callback fn, void *arg) {
+		h->next = nullptr;
+		h->fn   = fn;
+		h->arg  = arg;
+
+		uint64_t flags = sync::lock_irqsave(&cb_lock);
+		batch    one   = {h, h};
+		append(&next_batch, &one);
+		kstat::inc(&queued);
+		if( !in_progress )
+			start_gp();
+		sync::unlock_irqrestore(&cb_lock, flags);
+	}
+
+	static void wake_waiter(void *arg) {
+		sched::complete((sched::completion *) arg);
+	}
+
+	/**
+	 * @brief Wait for a full grace period
+	 *
+	 * Sleeps, so never call it from a read-side section or with
+	 * interrupts off.
+	 */
+	void synchronize(void) {
+		sched::completion c = {};
+		head              h;
+		call(&h, wake_waiter, &c);
+		sched::wait_for(&c);
+	}
+
+	void get_stats(stats *out) {
+		uint64_t cpus_mask = __atomic_load_n(&online, __ATOMIC_ACQUIRE);
+		out->grace_periods = (uint64_t) kstat::read(&completed);
+		out->queued        = (uint64_t) kstat::read(&queued);
+		out->invoked       = (uint64_t) kstat::read(&invoked);
+		out->cpus          = (uint32_t) kbitmap::popcount(&cpus_mask, 0, 64);
+	}
+}  // namespace rcu
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#include <kern/sched/sched.h>
+
+/*
+ * Read-copy-update for read-mostly data.
+ *
+ * Readers take no lock and write no shared memory: rcu::read_lock() only
+ * disables preemption on the calling CPU.  A writer builds the new
+ * version, publishes it with assign_pointer() and hands the old one to
+ * call(), which runs the callback once every CPU has passed through a
+ * quiescent state, a point where it cannot still hold a reference from
+ * before.  Those are context switches, the idle loop, interrupt exits and
+ * the outermost preempt_enable() with interrupts on, so the read side
+ * costs a preempt count increment and decrement and nothing else.
+ *
+ * A section with interrupts off is a read-side section too, so interrupt
+ * handlers may use dereference() without read_lock().  Readers must not
+ * sleep.  Callbacks run as deferred work on whichever CPU ends the grace
+ * period, with preemption off; they must not sleep either.
+ *
+ * Grace periods are driven by the CPUs that run into quiescent states on
+ * their own; the start of one kicks every CPU so that halted ones answer
+ * without waiting for their next interrupt.
+ */
+namespace rcu {
+	using callback = void (*)(void *arg);
+
+	/**
+	 * A pending callback, owned by the caller and usually embedded in the
+	 * object being retired.  It must stay alive until the callback runs.
+	 */
+	struct head {
+		head    *next;
+		callback fn;
+		void    *arg;
+	};
+
+	struct stats {
+		uint64_t grace_periods;  // Completed so far
+		uint64_t queued;         // Callbacks passed to call()
+		uint64_t invoked;        // Of those, run
+		uint32_t cpus;           // CPUs taking part
+	};
+
+	inline void read_lock(void) {
+		sched::preempt_disable();
+	}
+
+	inline void read_unlock(void) {
+		sched::preempt_enable();
+	}
+
+	/**
+	 * @brief Publish @p v at @p p; everything written to it before is
+	 *        visible to readers that see the new pointer
+	 */
+	template <typename T>
+	inline void assign_pointer(T **p, T *v) {
+		__atomic_store_n(p, v, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Load a pointer published with assign_pointer(), once
+	 */
+	template <typename T>
+	inline T *dereference(T *const *p) {
+		return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+	}
+
+	void init_cpu(void);
+	void quiescent(void);
+
+	void call(head *h, callback fn, void *arg);
+	void synchronize(void);
+	void get_stats(stats *out);
+}  // namespace rcu
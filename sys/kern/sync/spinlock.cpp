@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "spinlock.h"
+
+#include <ktime.h>
+
+namespace sync {
+	// Every record used so far, newest first
+	static lock_stats *registry = nullptr;
+
+	// now_ns() and TSC at the last reset
+	static uint64_t reset_ns  = 0;
+	static uint64_t reset_tsc = 0;
+
+	static inline uint64_t load(const uint64_t *counter) {
+		return __atomic_load_n(counter, __ATOMIC_RELAXED);
+	}
+
+	static inline void add(uint64_t *counter, uint64_t n) {
+		__atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+	}
+
+	static void enlist(lock_stats *s) {
+		if( __atomic_exchange_n(&s->listed, true, __ATOMIC_ACQ_REL) )
+			return;
+
+		lock_stats *head = __atomic_load_n(&registry, __ATOMIC_RELAXED);
+		do
+			s->next = head;
+		while( !__atomic_compare_exchange_n(
+		    &registry, &head, s, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED) );
+	}
+
+	namespace detail {
+		/*
+		 * Counters are updated with relaxed atomics: a record may be
+		 * shared by locks held on several CPUs at once.
+		 */
+		void note_acquire(lock_stats *s, uint64_t spins, uint64_t wait_cycles) {
+			if( !s->listed )
+				enlist(s);
+
+			add(&s->acquisitions, 1);
+			if( spins ) {
+				add(&s->contended, 1);
+				add(&s->spins, spins);
+				add(&s->wait_cycles, wait_cycles);
+			}
+		}
+
+		void note_release(lock_stats *s, uint64_t held_cycles) {
+			add(&s->holds, 1);
+			add(&s->hold_cycles, held_cycles);
+
+			uint64_t max = load(&s->max_hold_cycles);
+			while( held_cycles > max
+			       && !__atomic_compare_exchange_n(&s->max_hold_cycles,
+			                                       &max,
+			                                       held_cycles,
+			                                       true,
+			                                       __ATOMIC_RELAXED,
+			                                       __ATOMIC_RELAXED) )
+				;
+		}
+	}  // namespace detail
+
+	/**
+	 * @brief Copy up to @p max records into @p out
+	 *
+	 * Each counter is read on its own, so a record that is in use may be
+	 * off by the acquisitions that happened during the copy.
+	 *
+	 * @return Number of records copied
+	 */
+	uint32_t collect(lock_stats *out, uint32_t max) {
+		uint32_t    n = 0;
+		lock_stats *s = __atomic_load_n(&registry, __ATOMIC_ACQUIRE);
+		for( ; s && n < max; s = s->next ) {
+			lock_stats *o      = &out[n++];
+			o->name            = s->name;
+			o->acquisitions    = load(&s->acquisitions);
+			o->contended       = load(&s->contended);
+			o->spins           = load(&s->spins);
+			o->wait_cycles     = load(&s->wait_cycles);
+			o->holds           = load(&s->holds);
+			o->hold_cycles     = load(&s->hold_cycles);
+			o->max_hold_cycles = load(&s->max_hold_cycles);
+			o->next            = nullptr;
+			o->listed          = true;
+		}
+		return n;
+	}
+
+	/**
+	 * @brief Zero every record and restart the rate window
+	 *
+	 * Records stay listed.  A lock released across the reset adds the
+	 * part of its hold time before it.
+	 */
+	void reset(void) {
+		lock_stats *s = __atomic_load_n(&registry, __ATOMIC_ACQUIRE);
+		for( ; s; s = s->next ) {
+			__atomic_store_n(&s->acquisitions, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->contended, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->spins, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->wait_cycles, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->holds, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->hold_cycles, 0, __ATOMIC_RELAXED);
+			__atomic_store_n(&s->max_hold_cycles, 0, __ATOMIC_RELAXED);
+		}
+		reset_ns  = time::now_ns();
+		reset_tsc = rdtsc_ordered();
+	}
+
+	/**
+	 * @brief Nanoseconds and TSC cycles elapsed since the last reset
+	 */
+	void since_reset(uint64_t *ns, uint64_t *tsc) {
+		*tsc = rdtsc_ordered() - reset_tsc;
+		*ns  = time::now_ns() - reset_ns;
+	}
+}  // namespace sync
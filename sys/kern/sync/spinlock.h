@@ -0,0 +1,396 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/asm/msr.h>
+
+#ifndef LOCK_STATS
+#	define LOCK_STATS 0  // Count acquisitions, contention and hold time per lock
+#endif
+
+/*
+ * Spinlocks.
+ *
+ * ticket_lock is the one to reach for: FIFO, and small enough to embed
+ * anywhere.  mcs_lock queues each waiter on a node it brings along, so
+ * every waiter spins on its own cache line; it pays off where many CPUs
+ * pile onto one lock.  rwlock lets readers in together and holds new
+ * readers back once a writer is waiting.  seqlock never makes readers
+ * wait for each other or write shared memory: they copy the data and
+ * retry if a writer ran meanwhile, which suits small records that are
+ * read far more often than written.
+ *
+ * Taking a lock does not disable anything.  A lock that an interrupt
+ * handler also takes, or that a preemptible thread holds, is taken with
+ * the *_irqsave() variants; with interrupts off the holder cannot be
+ * preempted either, since preemption only happens on the way out of an
+ * interrupt.  Locks do not nest into themselves, readers included.
+ *
+ * With LOCK_STATS, a lock constructed with a lock_stats record counts
+ * its acquisitions, how many had to wait, the wait loop iterations and
+ * cycles, and the cycles it was held (exclusive holders only).  Several
+ * locks may share a record; the per-CPU run queues do.  A record lists
+ * itself on first use and must have static storage.
+ */
+namespace sync {
+	struct lock_stats {
+		const char *name;
+		uint64_t    acquisitions    = 0;
+		uint64_t    contended       = 0;  // Acquisitions that had to wait
+		uint64_t    spins           = 0;  // Wait loop iterations
+		uint64_t    wait_cycles     = 0;
+		uint64_t    holds           = 0;  // Exclusive releases, timed below
+		uint64_t    hold_cycles     = 0;
+		uint64_t    max_hold_cycles = 0;
+
+		lock_stats   *next   = nullptr;  // Registry link
+		volatile bool listed = false;
+
+		constexpr explicit lock_stats(const char *lock_name = nullptr)
+		    : name(lock_name) {}
+	};
+
+	namespace detail {
+		// One acquisition in progress
+		struct waiter {
+			uint64_t spins;
+			uint64_t since;  // TSC at the first spin
+		};
+
+		void note_acquire(lock_stats *s, uint64_t spins, uint64_t wait_cycles);
+		void note_release(lock_stats *s, uint64_t held_cycles);
+
+		inline uint64_t clock(const lock_stats *s) {
+			if constexpr( LOCK_STATS )
+				return s ? rdtsc_ordered() : 0;
+			return 0;
+		}
+
+		/**
+		 * @brief One pass of a wait loop; the first notes when waiting began
+		 */
+		inline void spin(const lock_stats *s, waiter *w) {
+			if( w->spins++ == 0 )
+				w->since = clock(s);
+			__asm__ volatile("pause" : : : "memory");
+		}
+
+		/**
+		 * @brief Account an acquisition and start its hold time in @p held
+		 */
+		inline void acquired(lock_stats *s, const waiter *w, uint64_t *held) {
+			if constexpr( LOCK_STATS ) {
+				if( !s )
+					return;
+				uint64_t now = rdtsc_ordered();
+				note_acquire(s, w->spins, w->spins ? now - w->since : 0);
+				if( held )
+					*held = now;
+			}
+		}
+
+		inline void released(lock_stats *s, uint64_t held) {
+			if constexpr( LOCK_STATS ) {
+				if( s )
+					note_release(s, rdtsc_ordered() - held);
+			}
+		}
+	}  // namespace detail
+
+	uint32_t collect(lock_stats *out, uint32_t max);
+	void     reset(void);
+	void     since_reset(uint64_t *ns, uint64_t *tsc);
+
+	/*
+	 * Ticket lock
+	 */
+
+	struct ticket_lock {
+		volatile uint32_t next  = 0;  // Ticket handed to the next arrival
+		volatile uint32_t owner = 0;  // Ticket being served
+		lock_stats       *stats = nullptr;
+		uint64_t          held  = 0;  // TSC when taken, with LOCK_STATS
+
+		constexpr ticket_lock() = default;
+		constexpr explicit ticket_lock(lock_stats *s)
+		    : stats(s) {}
+	};
+
+	inline void lock(ticket_lock *l) {
+		detail::waiter w = {};
+
+		uint32_t t = __atomic_fetch_add(&l->next, 1, __ATOMIC_RELAXED);
+		while( __atomic_load_n(&l->owner, __ATOMIC_ACQUIRE) != t )
+			detail::spin(l->stats, &w);
+		detail::acquired(l->stats, &w, &l->held);
+	}
+
+	inline bool try_lock(ticket_lock *l) {
+		detail::waiter w = {};
+
+		uint32_t t = __atomic_load_n(&l->owner, __ATOMIC_ACQUIRE);
+		if( !__atomic_compare_exchange_n(
+		        &l->next, &t, t + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) )
+			return false;
+		detail::acquired(l->stats, &w, &l->held);
+		return true;
+	}
+
+	inline void unlock(ticket_lock *l) {
+		detail::released(l->stats, l->held);
+		__atomic_store_n(&l->owner, l->owner + 1, __ATOMIC_RELEASE);
+	}
+
+	inline bool is_locked(const ticket_lock *l) {
+		return __atomic_load_n(&l->owner, __ATOMIC_RELAXED)
+		    != __atomic_load_n(&l->next, __ATOMIC_RELAXED);
+	}
+
+	inline uint64_t lock_irqsave(ticket_lock *l) {
+		uint64_t flags = irq_save();
+		lock(l);
+		return flags;
+	}
+
+	inline void unlock_irqrestore(ticket_lock *l, uint64_t flags) {
+		unlock(l);
+		irq_restore(flags);
+	}
+
+	/*
+	 * MCS queued lock.  Each acquisition brings a node, usually on the
+	 * stack, that stays in use until the matching unlock().
+	 */
+
+	struct mcs_node {
+		mcs_node *volatile next;
+		volatile bool      locked;
+	};
+
+	struct mcs_lock {
+		mcs_node *volatile tail  = nullptr;
+		lock_stats        *stats = nullptr;
+		uint64_t           held  = 0;
+
+		constexpr mcs_lock() = default;
+		constexpr explicit mcs_lock(lock_stats *s)
+		    : stats(s) {}
+	};
+
+	inline void lock(mcs_lock *l, mcs_node *n) {
+		detail::waiter w = {};
+
+		n->next   = nullptr;
+		n->locked = true;
+
+		mcs_node *prev = __atomic_exchange_n(&l->tail, n, __ATOMIC_ACQ_REL);
+		if( prev ) {
+			__atomic_store_n(&prev->next, n, __ATOMIC_RELEASE);
+			while( __atomic_load_n(&n->locked, __ATOMIC_ACQUIRE) )
+				detail::spin(l->stats, &w);
+		}
+		detail::acquired(l->stats, &w, &l->held);
+	}
+
+	inline bool try_lock(mcs_lock *l, mcs_node *n) {
+		detail::waiter w = {};
+
+		n->next   = nullptr;
+		n->locked = false;
+
+		mcs_node *expected = nullptr;
+		if( !__atomic_compare_exchange_n(&l->tail,
+		                                 &expected,
+		                                 n,
+		                                 false,
+		                                 __ATOMIC_ACQUIRE,
+		                                 __ATOMIC_RELAXED) )
+			return false;
+		detail::acquired(l->stats, &w, &l->held);
+		return true;
+	}
+
+	inline void unlock(mcs_lock *l, mcs_node *n) {
+		detail::released(l->stats, l->held);
+
+		mcs_node *next = __atomic_load_n(&n->next, __ATOMIC_ACQUIRE);
+		if( !next ) {
+			mcs_node *expected = n;
+			if( __atomic_compare_exchange_n(&l->tail,
+			                                &expected,
+			                                nullptr,
+			                                false,
+			                                __ATOMIC_RELEASE,
+			                                __ATOMIC_RELAXED) )
+				return;
+
+			// A waiter swapped itself in and is about to link up
+			while( !(next = __atomic_load_n(&n->next, __ATOMIC_ACQUIRE)) )
+				__asm__ volatile("pause");
+		}
+		__atomic_store_n(&next->locked, false, __ATOMIC_RELEASE);
+	}
+
+	inline uint64_t lock_irqsave(mcs_lock *l, mcs_node *n) {
+		uint64_t flags = irq_save();
+		lock(l, n);
+		return flags;
+	}
+
+	inline void unlock_irqrestore(mcs_lock *l, mcs_node *n, uint64_t flags) {
+		unlock(l, n);
+		irq_restore(flags);
+	}
+
+	/*
+	 * Reader-writer lock.  A writer claims the lock first, which keeps
+	 * new readers out, then waits for the readers inside to leave.
+	 */
+
+	constexpr uint32_t RW_WRITER = 1U << 31;
+
+	struct rwlock {
+		volatile uint32_t value = 0;  // RW_WRITER, plus the number of readers
+		lock_stats       *stats = nullptr;
+		uint64_t          held  = 0;  // Writer hold time only
+
+		constexpr rwlock() = default;
+		constexpr explicit rwlock(lock_stats *s)
+		    : stats(s) {}
+	};
+
+	inline void read_lock(rwlock *l) {
+		detail::waiter w = {};
+
+		for( ;; ) {
+			uint32_t v = __atomic_load_n(&l->value, __ATOMIC_RELAXED);
+			if( v & RW_WRITER ) {
+				detail::spin(l->stats, &w);
+				continue;
+			}
+			if( __atomic_compare_exchange_n(&l->value,
+			                                &v,
+			                                v + 1,
+			                                true,
+			                                __ATOMIC_ACQUIRE,
+			                                __ATOMIC_RELAXED) )
+				break;
+		}
+		detail::acquired(l->stats, &w, nullptr);
+	}
+
+	inline void read_unlock(rwlock *l) {
+		__atomic_fetch_sub(&l->value, 1, __ATOMIC_RELEASE);
+	}
+
+	inline void write_lock(rwlock *l) {
+		detail::waiter w = {};
+
+		for( ;; ) {
+			uint32_t v =
+			    __atomic_fetch_or(&l->value, RW_WRITER, __ATOMIC_ACQUIRE);
+			if( !(v & RW_WRITER) )
+				break;
+			while( __atomic_load_n(&l->value, __ATOMIC_RELAXED) & RW_WRITER )
+				detail::spin(l->stats, &w);
+		}
+		while( __atomic_load_n(&l->value, __ATOMIC_ACQUIRE) != RW_WRITER )
+			detail::spin(l->stats, &w);
+		detail::acquired(l->stats, &w, &l->held);
+	}
+
+	inline void write_unlock(rwlock *l) {
+		detail::released(l->stats, l->held);
+		__atomic_store_n(&l->value, 0, __ATOMIC_RELEASE);
+	}
+
+	inline uint64_t read_lock_irqsave(rwlock *l) {
+		uint64_t flags = irq_save();
+		read_lock(l);
+		return flags;
+	}
+
+	inline void read_unlock_irqrestore(rwlock *l, uint64_t flags) {
+		read_unlock(l);
+		irq_restore(flags);
+	}
+
+	inline uint64_t write_lock_irqsave(rwlock *l) {
+		uint64_t flags = irq_save();
+		write_lock(l);
+		return flags;
+	}
+
+	inline void write_unlock_irqrestore(rwlock *l, uint64_t flags) {
+		write_unlock(l);
+		irq_restore(flags);
+	}
+
+	/*
+	 * Sequence lock.  Readers loop until read_retry() says the copy they
+	 * took is consistent:
+	 *
+	 *	do {
+	 *		seq = sync::read_begin(&l);
+	 *		copy = data;
+	 *	} while( sync::read_retry(&l, seq) );
+	 *
+	 * Writers serialize on the embedded ticket lock, which also carries
+	 * the statistics.
+	 */
+
+	struct seqlock {
+		volatile uint32_t seq = 0;  // Odd while a writer is inside
+		ticket_lock       writer;
+
+		constexpr seqlock() = default;
+		constexpr explicit seqlock(lock_stats *s)
+		    : writer(s) {}
+	};
+
+	inline uint32_t read_begin(const seqlock *l) {
+		uint32_t seq;
+		while( (seq = __atomic_load_n(&l->seq, __ATOMIC_ACQUIRE)) & 1 )
+			__asm__ volatile("pause");
+		return seq;
+	}
+
+	inline bool read_retry(const seqlock *l, uint32_t seq) {
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		return __atomic_load_n(&l->seq, __ATOMIC_RELAXED) != seq;
+	}
+
+	inline void write_lock(seqlock *l) {
+		lock(&l->writer);
+		__atomic_store_n(&l->seq, l->seq + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+	}
+
+	inline void write_unlock(seqlock *l) {
+		__atomic_store_n(&l->seq, l->seq + 1, __ATOMIC_RELEASE);
+		unlock(&l->writer);
+	}
+
+	inline uint64_t write_lock_irqsave(seqlock *l) {
+		uint64_t flags = irq_save();
+		write_lock(l);
+		return flags;
+	}
+
+	inline void write_unlock_irqrestore(seqlock *l, uint64_t flags) {
+		write_unlock(l);
+		irq_restore(flags);
+	}
+}  // namespace sync
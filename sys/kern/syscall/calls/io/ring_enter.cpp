@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kstdint.h>
+
+#include <kern/syscall/ring.h>
+#include <kern/syscall/syscall.h>
+
+// Consume up to to_submit ring entries; returns how many were consumed
+uint64_t
+    sys_ring_enter(uint64_t syscall_no __attribute__((unused)),
+                   uint64_t to_submit,
+                   uint64_t arg1 __attribute__((unused)),
+                   uint64_t arg2 __attribute__((unused)),
+                   uint64_t arg3 __attribute__((unused)),
+                   uint64_t arg4 __attribute__((unused)),
+                   uint64_t arg5 __attribute__((unused))) {
+	if( to_submit == 0 || to_submit > syscall::ring::MAX_SQ_ENTRIES )
+		return SYSCALL_INVALID_ARGS;
+	return syscall::ring::submit((uint32_t) to_submit);
+}
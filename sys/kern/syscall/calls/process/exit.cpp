@@ -9,6 +9,9 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#ifdef ARCH_AMD64
+#	include <arch/amd64/user/user.h>
+#endif
 #include <kstdint.h>
 
 #include <dbg/logger.h>
@@ -24,6 +27,11 @@ uint64_t
              uint64_t arg5 __attribute__((unused))) {
 	logger::debug::printf(
 	    "syscall", "info", "Process exit with status %llu\n", status);
+#ifdef ARCH_AMD64
+	// Code started by amd64::user::run() goes back to its caller
+	if( amd64::user::is_active() )
+		amd64::user::exit(status);
+#endif
 	// TODO: Implement actual process termination
 	return SYSCALL_NOT_IMPLEMENTED;
 }
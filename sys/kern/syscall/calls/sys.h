@@ -11,7 +11,10 @@
  */
 // IO
 #include "io/read.h"
+#include "io/ring_enter.h"
 #include "io/write.h"
 // Process
 #include "process/exit.h"
 #include "process/getpid.h"
+// Time
+#include "time/time.h"
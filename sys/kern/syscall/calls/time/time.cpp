@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kstdint.h>
+#include <ktime.h>
+
+#include <kern/syscall/syscall.h>
+#include <kern/vdso/vdso.h>
+
+// Nanoseconds since boot (CLOCK_MONOTONIC) or since the epoch (CLOCK_REALTIME)
+uint64_t
+    sys_time(uint64_t syscall_no __attribute__((unused)),
+             uint64_t clock,
+             uint64_t arg1 __attribute__((unused)),
+             uint64_t arg2 __attribute__((unused)),
+             uint64_t arg3 __attribute__((unused)),
+             uint64_t arg4 __attribute__((unused)),
+             uint64_t arg5 __attribute__((unused))) {
+	switch( clock ) {
+		case CLOCK_MONOTONIC:
+			return time::now_ns();
+		case CLOCK_REALTIME:
+			return vdso::boot_epoch_ns() + time::now_ns();
+		default:
+			return SYSCALL_INVALID_ARGS;
+	}
+}
@@ -14,6 +14,8 @@
 #include <kstdio.h>
 
 #include <dbg/logger.h>
+#include <kern/stat/kstat.h>
+#include <kern/syscall/profile.h>
 
 // Global syscall infrastructure state
 static syscall_status_t syscall_status       = SYSCALL_STATUS_UNINITIALIZED;
@@ -21,9 +23,17 @@ static uint8_t          syscall_logging      = 1;  // Logging enabled by default
 static uint8_t          security_checks      = 0;  // Security checks disabled by default
 static uint64_t         max_calls_per_second = 0;  // No rate limiting by default
 
-// Syscall statistics
-static syscall_stats_t syscall_stats                         = {};
-static uint64_t        syscall_call_count[SYSCALL_MAX_COUNT] = {};
+// Syscall statistics; the per-syscall counts are in the profile
+KSTAT_COUNTER(calls_total, "syscall.calls");
+KSTAT_COUNTER(calls_ok, "syscall.ok");
+KSTAT_COUNTER(calls_failed, "syscall.failed");
+KSTAT_COUNTER(calls_invalid, "syscall.invalid");
+
+static uint64_t calls_of(uint64_t syscall_no) {
+	syscall::profile::summary s;
+	syscall::profile::collect(syscall_no, &s);
+	return s.time.count;
+}
 
 // Initialize the complete syscall infrastructure
 namespace syscall {
@@ -43,18 +53,20 @@ namespace syscall {
 				return;
 			}
 
-			// Update most used syscall
-			syscall_stats.most_used_count = 0;
+			stats->total_calls      = (uint64_t) kstat::read(&calls_total);
+			stats->successful_calls = (uint64_t) kstat::read(&calls_ok);
+			stats->failed_calls     = (uint64_t) kstat::read(&calls_failed);
+			stats->invalid_calls    = (uint64_t) kstat::read(&calls_invalid);
+
+			stats->most_used_syscall = 0;
+			stats->most_used_count   = 0;
 			for( uint64_t i = 0; i < SYSCALL_MAX_COUNT; i++ ) {
-				if( syscall_call_count[i]
-				    > syscall_stats.most_used_count ) {
-					syscall_stats.most_used_count =
-					    syscall_call_count[i];
-					syscall_stats.most_used_syscall = i;
+				uint64_t calls = calls_of(i);
+				if( calls > stats->most_used_count ) {
+					stats->most_used_count   = calls;
+					stats->most_used_syscall = i;
 				}
 			}
-
-			*stats = syscall_stats;
 		}
 
 		// Validate syscall infrastructure integrity
@@ -178,8 +190,7 @@ namespace syscall {
 				return;
 			}
 
-			logger::debug::printf(
-			    "syscall", nullptr, "info", "Register dump:\n");
+			logger::debug::printf("syscall", "info", "Register dump:\n");
 			logger::debug::printf("syscall",
 			                      "info",
 			                      "RAX: 0x%016llx  RBX: 0x%016llx\n",
@@ -254,19 +265,40 @@ namespace syscall {
 			    arg5);
 		}
 
+		void trace_return(uint64_t syscall_no, uint64_t result) {
+			if( !syscall_logging ) {
+				return;
+			}
+
+			logger::debug::printf("syscall",
+			                      "info",
+			                      "TRACE: %llu returned 0x%llx\n",
+			                      syscall_no,
+			                      result);
+		}
+
+		// Count one completed call (only built with SYSCALL_STATS)
+		void account(uint64_t syscall_no, uint64_t result, uint64_t cycles) {
+			kstat::inc(&calls_total);
+			if( result == SYSCALL_INVALID )
+				kstat::inc(&calls_invalid);
+			else if( result >= SYSCALL_INVALID_ARGS )
+				kstat::inc(&calls_failed);
+			else
+				kstat::inc(&calls_ok);
+
+			if( syscall_no < SYSCALL_MAX_COUNT )
+				profile::record(
+				    syscall_no, cycles, result >= SYSCALL_INVALID_ARGS);
+		}
+
 		// Reset syscall statistics
 		void reset_stats(void) {
-			syscall_stats.total_calls       = 0;
-			syscall_stats.successful_calls  = 0;
-			syscall_stats.failed_calls      = 0;
-			syscall_stats.invalid_calls     = 0;
-			syscall_stats.most_used_syscall = 0;
-			syscall_stats.most_used_count   = 0;
-
-			// Reset per-syscall counters
-			for( uint64_t i = 0; i < SYSCALL_MAX_COUNT; i++ ) {
-				syscall_call_count[i] = 0;
-			}
+			kstat::clear(&calls_total);
+			kstat::clear(&calls_ok);
+			kstat::clear(&calls_failed);
+			kstat::clear(&calls_invalid);
+			profile::reset();
 
 			logger::debug::printf("syscall", "success", "Statistics reset\n");
 		}
@@ -317,6 +349,8 @@ namespace syscall {
 				                      max_calls_per_second);
 			}
 
+			syscall_stats_t syscall_stats;
+			get_stats(&syscall_stats);
 			logger::debug::printf("syscall", nullptr, "\nStatistics:\n");
 			logger::debug::printf("syscall",
 			                      "info",
@@ -374,7 +408,7 @@ namespace syscall {
 						    i,
 						    info->name,
 						    info->arg_count,
-						    syscall_call_count[i]);
+						    calls_of(i));
 						registered_count++;
 					}
 				}
@@ -52,6 +52,10 @@ namespace syscall {
 		                            uint64_t arg3,
 		                            uint64_t arg4,
 		                            uint64_t arg5);
+		void             trace_return(uint64_t syscall_no, uint64_t result);
+		void             account(uint64_t syscall_no,
+		                         uint64_t result,
+		                         uint64_t cycles);
 		void             reset_stats(void);
 		void             print_info(void);
 		void             print_table(void);
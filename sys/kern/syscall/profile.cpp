@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "profile.h"
+
+#include <kmemset.h>
+#include <ktime.h>
+
+#ifdef ARCH_AMD64
+#	include <arch/amd64/apic/madt.h>
+#	include <arch/amd64/asm/msr.h>
+#	include <arch/amd64/cpu/percpu.h>
+#endif
+#include <kern/sync/spinlock.h>
+#include <kern/syscall/syscall.h>
+
+namespace syscall::profile {
+	// Only builds with SYSCALL_STATS record anything
+	constexpr uint32_t TABLES = SYSCALL_STATS ? amd64::madt::MAX_CPUS : 1;
+
+	struct counters {
+		kstat::hist::counts time;
+		uint64_t            errors;
+	};
+
+	/*
+	 * One table per CPU.  dispatch() runs with interrupts on and can nest
+	 * under an interrupt on the same CPU, so the owner writes with
+	 * interrupts off inside the table's seqlock; the lock itself is only
+	 * ever contended by reset() and readers never take it.
+	 */
+	struct alignas(64) cpu_table {
+		sync::seqlock lock;
+		counters      calls[SYSCALL_MAX_COUNT];
+	};
+
+	static cpu_table tables[TABLES];
+
+	// now_ns() and TSC at the last reset
+	static uint64_t reset_ns  = 0;
+	static uint64_t reset_tsc = 0;
+
+	/**
+	 * @brief Account one call of @p syscall_no on the calling CPU
+	 */
+	void record(uint64_t syscall_no, uint64_t cycles, bool error) {
+		if( syscall_no >= SYSCALL_MAX_COUNT )
+			return;
+
+		uint32_t cpu = amd64::percpu::id();
+		if( cpu >= TABLES )
+			return;
+
+		cpu_table *t     = &tables[cpu];
+		uint64_t   flags = sync::write_lock_irqsave(&t->lock);
+		kstat::hist::add(&t->calls[syscall_no].time, cycles);
+		t->calls[syscall_no].errors += error;
+		sync::write_unlock_irqrestore(&t->lock, flags);
+	}
+
+	/**
+	 * @brief Sum the counters of @p syscall_no over every CPU
+	 *
+	 * Each CPU's share is copied consistently, never half cleared by
+	 * reset() or half updated by record().
+	 *
+	 * @return False if @p syscall_no is out of range or was never called
+	 */
+	bool collect(uint64_t syscall_no, summary *out) {
+		kstring::memset(out, 0, sizeof(*out));
+		if( syscall_no >= SYSCALL_MAX_COUNT )
+			return false;
+
+		for( uint32_t cpu = 0; cpu < TABLES; cpu++ ) {
+			const cpu_table *t = &tables[cpu];
+			counters         copy;
+			uint32_t         seq;
+			do {
+				seq  = sync::read_begin(&t->lock);
+				copy = t->calls[syscall_no];
+			} while( sync::read_retry(&t->lock, seq) );
+
+			kstat::hist::merge(&out->time, &copy.time);
+			out->errors += copy.errors;
+		}
+		return out->time.count != 0;
+	}
+
+	/**
+	 * @brief Clear every counter and restart the rate window
+	 *
+	 * Tables are cleared one CPU at a time, each under its lock, so no call
+	 * is counted half before and half after.
+	 */
+	void reset(void) {
+		for( uint32_t cpu = 0; cpu < TABLES; cpu++ ) {
+			cpu_table *t     = &tables[cpu];
+			uint64_t   flags = sync::write_lock_irqsave(&t->lock);
+			kstring::memset(t->calls, 0, sizeof(t->calls));
+			sync::write_unlock_irqrestore(&t->lock, flags);
+		}
+
+		reset_ns  = time::now_ns();
+		reset_tsc = rdtsc_ordered();
+	}
+
+	/**
+	 * @brief Nanoseconds and TSC cycles elapsed since the last reset
+	 */
+	void since_reset(uint64_t *ns, uint64_t *tsc) {
+		*tsc = rdtsc_ordered() - reset_tsc;
+		*ns  = time::now_ns() - reset_ns;
+	}
+}  // namespace syscall::profile
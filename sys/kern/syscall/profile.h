@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+#include <kern/stat/histogram.h>
+
+/*
+ * Per-syscall call counts and durations.
+ *
+ * dispatch() times every call with the TSC when built with SYSCALL_STATS
+ * and records it on the CPU it ran on.  Durations go into a log2
+ * histogram per CPU; readers add the CPUs up into a summary.  reset()
+ * clears everything and notes the time, so rates cover the span since
+ * the last reset.
+ */
+namespace syscall::profile {
+	struct summary {
+		kstat::hist::summary time;  // One sample per call
+		uint64_t             errors;
+	};
+
+	void record(uint64_t syscall_no, uint64_t cycles, bool error);
+	bool collect(uint64_t syscall_no, summary *out);
+	void reset(void);
+	void since_reset(uint64_t *ns, uint64_t *tsc);
+}  // namespace syscall::profile
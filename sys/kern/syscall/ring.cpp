@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "ring.h"
+
+#include <kmemset.h>
+#include <ktime.h>
+
+#include <dbg/logger.h>
+#include <kern/syscall/syscall.h>
+#include <kern/timer/hrtimer.h>
+#include <kern/work/work.h>
+
+namespace syscall::ring {
+	/*
+	 * The kernel's own view of the ring.  Sizes and the indices it owns are
+	 * kept here, so nothing ring 3 writes into the header can send it
+	 * outside the arrays.
+	 */
+	static struct {
+		header  *hdr;
+		sqe     *sq;
+		cqe     *cq;
+		uint32_t sq_mask;
+		uint32_t cq_mask;
+		uint32_t sq_head;
+		uint32_t cq_tail;
+		bool     poll;
+		bool     busy;  // Set while submit() runs
+	} ring;
+
+	static hrtimer::entry poll_timer;
+	static work::item     poll_work;
+
+	static void poll_drain(void *arg __attribute__((unused))) {
+		submit(ring.sq_mask + 1);
+	}
+
+	// Runs in the timer interrupt; the draining itself is deferred
+	static void poll_tick(void *arg __attribute__((unused))) {
+		if( !ring.poll )
+			return;
+		work::queue(&poll_work);
+		hrtimer::start(&poll_timer,
+		               time::now_ns() + POLL_INTERVAL_NS,
+		               POLL_INTERVAL_NS / 4);
+	}
+
+	/**
+	 * @brief Lay out a ring in @p mem and make it the active one
+	 *
+	 * @param sq_entries Submission entries, a power of two up to
+	 *                   MAX_SQ_ENTRIES; the completion ring gets twice that
+	 * @param poll       Consume submissions from a kernel poller as well
+	 * @return The initialized header, or nullptr if the arguments are bad
+	 */
+	header *setup(void *mem, size_t size, uint32_t sq_entries, bool poll) {
+		if( mem == nullptr || sq_entries == 0 || sq_entries > MAX_SQ_ENTRIES )
+			return nullptr;
+		if( (sq_entries & (sq_entries - 1)) != 0 || size < size_for(sq_entries) )
+			return nullptr;
+
+		teardown();
+		kstring::memset(mem, 0, size_for(sq_entries));
+
+		header *hdr     = (header *) mem;
+		hdr->sq_entries = sq_entries;
+		hdr->cq_entries = 2 * sq_entries;
+		hdr->sq_offset  = (uint32_t) sizeof(header);
+		hdr->cq_offset  = (uint32_t) (sizeof(header) + sq_entries * sizeof(sqe));
+		hdr->flags      = poll ? FLAG_POLL : 0;
+
+		uint8_t *base = (uint8_t *) mem;
+		ring.sq       = (sqe *) (base + hdr->sq_offset);
+		ring.cq       = (cqe *) (base + hdr->cq_offset);
+		ring.sq_mask  = sq_entries - 1;
+		ring.cq_mask  = 2 * sq_entries - 1;
+		ring.sq_head  = 0;
+		ring.cq_tail  = 0;
+		ring.poll     = poll;
+		ring.busy     = false;
+		ring.hdr      = hdr;
+
+		if( poll ) {
+			work::setup(&poll_work, poll_drain, nullptr);
+			hrtimer::setup(&poll_timer, poll_tick, nullptr);
+			hrtimer::start(&poll_timer,
+			               time::now_ns() + POLL_INTERVAL_NS,
+			               POLL_INTERVAL_NS / 4);
+		}
+
+		logger::debug::printf("syscall",
+		                      "info",
+		                      "Ring at 0x%llx: %u entries%s\n",
+		                      (uint64_t) mem,
+		                      hdr->sq_entries,
+		                      poll ? ", polled" : "");
+		return hdr;
+	}
+
+	/**
+	 * @brief Stop using the active ring, if any
+	 *
+	 * Waits for a poller run that is already queued, so the memory can be
+	 * reused as soon as this returns.
+	 */
+	void teardown(void) {
+		if( ring.hdr == nullptr )
+			return;
+
+		if( ring.poll ) {
+			ring.poll = false;
+			hrtimer::cancel(&poll_timer);
+			while( work::is_queued(&poll_work) )
+				work::run();
+		}
+		ring.hdr = nullptr;
+	}
+
+	/**
+	 * @brief Run up to @p max published submissions
+	 *
+	 * Each entry is copied out of the shared page before it is used.
+	 * Consumption stops early when the completion ring is full; the
+	 * remaining entries stay queued for the next call.  Entries that would
+	 * end the caller or re-enter the ring complete with
+	 * SYSCALL_INVALID_ARGS.
+	 *
+	 * @return The number of submissions consumed
+	 */
+	uint32_t submit(uint32_t max) {
+		if( ring.hdr == nullptr )
+			return 0;
+		if( __atomic_exchange_n(&ring.busy, true, __ATOMIC_ACQUIRE) )
+			return 0;
+
+		header  *hdr     = ring.hdr;
+		uint32_t sq_tail = __atomic_load_n(&hdr->sq_tail, __ATOMIC_ACQUIRE);
+		uint32_t cq_head = __atomic_load_n(&hdr->cq_head, __ATOMIC_ACQUIRE);
+		uint32_t done    = 0;
+
+		while( ring.sq_head != sq_tail && done < max ) {
+			if( ring.cq_tail - cq_head > ring.cq_mask )
+				break;
+
+			sqe e = ring.sq[ring.sq_head & ring.sq_mask];
+			ring.sq_head++;
+
+			uint64_t result = SYSCALL_INVALID_ARGS;
+			if( e.op != SYS_EXIT && e.op != SYS_RING_ENTER ) {
+				syscall_args_t a = {e.op,
+				                    e.args[0],
+				                    e.args[1],
+				                    e.args[2],
+				                    e.args[3],
+				                    e.args[4],
+				                    e.args[5]};
+				result = dispatch(&a);
+			}
+
+			cqe *c       = &ring.cq[ring.cq_tail & ring.cq_mask];
+			c->user_data = e.user_data;
+			c->result    = result;
+			ring.cq_tail++;
+			done++;
+		}
+
+		__atomic_store_n(&hdr->sq_head, ring.sq_head, __ATOMIC_RELEASE);
+		__atomic_store_n(&hdr->cq_tail, ring.cq_tail, __ATOMIC_RELEASE);
+		__atomic_store_n(&ring.busy, false, __ATOMIC_RELEASE);
+		return done;
+	}
+}  // namespace syscall::ring
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * Submission/completion rings for batched syscalls.
+ *
+ * One region shared with ring 3 holds a header, a power-of-two array of
+ * submission entries (sqe) and a completion array (cqe) twice that size.
+ * The caller fills entries at sq_tail and publishes them by advancing it.
+ * The kernel consumes them at sq_head, runs each one through the syscall
+ * table and posts the result at cq_tail.  The caller reaps completions and
+ * advances cq_head.  Each index is written by one side only.
+ *
+ * SYS_RING_ENTER consumes pending entries in a single trap.  In polling
+ * mode a periodic kernel poller does the same, so the caller never traps;
+ * it only watches cq_tail.
+ */
+namespace syscall::ring {
+	// Submission entry: a syscall number and its arguments
+	struct sqe {
+		uint64_t op;
+		uint64_t args[6];
+		uint64_t user_data;  // Copied to the completion untouched
+	};
+
+	// Completion entry
+	struct cqe {
+		uint64_t user_data;
+		uint64_t result;
+	};
+
+	struct header {
+		volatile uint32_t sq_head;  // Written by the kernel
+		volatile uint32_t sq_tail;  // Written by the caller
+		volatile uint32_t cq_head;  // Written by the caller
+		volatile uint32_t cq_tail;  // Written by the kernel
+		uint32_t          sq_entries;
+		uint32_t          cq_entries;
+		uint32_t          sq_offset;  // From the header to the sqe array
+		uint32_t          cq_offset;  // From the header to the cqe array
+		uint32_t          flags;
+		uint32_t          reserved[7];
+	};
+
+	static_assert(sizeof(sqe) == 64, "sqe layout is shared with ring 3");
+	static_assert(sizeof(header) == 64, "header layout is shared with ring 3");
+
+	// header::flags
+	constexpr uint32_t FLAG_POLL = 1U << 0;  // A kernel poller consumes the ring
+
+	constexpr uint32_t MAX_SQ_ENTRIES = 256;
+
+	// Period of the polling mode poller
+	constexpr uint64_t POLL_INTERVAL_NS = 20000;
+
+	// Bytes needed for a ring with @p sq_entries submission entries
+	constexpr size_t size_for(uint32_t sq_entries) {
+		return sizeof(header) + sq_entries * sizeof(sqe)
+		     + 2 * sq_entries * sizeof(cqe);
+	}
+
+	header  *setup(void *mem, size_t size, uint32_t sq_entries, bool poll);
+	void     teardown(void);
+	uint32_t submit(uint32_t max);
+}  // namespace syscall::ring
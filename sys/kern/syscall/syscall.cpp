@@ -13,14 +13,73 @@
 
 #include <kstdio.h>
 
+#ifdef ARCH_AMD64
+#	include <arch/amd64/asm/msr.h>
+#endif
 #include <dbg/logger.h>
 #include <kern/syscall/calls/sys.h>
+#include <kern/syscall/integration.h>
+#include <kern/sync/rcu.h>
+#include <kern/sync/spinlock.h>
 
-// Global syscall table
-static syscall_entry_t syscall_table[SYSCALL_MAX_COUNT];
-static uint64_t        syscall_count = 0;
+// Handler of every free slot, so dispatch never has to test for one
+static uint64_t
+    sys_invalid(uint64_t syscall_no,
+                uint64_t arg0 __attribute__((unused)),
+                uint64_t arg1 __attribute__((unused)),
+                uint64_t arg2 __attribute__((unused)),
+                uint64_t arg3 __attribute__((unused)),
+                uint64_t arg4 __attribute__((unused)),
+                uint64_t arg5 __attribute__((unused))) {
+	logger::debug::printf(
+	    "syscall", "error", "Invalid syscall number %llu\n", syscall_no);
+	return SYSCALL_INVALID;
+}
+
+// Core syscalls, placed in the table at compile time
+static constexpr struct {
+	uint64_t          no;
+	syscall_handler_t handler;
+	const char       *name;
+	uint8_t           arg_count;
+} core_syscalls[] = {
+    {SYS_EXIT, sys_exit, "exit", 1},
+    {SYS_GETPID, sys_getpid, "getpid", 0},
+    {SYS_READ, sys_read, "read", 3},
+    {SYS_WRITE, sys_write, "write", 3},
+    {SYS_TIME, sys_time, "time", 1},
+    {SYS_RING_ENTER, sys_ring_enter, "ring_enter", 1},
+};
+
+struct syscall_table_t {
+	syscall_entry_t entries[SYSCALL_MAX_COUNT];
+};
+
+static consteval syscall_table_t
+    build_table(void) {
+	syscall_table_t t = {};
+	for( syscall_entry_t &e : t.entries )
+		e = {sys_invalid, nullptr, 0};
+	for( const auto &c : core_syscalls )
+		t.entries[c.no] = {c.handler, c.name, c.arg_count};
+	return t;
+}
+
+// Global syscall table, built by the compiler; bind()/unbind() still edit it
+constinit static syscall_table_t table = build_table();
+static syscall_entry_t *const    syscall_table = table.entries;
+static uint64_t syscall_count = sizeof(core_syscalls) / sizeof(core_syscalls[0]);
+
+/*
+ * Serializes bind() and unbind().  dispatch() does not take it: a slot's
+ * handler is published with rcu::assign_pointer() last when it is bound
+ * and first when it is unbound, so the one rcu::dereference() dispatch()
+ * does never sees a half-written slot.  Handlers may sleep, so dispatch()
+ * holds no read-side section across the call; handler code is never freed.
+ */
+static sync::lock_stats  table_stats("syscall.table");
+static sync::ticket_lock table_lock(&table_stats);
 
-// Initialize the syscall subsystem
 namespace syscall {
 	// Register a new syscall handler
 	void bind(uint64_t          syscall_no,
@@ -44,20 +103,30 @@ namespace syscall {
 			return;
 		}
 
+		syscall_entry_t *entry = &syscall_table[syscall_no];
+		uint64_t         flags = sync::lock_irqsave(&table_lock);
+
 		// Check if syscall is already registered
-		if( syscall_table[syscall_no].handler != nullptr ) {
-			logger::debug::printf("syscall",
-			                      "warn",
-			                      "Overwriting existing syscall %llu (%s)\n",
-			                      syscall_no,
-			                      syscall_table[syscall_no].name);
+		const char *replaced = nullptr;
+		if( entry->handler != sys_invalid ) {
+			replaced = entry->name;
+			rcu::assign_pointer(&entry->handler, &sys_invalid);
 		} else {
 			syscall_count++;
 		}
 
-		syscall_table[syscall_no].handler   = handler;
-		syscall_table[syscall_no].name      = name;
-		syscall_table[syscall_no].arg_count = arg_count;
+		entry->name      = name;
+		entry->arg_count = arg_count;
+		rcu::assign_pointer(&entry->handler, handler);
+		sync::unlock_irqrestore(&table_lock, flags);
+
+		if( replaced ) {
+			logger::debug::printf("syscall",
+			                      "warn",
+			                      "Overwrote existing syscall %llu (%s)\n",
+			                      syscall_no,
+			                      replaced);
+		}
 
 		logger::debug::printf("syscall",
 		                      "success",
@@ -77,7 +146,11 @@ namespace syscall {
 			return;
 		}
 
-		if( syscall_table[syscall_no].handler == nullptr ) {
+		syscall_entry_t *entry = &syscall_table[syscall_no];
+		uint64_t         flags = sync::lock_irqsave(&table_lock);
+
+		if( entry->handler == sys_invalid ) {
+			sync::unlock_irqrestore(&table_lock, flags);
 			logger::debug::printf("syscall",
 			                      "warn",
 			                      "Syscall %llu is not registered\n",
@@ -85,32 +158,22 @@ namespace syscall {
 			return;
 		}
 
+		const char *name = entry->name;
+		rcu::assign_pointer(&entry->handler, &sys_invalid);
+		entry->name      = nullptr;
+		entry->arg_count = 0;
+		syscall_count--;
+		sync::unlock_irqrestore(&table_lock, flags);
+
 		logger::debug::printf("syscall",
 		                      "success",
 		                      "Unregistered syscall %llu: %s\n",
 		                      syscall_no,
-		                      syscall_table[syscall_no].name);
-
-		syscall_table[syscall_no].handler   = nullptr;
-		syscall_table[syscall_no].name      = nullptr;
-		syscall_table[syscall_no].arg_count = 0;
-		syscall_count--;
+		                      name);
 	}
 
 	void init(void) {
-		// Clear the syscall table
-		for( uint64_t i = 0; i < SYSCALL_MAX_COUNT; i++ ) {
-			syscall_table[i].handler   = nullptr;
-			syscall_table[i].name      = nullptr;
-			syscall_table[i].arg_count = 0;
-		}
-
-		// Register core syscalls
-		bind(SYS_EXIT, sys_exit, "exit", 1);
-		bind(SYS_GETPID, sys_getpid, "getpid", 0);
-		bind(SYS_READ, sys_read, "read", 3);
-		bind(SYS_WRITE, sys_write, "write", 3);
-
+		// The table itself is built at compile time
 		logger::debug::printf("syscall",
 		                      "success",
 		                      "Initialized with %llu syscalls\n",
@@ -123,7 +186,7 @@ namespace syscall {
 			return nullptr;
 		}
 
-		if( syscall_table[syscall_no].handler == nullptr ) {
+		if( syscall_table[syscall_no].handler == sys_invalid ) {
 			return nullptr;
 		}
 
@@ -136,62 +199,69 @@ namespace syscall {
 			return 0;
 		}
 
-		return (syscall_table[syscall_no].handler != nullptr) ? 1 : 0;
+		return (syscall_table[syscall_no].handler != sys_invalid) ? 1 : 0;
 	}
 
-	// Main syscall dispatcher (called from assembly)
-	void handler(registers_t *regs) {
-		// Syscall number is in RAX
-		uint64_t syscall_no = regs->rax;
-
-		// Arguments are in RDI, RSI, RDX, RCX, R8, R9
-		uint64_t arg0 = regs->rdi;
-		uint64_t arg1 = regs->rsi;
-		uint64_t arg2 = regs->rdx;
-		uint64_t arg3 = regs->rcx;
-		uint64_t arg4 = regs->r8;
-		uint64_t arg5 = regs->r9;
-
-		// Check if syscall is valid
-		if( !is_valid(syscall_no) ) {
-			logger::debug::printf("syscall",
-			                      "error",
-			                      "Invalid syscall number %llu\n",
-			                      syscall_no);
-			regs->rax = SYSCALL_INVALID;
-			return;
+	/**
+	 * @brief Main syscall dispatcher, shared by both entry paths
+	 *
+	 * One bounds check and an indirect call: free slots hold sys_invalid.
+	 * Tracing and statistics are compiled in only with SYSCALL_TRACE and
+	 * SYSCALL_STATS.
+	 */
+	uint64_t dispatch(const syscall_args_t *args) {
+		uint64_t syscall_no = args->nr;
+		if( syscall_no >= SYSCALL_MAX_COUNT ) [[unlikely]] {
+			if constexpr( SYSCALL_STATS )
+				infrastructure::account(syscall_no, SYSCALL_INVALID, 0);
+			return sys_invalid(syscall_no, 0, 0, 0, 0, 0, 0);
 		}
 
-		// Get syscall entry
-		const syscall_entry_t *entry = get_info(syscall_no);
-		if( entry == nullptr ) {
-			logger::debug::printf("syscall",
-			                      "error",
-			                      "Failed to get syscall info for %llu\n",
-			                      syscall_no);
-			regs->rax = SYSCALL_ERROR;
-			return;
-		}
+		if constexpr( SYSCALL_TRACE )
+			infrastructure::trace_call(syscall_no,
+			                           args->arg0,
+			                           args->arg1,
+			                           args->arg2,
+			                           args->arg3,
+			                           args->arg4,
+			                           args->arg5);
 
-		// Log syscall for debugging (can be disabled in production)
-		logger::debug::printf("syscall",
-		                      "notice",
-		                      "Calling syscall %llu: %s\n",
-		                      syscall_no,
-		                      entry->name);
+		// Only the handler is timed, not the tracing around it
+		uint64_t start = 0;
+		if constexpr( SYSCALL_STATS )
+			start = rdtsc_ordered();
 
-		// Call the syscall handler
-		uint64_t result =
-		    entry->handler(syscall_no, arg0, arg1, arg2, arg3, arg4, arg5);
+		syscall_handler_t handler =
+		    rcu::dereference(&syscall_table[syscall_no].handler);
+		uint64_t result = handler(syscall_no,
+		                          args->arg0,
+		                          args->arg1,
+		                          args->arg2,
+		                          args->arg3,
+		                          args->arg4,
+		                          args->arg5);
 
-		// Return result in RAX
-		regs->rax = result;
+		if constexpr( SYSCALL_STATS )
+			infrastructure::account(
+			    syscall_no, result, rdtsc_ordered() - start);
+		if constexpr( SYSCALL_TRACE )
+			infrastructure::trace_return(syscall_no, result);
+		return result;
+	}
 
-		logger::debug::printf("syscall",
-		                      "success",
-		                      "Syscall %llu returned %llu\n",
-		                      syscall_no,
-		                      result);
+	// int 0x80 dispatcher (called from assembly)
+	void handler(registers_t *regs) {
+		// Syscall number is in RAX, arguments in RDI, RSI, RDX, RCX, R8, R9
+		syscall_args_t args = {regs->rax,
+		                       regs->rdi,
+		                       regs->rsi,
+		                       regs->rdx,
+		                       regs->rcx,
+		                       regs->r8,
+		                       regs->r9};
+
+		// Return result in RAX
+		regs->rax = dispatch(&args);
 	}
 }  // namespace syscall
 
@@ -200,3 +270,9 @@ extern "C" void
     syscall_handler(registers_t *regs) {
 	syscall::handler(regs);
 }
+
+// SYSCALL entry; the result goes back in RAX
+extern "C" uint64_t
+    syscall_fast_handler(const syscall_args_t *args) {
+	return syscall::dispatch(args);
+}
@@ -18,6 +18,17 @@
 
 extern struct Syscalls syscalls;
 
+/*
+ * Build-time switches for the dispatch path.  With both off (Release) the
+ * dispatcher is a bounds check and an indirect call; Debug builds enable both.
+ */
+#ifndef SYSCALL_TRACE
+#	define SYSCALL_TRACE 0  // Log every call and its return value
+#endif
+#ifndef SYSCALL_STATS
+#	define SYSCALL_STATS 0  // Count calls per syscall and by outcome
+#endif
+
 // Maximum number of syscalls supported
 #define SYSCALL_MAX_COUNT 256
 
@@ -58,6 +69,12 @@ extern struct Syscalls syscalls;
 #define SYS_TRUNCATE 30  // Truncate file
 #define SYS_LSEEK    31  // Seek in file
 
+#define SYS_RING_ENTER 32  // Consume submission ring entries
+
+// SYS_TIME clocks
+#define CLOCK_MONOTONIC 0  // Since boot
+#define CLOCK_REALTIME  1  // Since the Unix epoch
+
 // Syscall return values
 #define SYSCALL_SUCCESS           0ULL
 #define SYSCALL_ERROR             0xFFFFFFFFFFFFFFFFULL
@@ -76,6 +93,17 @@ typedef uint64_t (*syscall_handler_t)(uint64_t syscall_no,
                                       uint64_t arg4,
                                       uint64_t arg5);
 
+// Number and arguments as saved by the SYSCALL entry stub
+typedef struct {
+	uint64_t nr;
+	uint64_t arg0;
+	uint64_t arg1;
+	uint64_t arg2;
+	uint64_t arg3;  // r10 on the syscall path, rcx on int 0x80
+	uint64_t arg4;
+	uint64_t arg5;
+} syscall_args_t;
+
 // Syscall table entry
 typedef struct {
 	syscall_handler_t handler;
@@ -92,5 +120,6 @@ namespace syscall {
 	void             init(void);
 	syscall_entry_t *get_info(uint64_t syscall_no);
 	uint8_t          is_valid(uint64_t syscall_no);
+	uint64_t         dispatch(const syscall_args_t *args);
 	void             handler(registers_t *regs);
 }  // namespace syscall
\ No newline at end of file
@@ -46,6 +46,7 @@
 #define SYS_CHOWN      29  // Change file ownership
 #define SYS_TRUNCATE   30  // Truncate file
 #define SYS_LSEEK      31  // Seek in file
+#define SYS_RING_ENTER 32  // Consume submission ring entries
 
 // Syscall return values
 #define SYSCALL_SUCCESS           0ULL
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "hrtimer.h"
+
+#include <ktime.h>
+
+#include <arch/amd64/asm/irqflags.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/spinlock.h>
+
+#include "timer.h"
+
+#define NOT_QUEUED 0xFFFFFFFFU
+
+// Timers fired per pass of the coalescing search
+#define RUN_BATCH 32
+
+// Passes per interrupt; bounds a callback that keeps re-arming in the past
+#define RUN_MAX_PASSES 8
+
+namespace hrtimer {
+	static entry   *heap[CAPACITY];
+	static uint32_t count = 0;
+
+	// Guards the heap across CPUs; always taken with interrupts off
+	static sync::lock_stats  heap_stats("hrtimer.heap");
+	static sync::ticket_lock heap_lock(&heap_stats);
+
+	static inline void place(entry *t, uint32_t i) {
+		heap[i]  = t;
+		t->index = i;
+	}
+
+	static void sift_up(uint32_t i) {
+		entry *t = heap[i];
+		while( i > 0 ) {
+			uint32_t parent = (i - 1) / 2;
+			if( heap[parent]->hard_ns <= t->hard_ns )
+				break;
+			place(heap[parent], i);
+			i = parent;
+		}
+		place(t, i);
+	}
+
+	static void sift_down(uint32_t i) {
+		entry *t = heap[i];
+		for( ;; ) {
+			uint32_t child = 2 * i + 1;
+			if( child >= count )
+				break;
+			if( child + 1 < count
+			    && heap[child + 1]->hard_ns < heap[child]->hard_ns )
+				child++;
+			if( t->hard_ns <= heap[child]->hard_ns )
+				break;
+			place(heap[child], i);
+			i = child;
+		}
+		place(t, i);
+	}
+
+	static void remove(entry *t) {
+		uint32_t i    = t->index;
+		entry   *last = heap[--count];
+		t->index      = NOT_QUEUED;
+
+		if( i == count )
+			return;
+
+		place(last, i);
+		if( i > 0 && heap[(i - 1) / 2]->hard_ns > last->hard_ns )
+			sift_up(i);
+		else
+			sift_down(i);
+	}
+
+	/**
+	 * @brief Gather up to @p max timers whose window has opened at @p now
+	 *
+	 * Heap order is by hard deadline and a soft deadline trails its hard
+	 * one by at most MAX_SLACK_NS, so any subtree rooted past
+	 * now + MAX_SLACK_NS cannot hold a due timer and is skipped.
+	 */
+	static uint32_t collect(uint64_t now, entry **out, uint32_t max) {
+		uint32_t stack[CAPACITY];
+		uint32_t depth = 0;
+		uint32_t n     = 0;
+
+		if( count )
+			stack[depth++] = 0;
+
+		while( depth && n < max ) {
+			uint32_t i = stack[--depth];
+			entry   *t = heap[i];
+
+			if( t->hard_ns > now + MAX_SLACK_NS )
+				continue;
+			if( t->soft_ns <= now )
+				out[n++] = t;
+
+			uint32_t child = 2 * i + 1;
+			if( child < count )
+				stack[depth++] = child;
+			if( child + 1 < count )
+				stack[depth++] = child + 1;
+		}
+		return n;
+	}
+
+	void setup(entry *t, callback fn, void *arg) {
+		t->soft_ns = 0;
+		t->hard_ns = 0;
+		t->fn      = fn;
+		t->arg     = arg;
+		t->index   = NOT_QUEUED;
+	}
+
+	/**
+	 * @brief Queue @p t to fire in [deadline_ns, deadline_ns + slack_ns]
+	 *
+	 * A timer that is already queued is moved.
+	 *
+	 * @return False if the queue is full
+	 */
+	bool start(entry *t, uint64_t deadline_ns, uint64_t slack_ns) {
+		if( slack_ns > MAX_SLACK_NS )
+			slack_ns = MAX_SLACK_NS;
+
+		uint64_t flags = sync::lock_irqsave(&heap_lock);
+
+		if( t->index != NOT_QUEUED )
+			remove(t);
+
+		if( count == CAPACITY ) {
+			sync::unlock(&heap_lock);
+			irq_restore(flags);
+			return false;
+		}
+
+		t->soft_ns = deadline_ns;
+		t->hard_ns = deadline_ns + slack_ns;
+		place(t, count++);
+		sift_up(t->index);
+		bool first = t->index == 0;
+
+		sync::unlock(&heap_lock);
+		if( first )
+			timer::arm(t->hard_ns);
+
+		irq_restore(flags);
+		return true;
+	}
+
+	/**
+	 * @brief Remove @p t from the queue
+	 *
+	 * Does not wait for a callback that is already running.  Once run()
+	 * has taken @p t off the queue this returns false, and the callback
+	 * may still be running, or about to run, on another CPU; a caller
+	 * that frees what arg points to has to synchronise with the callback
+	 * itself.  @p t alone may be freed as soon as this returns.
+	 *
+	 * @return True if it was queued, i.e. the callback will not run
+	 */
+	bool cancel(entry *t) {
+		uint64_t flags  = sync::lock_irqsave(&heap_lock);
+		bool     queued = t->index != NOT_QUEUED;
+		if( queued )
+			remove(t);
+		sync::unlock_irqrestore(&heap_lock, flags);
+		return queued;
+	}
+
+	bool is_queued(const entry *t) {
+		return t->index != NOT_QUEUED;
+	}
+
+	static void wake(void *arg) {
+		sched::complete((sched::completion *) arg);
+	}
+
+	/**
+	 * @brief Wait until @p deadline_ns
+	 *
+	 * Blocks the calling thread, or halts the CPU in between before the
+	 * scheduler is up.  With interrupts off there is nothing to wake a
+	 * halted CPU, so it spins on now_ns() instead.
+	 */
+	void sleep_until(uint64_t deadline_ns, uint64_t slack_ns) {
+		if( !irq_enabled() ) {
+			while( time::now_ns() < deadline_ns )
+				__asm__ volatile("pause");
+			return;
+		}
+
+		sched::completion done = {};
+		entry             t;
+		setup(&t, wake, &done);
+		if( !start(&t, deadline_ns, slack_ns) ) {
+			while( time::now_ns() < deadline_ns )
+				__asm__ volatile("pause");
+			return;
+		}
+		sched::wait_for(&done);
+	}
+
+	void sleep_ns(uint64_t ns, uint64_t slack_ns) {
+		sleep_until(time::now_ns() + ns, slack_ns);
+	}
+
+	/**
+	 * @brief Hard deadline of the first queued timer, or ~0 if none
+	 */
+	uint64_t next_deadline_ns(void) {
+		uint64_t flags = sync::lock_irqsave(&heap_lock);
+		uint64_t next  = count ? heap[0]->hard_ns : ~0ULL;
+		sync::unlock_irqrestore(&heap_lock, flags);
+		return next;
+	}
+
+	/**
+	 * @brief Fire every timer whose window has opened
+	 *
+	 * Called from the timer interrupt.  Timers are taken off the queue
+	 * before their callback runs, so a callback may start its own timer
+	 * again.  Callbacks run with the queue unlocked, from a copy of fn and
+	 * arg taken under the lock: once a timer is off the queue run() never
+	 * touches it again, and its owner may reuse or free it.
+	 */
+	void run(void) {
+		uint64_t flags = irq_save();
+		entry   *batch[RUN_BATCH];
+		callback fns[RUN_BATCH];
+		void    *args[RUN_BATCH];
+
+		for( int pass = 0; pass < RUN_MAX_PASSES; pass++ ) {
+			sync::lock(&heap_lock);
+			uint32_t n = collect(time::now_ns(), batch, RUN_BATCH);
+			if( n == 0 ) {
+				sync::unlock(&heap_lock);
+				break;
+			}
+
+			// Fire in deadline order; batches are small
+			for( uint32_t i = 1; i < n; i++ ) {
+				entry   *t = batch[i];
+				uint32_t j = i;
+				for( ; j > 0 && batch[j - 1]->soft_ns > t->soft_ns; j-- )
+					batch[j] = batch[j - 1];
+				batch[j] = t;
+			}
+
+			for( uint32_t i = 0; i < n; i++ ) {
+				fns[i]  = batch[i]->fn;
+				args[i] = batch[i]->arg;
+				remove(batch[i]);
+			}
+			sync::unlock(&heap_lock);
+			for( uint32_t i = 0; i < n; i++ )
+				fns[i](args[i]);
+		}
+
+		irq_restore(flags);
+	}
+}  // namespace hrtimer
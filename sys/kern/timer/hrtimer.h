@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * High-resolution timers.
+ *
+ * Absolute now_ns() deadlines kept in a binary min-heap and fired from the
+ * same one-shot interrupt as the timer wheel, so they resolve to whatever
+ * the event source can do (TSC-deadline: well under a microsecond).
+ *
+ * A timer may fire anywhere in [deadline, deadline + slack].  The interrupt
+ * is programmed for the earliest window end, and when it arrives every
+ * timer whose window has already opened runs as well, so timers with some
+ * slack share interrupts instead of each taking their own.
+ */
+namespace hrtimer {
+	using callback = void (*)(void *arg);
+
+	// Slack used when the caller does not give one
+	constexpr uint64_t DEFAULT_SLACK_NS = 50000;
+
+	// Larger slacks are clamped to this; it bounds the coalescing search
+	constexpr uint64_t MAX_SLACK_NS = 1000000;
+
+	// Maximum number of queued timers
+	constexpr uint32_t CAPACITY = 256;
+
+	/**
+	 * A high-resolution timer, owned by the caller.  It must stay alive
+	 * while queued; the callback runs from a copy of fn and arg, so it
+	 * may be freed once it has left the queue.
+	 */
+	struct entry {
+		uint64_t soft_ns;  // Deadline: never fires before this
+		uint64_t hard_ns;  // Deadline plus slack: the heap key
+		callback fn;
+		void    *arg;
+		uint32_t index;  // Position in the heap while queued
+	};
+
+	void setup(entry *t, callback fn, void *arg);
+	bool start(entry *t, uint64_t deadline_ns, uint64_t slack_ns = DEFAULT_SLACK_NS);
+	bool cancel(entry *t);
+	bool is_queued(const entry *t);
+
+	void sleep_until(uint64_t deadline_ns, uint64_t slack_ns = DEFAULT_SLACK_NS);
+	void sleep_ns(uint64_t ns, uint64_t slack_ns = DEFAULT_SLACK_NS);
+
+	uint64_t next_deadline_ns(void);
+	void     run(void);
+}  // namespace hrtimer
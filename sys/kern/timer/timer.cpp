@@ -1,30 +1,180 @@
 #include <ktime.h>
 
+#include <arch/amd64/apic/lapic.h>
 #include <arch/amd64/asm/io.h>
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/cpu/percpu.h>
 #include <arch/amd64/idt/idt.h>
+#include <drv/hpet/hpet.h>
+#include <kern/work/work.h>
+
+#include "hrtimer.h"
+#include "timer.h"
 
 // PIT frequency is 1193182 Hz
 #define PIT_FREQUENCY    1193182
 #define TARGET_FREQUENCY 100  // 100Hz = 10ms per tick
 
+#define PIT_CHANNEL0       0x40
+#define PIT_COMMAND        0x43
+#define PIT_CH0_SQUARE     0x36  // Channel 0, lobyte/hibyte, mode 3 (square wave)
+#define PIT_CH0_ONESHOT    0x30  // Channel 0, lobyte/hibyte, mode 0 (terminal count)
+#define PIT_MAX_COUNT      0xFFFF
+#define PIT_MAX_ONESHOT_NS (PIT_MAX_COUNT * time::NS_PER_SECOND / PIT_FREQUENCY)
+
+// Where the timer interrupt comes from, see timer_init()
+enum class event_source : uint8_t {
+	pit_periodic,  // TARGET_FREQUENCY Hz tick; the only mode on the PIT clocksource
+	pit_oneshot,
+	hpet,
+	lapic
+};
+
+static event_source source = event_source::pit_periodic;
+
+// Earliest deadline another CPU asked for; rearm_work applies it on CPU 0.
+// Only used when the event source is a single device (HPET or PIT).
+static uint64_t   remote_ns = ~0ULL;
+static work::item rearm_work;
+
+/**
+ * @brief Load a count into PIT channel 0
+ */
+static void
+    pit_load(uint8_t mode, uint16_t count) {
+	outb(PIT_COMMAND, mode);
+	outb(PIT_CHANNEL0, (uint8_t) (count & 0xFF));         // Low byte
+	outb(PIT_CHANNEL0, (uint8_t) ((count >> 8) & 0xFF));  // High byte
+}
+
 /**
  * @brief Timer interrupt handler
  * 
- * Called on every timer tick (IRQ0). Increments the uptime counter.
+ * Periodic mode: counts a tick for the PIT clocksource, then runs the wheel
+ * and the high-resolution timers (which are then only tick-accurate).
+ * Tickless mode: runs the expired timers of both and arms the timer for
+ * whichever comes next.
  * 
  * @param regs Pointer to saved register state
  */
 static void
     timer_irq_handler(registers_t *regs) {
 	(void) regs;  // Unused
-	time::uptime_tick();
+
+	if( source == event_source::pit_periodic ) {
+		time::uptime_tick();
+		timer::run();
+		hrtimer::run();
+		return;
+	}
+
+	amd64::percpu::get()->timer_armed_ns = ~0ULL;
+	timer::run();
+	hrtimer::run();
+
+	uint64_t next    = timer::next_deadline_ns();
+	uint64_t hr_next = hrtimer::next_deadline_ns();
+	if( hr_next < next )
+		next = hr_next;
+	if( next != ~0ULL )
+		timer::arm(next);
 }
 
+static void
+    rearm(void *arg) {
+	(void) arg;
+
+	uint64_t deadline = __atomic_exchange_n(&remote_ns, ~0ULL, __ATOMIC_ACQ_REL);
+	uint64_t flags    = irq_save();
+	timer::arm(deadline);
+	irq_restore(flags);
+}
+
+namespace timer {
+	/**
+	 * @brief Make sure the timer interrupt fires no later than @p deadline_ns
+	 *
+	 * The PIT counts at most ~55 ms, so a later deadline gets an early
+	 * interrupt that simply re-arms.  A no-op while the tick is periodic.
+	 * Every CPU has its own LAPIC timer and arms it directly; HPET and the
+	 * PIT belong to the boot CPU, so another CPU only records the deadline
+	 * and queues the re-arm there.  Call with interrupts off.
+	 */
+	void arm(uint64_t deadline_ns) {
+		if( source == event_source::pit_periodic )
+			return;
+
+		if( source != event_source::lapic && amd64::percpu::id() != 0 ) {
+			uint64_t cur = __atomic_load_n(&remote_ns, __ATOMIC_RELAXED);
+			while( deadline_ns < cur
+			       && !__atomic_compare_exchange_n(&remote_ns,
+			                                       &cur,
+			                                       deadline_ns,
+			                                       true,
+			                                       __ATOMIC_ACQ_REL,
+			                                       __ATOMIC_RELAXED) ) {
+			}
+			work::queue_on(0, &rearm_work);
+			return;
+		}
+
+		uint64_t *armed_ns = &amd64::percpu::get()->timer_armed_ns;
+		if( deadline_ns >= *armed_ns )
+			return;
+
+		if( source == event_source::lapic ) {
+			amd64::lapic::timer_arm(deadline_ns);
+			*armed_ns = deadline_ns;
+			return;
+		}
+
+		if( source == event_source::hpet ) {
+			hpet::event_arm(deadline_ns);
+			*armed_ns = deadline_ns;
+			return;
+		}
+
+		uint64_t now   = time::now_ns();
+		uint64_t delta = deadline_ns > now ? deadline_ns - now : 0;
+		if( delta > PIT_MAX_ONESHOT_NS )
+			delta = PIT_MAX_ONESHOT_NS;
+
+		uint64_t count = delta * PIT_FREQUENCY / time::NS_PER_SECOND;
+		if( count == 0 )
+			count = 1;
+
+		pit_load(PIT_CH0_ONESHOT, (uint16_t) count);
+		*armed_ns = now + delta;
+	}
+
+	bool is_tickless(void) {
+		return source != event_source::pit_periodic;
+	}
+
+	const char *get_event_source_name(void) {
+		switch( source ) {
+			case event_source::lapic:
+				return amd64::lapic::get_timer_mode_name();
+			case event_source::hpet:
+				return "hpet";
+			case event_source::pit_oneshot:
+				return "pit one-shot";
+			case event_source::pit_periodic:
+				break;
+		}
+		return "pit periodic";
+	}
+}  // namespace timer
+
 /**
- * @brief Initialize the Programmable Interval Timer (PIT)
+ * @brief Initialize the timer interrupt source
  * 
- * Sets up the PIT to generate interrupts at TARGET_FREQUENCY Hz.
- * Also registers the timer IRQ handler.
+ * Selects the clocksource first.  If now_ns() runs off the TSC or HPET the
+ * timer is only armed one-shot for pending timers, from the local APIC when
+ * it has a usable timer, else from HPET comparator 0, else from PIT channel
+ * 0.  On the PIT
+ * clocksource the PIT keeps interrupting at TARGET_FREQUENCY Hz to drive
+ * the uptime counter.
  */
 void
     timer_init(void) {
@@ -36,12 +186,41 @@ void
 
 	// Register the timer interrupt handler (IRQ0)
 	amd64::irq::bind(0, timer_irq_handler);
+	work::setup(&rearm_work, rearm, nullptr);
 
-	// Configure PIT Channel 0 (system timer)
-	// Command: Channel 0, Access mode: lobyte/hibyte, Mode 3 (square wave), Binary
-	outb(0x43, 0x36);
+	// Calibrate the nanosecond clock against the PIT or HPET
+	time::clock_init();
+	amd64::percpu::get()->timer_armed_ns = ~0ULL;
+
+	if( time::get_clocksource() != time::clocksource::pit ) {
+		// Mode 0 with no count loaded holds OUT low: no interrupts until arm()
+		outb(PIT_COMMAND, PIT_CH0_ONESHOT);
+
+		if( amd64::lapic::timer_init() != amd64::lapic::timer_mode::none ) {
+			amd64::irq::bind(amd64::irq::LAPIC_TIMER, timer_irq_handler);
+			source = event_source::lapic;
+		} else if( hpet::event_init() ) {
+			source = event_source::hpet;  // Arrives on IRQ0, like the PIT
+		} else {
+			source = event_source::pit_oneshot;
+		}
+		return;
+	}
+
+	pit_load(PIT_CH0_SQUARE, divisor);
+}
+
+/**
+ * @brief Start the timer interrupt on an application processor
+ *
+ * With the LAPIC as event source every CPU counts down to its own
+ * deadlines, so the AP programs its timer the same way the boot CPU did;
+ * the calibration is shared.  HPET and the PIT stay with the boot CPU.
+ */
+void
+    timer_init_cpu(void) {
+	amd64::percpu::get()->timer_armed_ns = ~0ULL;
 
-	// Send divisor
-	outb(0x40, (uint8_t) (divisor & 0xFF));         // Low byte
-	outb(0x40, (uint8_t) ((divisor >> 8) & 0xFF));  // High byte
+	if( source == event_source::lapic )
+		amd64::lapic::timer_init();
 }
@@ -1,4 +1,53 @@
 #pragma once
 
+#include <kstddef.h>
+#include <kstdint.h>
+
+void
+    timer_init(void);
 void
-    timer_init(void);
\ No newline at end of file
+    timer_init_cpu(void);
+
+/*
+ * Tickless timer core.
+ *
+ * Timers sit in a hierarchical wheel (8 levels of 64 slots, each level 8
+ * times coarser than the one below) and the timer interrupt is programmed
+ * one-shot for the earliest pending slot.  Insert and cancel are O(1).  A
+ * timer is rounded up to the granularity of the level it lands in, so
+ * far-off timers never fire early and neighbouring ones share a slot and
+ * a single interrupt.
+ */
+namespace timer {
+	using callback = void (*)(void *arg);
+
+	// Resolution of the wheel; deadlines are rounded up to a whole tick
+	constexpr uint64_t TICK_NS = 1000000ULL;
+
+	/**
+	 * A wheel timer, owned by the caller.  It must stay alive while it is
+	 * pending and is only touched by the wheel between add() and expiry.
+	 */
+	struct entry {
+		entry   *next;
+		entry  **pprev;    // nullptr while not queued
+		uint64_t expires;  // Wheel tick of the slot it sits in
+		uint32_t slot;
+		callback fn;
+		void    *arg;
+	};
+
+	void setup(entry *t, callback fn, void *arg);
+	void add(entry *t, uint64_t deadline_ns);
+	bool add(uint64_t deadline_ns, callback fn, void *arg = nullptr);
+	bool cancel(entry *t);
+	bool is_pending(const entry *t);
+
+	uint64_t next_deadline_ns(void);
+	void     run(void);
+
+	// Implemented by the interrupt source in timer.cpp
+	void        arm(uint64_t deadline_ns);
+	bool        is_tickless(void);
+	const char *get_event_source_name(void);
+}  // namespace timer
\ No newline at end of file
@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kbitmap.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/irqflags.h>
+#include <kern/sync/spinlock.h>
+
+#include "timer.h"
+
+/*
+ * Wheel layout (after the Linux timer wheel): level n has LVL_SIZE slots
+ * of 8^n ticks each.  A timer goes to the lowest level whose range covers
+ * it, rounded up to that level's granularity, and is never cascaded down
+ * again.  The worst-case slack is therefore about 1/8 of the remaining
+ * time, which is what lets distant timers share interrupts.
+ */
+#define LVL_CLK_SHIFT 3
+#define LVL_CLK_DIV   (1ULL << LVL_CLK_SHIFT)
+#define LVL_CLK_MASK  (LVL_CLK_DIV - 1)
+#define LVL_BITS      6
+#define LVL_SIZE      (1ULL << LVL_BITS)
+#define LVL_MASK      (LVL_SIZE - 1)
+#define LVL_DEPTH     8
+#define WHEEL_SIZE    (LVL_SIZE * LVL_DEPTH)
+
+#define LVL_SHIFT(n) ((n) * LVL_CLK_SHIFT)
+#define LVL_GRAN(n)  (1ULL << LVL_SHIFT(n))
+#define LVL_START(n) ((LVL_SIZE - 1) << (((n) - 1) * LVL_CLK_SHIFT))
+#define LVL_OFFS(n)  ((n) * LVL_SIZE)
+
+// ~36 hours at 1 ms ticks; anything later is clamped to the last slot
+#define WHEEL_TIMEOUT_CUTOFF LVL_START(LVL_DEPTH)
+#define WHEEL_TIMEOUT_MAX    (WHEEL_TIMEOUT_CUTOFF - LVL_GRAN(LVL_DEPTH - 1))
+
+// Fire-and-forget timers handed out by add(deadline, fn, arg)
+#define POOL_SIZE 64
+
+namespace timer {
+	static entry   *wheel[WHEEL_SIZE];
+	static uint64_t pending_map[kbitmap::words_for(WHEEL_SIZE)];
+	static size_t   pending_count = 0;
+
+	// Next wheel tick to be processed
+	static uint64_t clk = 0;
+
+	static entry  pool[POOL_SIZE];
+	static entry *pool_free  = nullptr;
+	static bool   pool_ready = false;
+
+	// Guards the wheel, the clock and the pool; always taken with interrupts off
+	static sync::lock_stats  wheel_stats("timer.wheel");
+	static sync::ticket_lock wheel_lock(&wheel_stats);
+
+	static inline uint64_t now_tick(void) {
+		return time::now_ns() / TICK_NS;
+	}
+
+	static inline bool in_pool(const entry *t) {
+		return t >= pool && t < pool + POOL_SIZE;
+	}
+
+	/**
+	 * @brief Slot for @p expires on level @p lvl, rounded up so it never fires early
+	 */
+	static inline uint32_t
+	    calc_index(uint64_t expires, unsigned lvl, uint64_t *bucket) {
+		expires = (expires >> LVL_SHIFT(lvl)) + 1;
+		*bucket = expires << LVL_SHIFT(lvl);
+		return (uint32_t) (LVL_OFFS(lvl) + (expires & LVL_MASK));
+	}
+
+	static uint32_t wheel_index(uint64_t expires, uint64_t *bucket) {
+		uint64_t delta = expires - clk;
+
+		if( (int64_t) delta < 0 ) {
+			// Already due: the slot processed next
+			*bucket = clk;
+			return (uint32_t) (clk & LVL_MASK);
+		}
+
+		if( delta >= WHEEL_TIMEOUT_CUTOFF )
+			expires = clk + WHEEL_TIMEOUT_MAX;
+
+		unsigned lvl = 0;
+		while( lvl < LVL_DEPTH - 1 && delta >= LVL_START(lvl + 1) )
+			lvl++;
+		return calc_index(expires, lvl, bucket);
+	}
+
+	static void enqueue(entry *t, uint32_t idx, uint64_t bucket) {
+		t->slot    = idx;
+		t->expires = bucket;
+		t->next    = wheel[idx];
+		t->pprev   = &wheel[idx];
+		if( t->next )
+			t->next->pprev = &t->next;
+		wheel[idx] = t;
+
+		kbitmap::set(pending_map, idx);
+		pending_count++;
+	}
+
+	static void detach(entry *t) {
+		*t->pprev = t->next;
+		if( t->next )
+			t->next->pprev = t->pprev;
+		t->next  = nullptr;
+		t->pprev = nullptr;
+	}
+
+	static void dequeue(entry *t) {
+		detach(t);
+		if( !wheel[t->slot] )
+			kbitmap::clear(pending_map, t->slot);
+		pending_count--;
+	}
+
+	/**
+	 * @brief Distance from @p pos_clk to the next pending slot of one level
+	 * @return Number of slots ahead, or -1 if the level is empty
+	 */
+	static int next_pending_bucket(unsigned offset, unsigned pos_clk) {
+		size_t start = offset + pos_clk;
+		size_t end   = offset + LVL_SIZE;
+
+		size_t pos = kbitmap::find_next_set(pending_map, end, start);
+		if( pos < end )
+			return (int) (pos - start);
+
+		pos = kbitmap::find_next_set(pending_map, start, offset);
+		return pos < start ? (int) (pos + LVL_SIZE - start) : -1;
+	}
+
+	/**
+	 * @brief Wheel tick of the earliest pending slot, or ~0 if none
+	 */
+	static uint64_t next_expiry(void) {
+		if( !pending_count )
+			return ~0ULL;
+
+		uint64_t next = ~0ULL;
+		uint64_t c    = clk;
+		for( unsigned lvl = 0; lvl < LVL_DEPTH; lvl++ ) {
+			uint64_t lvl_clk = c & LVL_CLK_MASK;
+			int      pos =
+			    next_pending_bucket(LVL_OFFS(lvl), (unsigned) (c & LVL_MASK));
+
+			if( pos >= 0 ) {
+				uint64_t tmp = (c + (uint64_t) pos) << LVL_SHIFT(lvl);
+				if( tmp < next )
+					next = tmp;
+
+				// Due before this level's clock carries into the next one
+				uint64_t carry = (LVL_CLK_DIV - lvl_clk) & LVL_CLK_MASK;
+				if( (uint64_t) pos <= carry )
+					break;
+			}
+
+			/*
+			 * The next level's current slot was already passed unless this
+			 * level's clock sits exactly on a boundary.
+			 */
+			c = (c >> LVL_CLK_SHIFT) + (lvl_clk ? 1 : 0);
+		}
+		return next;
+	}
+
+	/**
+	 * @brief Catch the wheel clock up after an idle stretch
+	 *
+	 * With no tick the clock only moves when timers run, so it can be far
+	 * behind.  A timer added against a stale clock would land on a level
+	 * that is much too coarse.
+	 */
+	static void forward(void) {
+		uint64_t now = now_tick();
+		if( now <= clk )
+			return;
+
+		uint64_t next = next_expiry();
+		clk           = next < now ? next : now;
+	}
+
+	/**
+	 * @brief Move every slot due at tick @p clk onto @p heads
+	 * @return Number of lists collected
+	 */
+	static unsigned collect(entry **heads) {
+		unsigned levels = 0;
+		uint64_t c      = clk;
+
+		for( unsigned lvl = 0; lvl < LVL_DEPTH; lvl++ ) {
+			uint32_t idx = (uint32_t) (LVL_OFFS(lvl) + (c & LVL_MASK));
+
+			if( kbitmap::test(pending_map, idx) ) {
+				kbitmap::clear(pending_map, idx);
+				heads[levels]        = wheel[idx];
+				heads[levels]->pprev = &heads[levels];
+				wheel[idx]           = nullptr;
+				levels++;
+			}
+
+			// Higher levels only turn over when this one wraps
+			if( c & LVL_CLK_MASK )
+				break;
+			c >>= LVL_CLK_SHIFT;
+		}
+		return levels;
+	}
+
+	/**
+	 * @brief Run the timers collected on @p head
+	 *
+	 * Called with the lock held; it is dropped around each callback.  The
+	 * list lives on the caller's stack, so a cancel() on another CPU in
+	 * the meantime unlinks through pprev as usual.
+	 */
+	static void expire(entry **head) {
+		while( *head ) {
+			entry   *t   = *head;
+			callback fn  = t->fn;
+			void    *arg = t->arg;
+
+			detach(t);
+			pending_count--;
+
+			if( in_pool(t) ) {
+				t->next   = pool_free;
+				pool_free = t;
+			}
+
+			sync::unlock(&wheel_lock);
+			fn(arg);
+			sync::lock(&wheel_lock);
+		}
+	}
+
+	/**
+	 * @brief Queue @p t with the lock held
+	 * @return Wheel tick of the slot it landed in
+	 */
+	static uint64_t queue(entry *t, uint64_t deadline_ns) {
+		if( t->pprev )
+			dequeue(t);
+
+		forward();
+
+		uint64_t bucket;
+		uint32_t idx = wheel_index(deadline_ns / TICK_NS, &bucket);
+		enqueue(t, idx, bucket);
+		return bucket;
+	}
+
+	/**
+	 * @brief Prepare a caller-owned timer
+	 */
+	void setup(entry *t, callback fn, void *arg) {
+		t->next    = nullptr;
+		t->pprev   = nullptr;
+		t->expires = 0;
+		t->slot    = 0;
+		t->fn      = fn;
+		t->arg     = arg;
+	}
+
+	/**
+	 * @brief Queue @p t to run at @p deadline_ns (now_ns() time)
+	 *
+	 * A timer that is already pending is moved.
+	 */
+	void add(entry *t, uint64_t deadline_ns) {
+		uint64_t flags  = sync::lock_irqsave(&wheel_lock);
+		uint64_t bucket = queue(t, deadline_ns);
+		sync::unlock(&wheel_lock);
+
+		arm(bucket * TICK_NS);
+		irq_restore(flags);
+	}
+
+	/**
+	 * @brief Run @p fn(@p arg) at @p deadline_ns using a timer from the internal pool
+	 * @return False if the pool is exhausted
+	 */
+	bool add(uint64_t deadline_ns, callback fn, void *arg) {
+		uint64_t flags  = sync::lock_irqsave(&wheel_lock);
+		uint64_t bucket = 0;
+
+		if( !pool_ready ) {
+			for( size_t i = POOL_SIZE; i-- > 0; ) {
+				pool[i].next = pool_free;
+				pool_free    = &pool[i];
+			}
+			pool_ready = true;
+		}
+
+		entry *t = pool_free;
+		if( t ) {
+			pool_free = t->next;
+			setup(t, fn, arg);
+			bucket = queue(t, deadline_ns);
+		}
+		sync::unlock(&wheel_lock);
+
+		if( t )
+			arm(bucket * TICK_NS);
+		irq_restore(flags);
+		return t != nullptr;
+	}
+
+	/**
+	 * @brief Remove @p t from the wheel
+	 *
+	 * Does not wait for a callback that is already running on another CPU.
+	 *
+	 * @return True if it was pending
+	 */
+	bool cancel(entry *t) {
+		uint64_t flags = sync::lock_irqsave(&wheel_lock);
+
+		bool was_pending = t->pprev != nullptr;
+		if( was_pending )
+			dequeue(t);
+
+		sync::unlock_irqrestore(&wheel_lock, flags);
+		return was_pending;
+	}
+
+	bool is_pending(const entry *t) {
+		return t->pprev != nullptr;
+	}
+
+	/**
+	 * @brief now_ns() time of the earliest pending timer, or ~0 if none
+	 */
+	uint64_t next_deadline_ns(void) {
+		uint64_t flags = sync::lock_irqsave(&wheel_lock);
+		uint64_t next  = next_expiry();
+		sync::unlock_irqrestore(&wheel_lock, flags);
+		return next == ~0ULL ? next : next * TICK_NS;
+	}
+
+	/**
+	 * @brief Run every timer that is due
+	 *
+	 * Called from the timer interrupt.  After an idle stretch the wheel
+	 * clock is forwarded straight to the next pending slot instead of
+	 * stepping through every tick in between.  The clock moves past a slot
+	 * before its timers fire, so two CPUs never collect the same slot, and
+	 * callbacks run with the wheel unlocked so they may add timers again.
+	 */
+	void run(void) {
+		uint64_t flags = sync::lock_irqsave(&wheel_lock);
+		uint64_t now   = now_tick();
+		entry   *heads[LVL_DEPTH];
+
+		while( now >= clk ) {
+			if( now - clk > 2 ) {
+				uint64_t next = next_expiry();
+				if( next > now ) {
+					clk = now + 1;
+					break;
+				}
+				clk = next;
+			}
+
+			unsigned levels = collect(heads);
+			clk++;
+			while( levels-- )
+				expire(&heads[levels]);
+		}
+
+		sync::unlock_irqrestore(&wheel_lock, flags);
+	}
+}  // namespace timer
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "vdso.h"
+
+#include <kmemcpy.h>
+#include <ktime.h>
+
+#ifdef ARCH_AMD64
+#	include <arch/amd64/user/user.h>
+#endif
+#include <dbg/logger.h>
+
+extern "C" {
+extern const uint8_t vdso_text[];
+extern const uint8_t vdso_text_end[];
+}
+
+namespace vdso {
+	alignas(SIZE) static uint8_t page[SIZE];
+
+	static inline data *vvar(void) {
+		return (data *) page;
+	}
+
+	/**
+	 * @brief Seconds since the Unix epoch for a proleptic Gregorian date
+	 */
+	static uint64_t unix_seconds(const time::bios_time &t) {
+		// Days from civil, counting years from March so Feb 29 comes last
+		int64_t  y   = (int64_t) t.year - (t.month <= 2 ? 1 : 0);
+		int64_t  era = (y >= 0 ? y : y - 399) / 400;
+		uint64_t yoe = (uint64_t) (y - era * 400);
+		uint64_t mp  = (uint64_t) (t.month > 2 ? t.month - 3 : t.month + 9);
+		uint64_t doy = (153 * mp + 2) / 5 + t.day - 1;
+		uint64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+		int64_t  days = era * 146097 + (int64_t) doe - 719468;
+
+		return (uint64_t) days * 86400 + t.hour * 3600ULL + t.minute * 60ULL
+		     + t.second;
+	}
+
+	/**
+	 * @brief Copy the current now_ns() conversion into the page
+	 *
+	 * Call again whenever the clocksource or its parameters change.  Only
+	 * the TSC can be read from ring 3; with any other source the page
+	 * tells the reader to use SYS_TIME.
+	 */
+	void update_clock(void) {
+		time::clock_params p;
+		time::get_clock_params(&p);
+
+		data *d = vvar();
+		__atomic_store_n(&d->seq, d->seq + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+
+		d->clock_mode = time::get_clocksource() == time::clocksource::tsc
+		                    ? CLOCK_MODE_TSC
+		                    : CLOCK_MODE_SYSCALL;
+		d->base_count = p.base_count;
+		d->base_ns    = p.base_ns;
+		d->mult       = p.mult;
+
+		__atomic_store_n(&d->seq, d->seq + 1, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Unix time in nanoseconds at which now_ns() read zero
+	 */
+	uint64_t boot_epoch_ns(void) {
+		return vvar()->boot_epoch_ns;
+	}
+
+	/**
+	 * @brief Fill the page and map it into the user window
+	 *
+	 * Must run after the clocksource is chosen and the user window is set
+	 * up.
+	 */
+	bool init(void) {
+		size_t len = (size_t) (vdso_text_end - vdso_text);
+		if( len > SIZE - TEXT_OFFSET )
+			return false;
+		kstring::memcpy(page + TEXT_OFFSET, vdso_text, len);
+
+		time::bios_time now;
+		time::get_bios(&now);
+		uint64_t wall_ns = unix_seconds(now) * time::NS_PER_SECOND;
+
+		data *d          = vvar();
+		d->boot_epoch_ns = wall_ns - time::now_ns();
+		d->pid           = 1;  // What sys_getpid() reports until there are tasks
+		update_clock();
+
+#ifdef ARCH_AMD64
+		if( !amd64::user::map_vdso(page) )
+			return false;
+#endif
+
+		logger::debug::printf("vdso",
+		                      "info",
+		                      "vDSO at 0x%llx, clock via %s\n",
+		                      (uint64_t) page,
+		                      d->clock_mode == CLOCK_MODE_TSC ? "TSC" : "syscall");
+		return true;
+	}
+}  // namespace vdso
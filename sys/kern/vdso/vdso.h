@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstddef.h>
+#include <kstdint.h>
+
+/*
+ * vDSO: a page ring 3 can read but not write.
+ *
+ * The first half holds the data read-only syscalls would return, the
+ * second half the code that reads it.  The clock fields are covered by a
+ * seqlock: the kernel makes seq odd, rewrites them and makes it even
+ * again, and a reader retries until it sees the same even seq before and
+ * after its reads.
+ *
+ * There are no address spaces yet, so "every address space" is the user
+ * window, which maps the page at amd64::user::VDSO_OFFSET.
+ */
+namespace vdso {
+	// How ring 3 gets the time; the layout is shared with vdso.asm
+	constexpr uint32_t CLOCK_MODE_TSC     = 0;  // Scale the TSC itself
+	constexpr uint32_t CLOCK_MODE_SYSCALL = 1;  // Fall back to SYS_TIME
+
+	struct data {
+		volatile uint32_t seq;         // Odd while an update is in progress
+		uint32_t          clock_mode;  // CLOCK_MODE_*
+		uint64_t          base_count;  // now_ns() parameters, see ktime.h
+		uint64_t          base_ns;
+		uint64_t          mult;
+		uint64_t          boot_epoch_ns;  // Unix time at now_ns() == 0
+		uint64_t          pid;            // Constant for the task
+	};
+
+	static_assert(__builtin_offsetof(data, pid) == 40, "vdso.asm hardcodes the layout");
+
+	constexpr size_t SIZE        = 4096;
+	constexpr size_t TEXT_OFFSET = SIZE / 2;
+
+	// Entry points, as offsets into the page
+	constexpr size_t ENTRY_CLOCK_NS = TEXT_OFFSET;       // uint64_t (clock)
+	constexpr size_t ENTRY_GETPID   = TEXT_OFFSET + 16;  // uint64_t (void)
+
+	bool     init(void);
+	void     update_clock(void);
+	uint64_t boot_epoch_ns(void);
+}  // namespace vdso
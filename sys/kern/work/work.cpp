@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "work.h"
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/sched/sched.h>
+
+namespace work {
+	struct alignas(64) cpu_queue {
+		item *head;
+		bool  running;  // Set while run() drains this CPU's queue
+	};
+
+	static cpu_queue queues[amd64::madt::MAX_CPUS];
+
+	static inline cpu_queue *this_queue(void) {
+		return &queues[amd64::percpu::id()];
+	}
+
+	void setup(item *w, callback fn, void *arg) {
+		w->next   = nullptr;
+		w->fn     = fn;
+		w->arg    = arg;
+		w->queued = false;
+	}
+
+	static void push(cpu_queue *q, item *w) {
+		item *head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+		do {
+			w->next = head;
+		} while( !__atomic_compare_exchange_n(
+		    &q->head, &head, w, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED) );
+	}
+
+	/**
+	 * @brief Queue @p w on the calling CPU
+	 *
+	 * Safe from interrupt handlers.  An item that is already queued is
+	 * left where it is and runs once.
+	 *
+	 * @return False if it was already queued
+	 */
+	bool queue(item *w) {
+		if( __atomic_exchange_n(&w->queued, true, __ATOMIC_ACQ_REL) )
+			return false;
+
+		push(this_queue(), w);
+		return true;
+	}
+
+	/**
+	 * @brief Queue @p w on CPU @p cpu
+	 *
+	 * Safe from interrupt handlers.  A CPU other than the caller is sent
+	 * an IPI, so the item runs on the way out of it.
+	 *
+	 * @return False if it was already queued
+	 */
+	bool queue_on(uint32_t cpu, item *w) {
+		if( cpu == amd64::percpu::id() )
+			return queue(w);
+		if( cpu >= amd64::madt::MAX_CPUS )
+			return false;
+		if( __atomic_exchange_n(&w->queued, true, __ATOMIC_ACQ_REL) )
+			return false;
+
+		push(&queues[cpu], w);
+		amd64::smp::kick(cpu);
+		return true;
+	}
+
+	bool is_queued(const item *w) {
+		return w->queued;
+	}
+
+	static bool claim(cpu_queue *q) {
+		uint64_t flags   = irq_save();
+		bool     claimed = !q->running;
+		q->running       = true;
+		irq_restore(flags);
+		return claimed;
+	}
+
+	static void drain(cpu_queue *q) {
+		for( ;; ) {
+			item *list =
+			    __atomic_exchange_n(&q->head, nullptr, __ATOMIC_ACQUIRE);
+			if( !list )
+				return;
+
+			item *fifo = nullptr;
+			while( list ) {
+				item *next = list->next;
+				list->next = fifo;
+				fifo       = list;
+				list       = next;
+			}
+
+			while( fifo ) {
+				item *w = fifo;
+				fifo    = w->next;
+				__atomic_store_n(&w->queued, false, __ATOMIC_RELEASE);
+				w->fn(w->arg);
+			}
+		}
+	}
+
+	/**
+	 * @brief Run everything queued on the calling CPU, oldest first
+	 *
+	 * Items queued while this runs are picked up before it returns.  An
+	 * item is marked idle before its callback runs, so it may queue itself
+	 * again.  If the queue is already being drained further up the stack
+	 * (an interrupt arrived during a run), this returns at once and the
+	 * outer run picks the work up, so callbacks never nest.  Preemption
+	 * is off throughout, so a thread switch cannot leave the queue
+	 * claimed by a thread that is not running.
+	 */
+	void run(void) {
+		cpu_queue *q = this_queue();
+
+		// Work queued after the last drain but before running was cleared
+		// found the queue busy, so look again after letting go
+		sched::preempt_disable();
+		while( claim(q) ) {
+			drain(q);
+			q->running = false;
+			if( !__atomic_load_n(&q->head, __ATOMIC_ACQUIRE) )
+				break;
+		}
+		sched::preempt_enable();
+	}
+
+	/**
+	 * @brief Run pending work on the way out of an interrupt
+	 *
+	 * Called by the interrupt dispatcher after the EOI.  Interrupts are
+	 * enabled while the items run, so they cannot delay the next one.
+	 */
+	void irq_exit(void) {
+		if( !__atomic_load_n(&this_queue()->head, __ATOMIC_RELAXED) )
+			return;
+
+		__asm__ volatile("sti" : : : "memory");
+		run();
+		__asm__ volatile("cli" : : : "memory");
+	}
+}  // namespace work
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <kstdint.h>
+
+/*
+ * Deferred work (bottom halves).
+ *
+ * An interrupt handler does the minimum with interrupts off and queues the
+ * rest as a work item.  Queued items run once the interrupt has been
+ * acknowledged, with interrupts back on, before returning to the
+ * interrupted code; run() drains the queue from any other context too.
+ *
+ * Every CPU has its own queue, a lock-free LIFO that is reversed when
+ * drained, so items run in the order they were queued.  queue_on() puts
+ * an item on another CPU's queue and sends that CPU an IPI to run it.
+ */
+namespace work {
+	using callback = void (*)(void *arg);
+
+	/**
+	 * A work item, owned by the caller.  It must stay alive while queued.
+	 */
+	struct item {
+		item         *next;
+		callback      fn;
+		void         *arg;
+		volatile bool queued;
+	};
+
+	void setup(item *w, callback fn, void *arg);
+	bool queue(item *w);
+	bool queue_on(uint32_t cpu, item *w);
+	bool is_queued(const item *w);
+
+	void run(void);
+	void irq_exit(void);
+}  // namespace work
@@ -14,6 +14,8 @@
 #include <kprint.h>
 #include <kstrcmp.h>
 
+#include <kern/sync/rcu.h>
+
 // Commands import
 #include "fs/cat.h"
 #include "fs/cd.h"
@@ -25,14 +27,29 @@
 #include "hardware/reboot.h"
 #include "hardware/sleep.h"
 #include "info/fetch.h"
+#include "info/irqstat.h"
+#include "info/kstat.h"
+#include "info/lockstat.h"
+#include "info/sysprof.h"
+#include "info/threads.h"
 #include "info/time.h"
 #include "sys/clear.h"
 #include "sys/echo.h"
 #include "sys/help.h"
 #include "sys/history.h"
+#include "test/test_fpu.h"
 #include "test/test_graphics.h"
+#include "test/test_hrtimer.h"
+#include "test/test_locks.h"
+#include "test/test_parallel.h"
+#include "test/test_rand.h"
+#include "test/test_rcu.h"
+#include "test/test_ring.h"
+#include "test/test_sched.h"
+#include "test/test_syscall.h"
+#include "test/test_vdso.h"
 
-struct Command commands[] = {
+static const struct Command builtin_commands[] = {
     // System
     {"help", "Show this help message", "System", cmd_help},
     {"clear", "Clear the screen", "System", cmd_clear},
@@ -48,9 +65,24 @@ struct Command commands[] = {
     // Info
     {"fetch", "View system information", "Info", cmd_fetch},
     {"time", "Show current date and time", "Info", cmd_time},
+    {"irqstat", "Show interrupt rates and handler times", "Info", cmd_irqstat},
+    {"kstat", "Dump kernel statistics as name, kind and value", "Info", cmd_kstat},
+    {"lockstat", "Show the most contended spinlocks", "Info", cmd_lockstat},
+    {"sysprof", "Show syscall rates and latencies", "Info", cmd_sysprof},
+    {"threads", "List kernel threads and switch counts", "Info", cmd_threads},
 
     // Test
+    {"test_fpu", "Check and time lazy FPU switching", "Test", cmd_test_fpu},
     {"test_graphics", "Test the graphics driver", "Test", cmd_test_graphics},
+    {"test_hrtimer", "Measure high-resolution timer jitter", "Test", cmd_test_hrtimer},
+    {"test_locks", "Time the spinlocks under contention", "Test", cmd_test_locks},
+    {"test_parallel", "Measure parallel_for scaling over the CPUs", "Test", cmd_test_parallel},
+    {"test_rand", "Benchmark the random number generator", "Test", cmd_test_rand},
+    {"test_rcu", "Check RCU and time its read side and grace periods", "Test", cmd_test_rcu},
+    {"test_ring", "Benchmark batched syscalls via a ring", "Test", cmd_test_ring},
+    {"test_sched", "Benchmark thread switches and wakeups", "Test", cmd_test_sched},
+    {"test_syscall", "Benchmark syscall/sysret against int 0x80", "Test", cmd_test_syscall},
+    {"test_vdso", "Benchmark vDSO reads against syscalls", "Test", cmd_test_vdso},
 
     // Filesystem
     {"ls", "List directory", "Filesystem", cmd_ls},
@@ -60,7 +92,37 @@ struct Command commands[] = {
     {"pwd", "Print current directory", "Filesystem", cmd_pwd},
 };
 
-const size_t NUM_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+static const struct command_table builtin_table = {
+    builtin_commands,
+    sizeof(builtin_commands) / sizeof(builtin_commands[0]),
+};
+
+static const struct command_table *table = &builtin_table;
+
+/**
+ * @brief Current command table; call inside rcu::read_lock()
+ */
+const struct command_table *
+    get_command_table(void) {
+	return rcu::dereference(&table);
+}
+
+/**
+ * @brief Publish @p next as the command table
+ *
+ * Returns once no reader can still see the previous table, so the
+ * caller may free it then.  Writers are not serialized against each
+ * other; replace the table from one thread at a time.
+ *
+ * @return The table @p next replaced
+ */
+const struct command_table *
+    set_command_table(const struct command_table *next) {
+	const struct command_table *old = table;
+	rcu::assign_pointer(&table, next);
+	rcu::synchronize();
+	return old;
+}
 
 int
     handle_command(char *cmd) {
@@ -79,12 +141,21 @@ int
 			++args;
 	}
 
-	for( size_t i = 0; i < NUM_COMMANDS; ++i ) {
-		if( kstring::strcmp(cmd, commands[i].name) == 0 ) {
-			commands[i].handler(args);
-			return 0;
+	command_func_t handler = nullptr;
+	rcu::read_lock();
+	const struct command_table *t = get_command_table();
+	for( size_t i = 0; i < t->count; ++i ) {
+		if( kstring::strcmp(cmd, t->entries[i].name) == 0 ) {
+			handler = t->entries[i].handler;
+			break;
 		}
 	}
+	rcu::read_unlock();
+
+	if( handler ) {
+		handler(args);
+		return 0;
+	}
 
 	kstd::printf("Unknown command: '%s'\n", cmd);
 	return -1;
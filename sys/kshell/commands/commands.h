@@ -25,8 +25,21 @@ struct Command {
 #define CMD_BUFFER_SIZE 512
 #define MAX_HISTORY     128
 
-extern struct Command commands[];
-extern const size_t   NUM_COMMANDS;
+struct command_table {
+	const struct Command *entries;
+	size_t                count;
+};
+
+/*
+ * The table handle_command() and help search is published with RCU, so
+ * it can be replaced while other CPUs run commands.  Look it up and use
+ * its entries between rcu::read_lock() and rcu::read_unlock(); a handler
+ * is copied out and called after read_unlock(), since handlers may sleep.
+ */
+const struct command_table *
+    get_command_table(void);
+const struct command_table *
+    set_command_table(const struct command_table *next);
 
 int
     handle_command(char *cmd);
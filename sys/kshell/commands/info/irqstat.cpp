@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ksleep.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/idt/idt.h>
+#include <arch/amd64/idt/irqstat.h>
+
+namespace stats = amd64::irq::stats;
+
+// Sampling window unless given on the command line, in milliseconds
+#define DEFAULT_WINDOW_MS 1000
+#define MAX_WINDOW_MS     60000
+
+// How many of the costliest IRQs to list
+#define TOP_OFFENDERS 3
+
+static const char *const irq_names[amd64::irq::COUNT] = {
+    "timer",  "keyboard", "cascade", "com2",   "com1",  "lpt2",
+    "floppy", "lpt1",     "rtc",     "acpi",   "irq10", "irq11",
+    "mouse",  "fpu",      "ata0",    "ata1",   "lapic timer", "ipi"};
+
+static stats::summary before[amd64::irq::COUNT];
+static stats::summary after[amd64::irq::COUNT];
+
+static double to_us(uint64_t cycles, double tsc_hz) {
+	return (double) cycles * 1e6 / tsc_hz;
+}
+
+/**
+ * @brief Show interrupt rates and handler times
+ *
+ * Counts the interrupts of each IRQ over a sampling window, then prints
+ * the rate over the window and the handler time distribution since boot.
+ * The TSC is measured against now_ns() over the same window to turn
+ * cycles into time.
+ */
+void
+    cmd_irqstat(const char *args) {
+	int window_ms = DEFAULT_WINDOW_MS;
+	if( args && *args ) {
+		window_ms = kstd::atoi(args);
+		if( window_ms <= 0 )
+			window_ms = DEFAULT_WINDOW_MS;
+		if( window_ms > MAX_WINDOW_MS )
+			window_ms = MAX_WINDOW_MS;
+	}
+
+	for( int irq = 0; irq < amd64::irq::COUNT; irq++ )
+		stats::collect(irq, &before[irq]);
+	uint64_t ns0  = time::now_ns();
+	uint64_t tsc0 = rdtsc_ordered();
+
+	unistd::sleep::sleep(window_ms);
+
+	uint64_t tsc1 = rdtsc_ordered();
+	uint64_t ns1  = time::now_ns();
+	for( int irq = 0; irq < amd64::irq::COUNT; irq++ )
+		stats::collect(irq, &after[irq]);
+
+	double seconds = (double) (ns1 - ns0) / (double) time::NS_PER_SECOND;
+	double tsc_hz  = (double) (tsc1 - tsc0) / seconds;
+	double window  = (double) (tsc1 - tsc0);
+
+	kstd::printf("Controller: %s, window %.2f s, TSC %.0f MHz\n",
+	             amd64::irq::get_controller_name(),
+	             seconds,
+	             tsc_hz / 1e6);
+	kstd::printf("%-12s %10s %9s %9s %9s %9s\n",
+	             "irq",
+	             "total",
+	             "rate/s",
+	             "p50 us",
+	             "p99 us",
+	             "max us");
+
+	for( int irq = 0; irq < amd64::irq::COUNT; irq++ ) {
+		const stats::summary *s = &after[irq];
+		if( s->count == 0 )
+			continue;
+
+		uint64_t delta = s->count - before[irq].count;
+		kstd::printf("%-12s %10llu %9.1f %9.2f %9.2f %9.2f\n",
+		             irq_names[irq],
+		             s->count,
+		             (double) delta / seconds,
+		             to_us(kstat::hist::percentile(s, 50), tsc_hz),
+		             to_us(kstat::hist::percentile(s, 99), tsc_hz),
+		             to_us(s->max_cycles, tsc_hz));
+	}
+
+	// Costliest IRQs over the window, by total handler time
+	bool listed[amd64::irq::COUNT] = {};
+	kstd::puts("Top offenders:");
+	for( int rank = 0; rank < TOP_OFFENDERS; rank++ ) {
+		int      worst        = -1;
+		uint64_t worst_cycles = 0;
+		for( int irq = 0; irq < amd64::irq::COUNT; irq++ ) {
+			uint64_t spent = after[irq].cycles - before[irq].cycles;
+			if( !listed[irq] && spent > worst_cycles ) {
+				worst        = irq;
+				worst_cycles = spent;
+			}
+		}
+		if( worst < 0 )
+			break;
+		listed[worst] = true;
+
+		uint64_t runs = after[worst].count - before[worst].count;
+		kstd::printf("  %-12s %6.3f%% of CPU, %.2f us per interrupt\n",
+		             irq_names[worst],
+		             100.0 * (double) worst_cycles / window,
+		             to_us(worst_cycles / (runs ? runs : 1), tsc_hz));
+	}
+}
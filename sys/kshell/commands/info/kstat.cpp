@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kprint.h>
+#include <kstrcmp.h>
+#include <kstrlen.h>
+#include <kstrncmp.h>
+
+#include <kern/stat/kstat.h>
+
+static kstat::entry entries[kstat::MAX_STATS];
+
+/**
+ * @brief Dump the kernel statistics, one per line
+ *
+ * Each line is "name kind value", sorted by name, with nothing else
+ * printed, so the output can be parsed as is.  An argument keeps only
+ * the names that start with it, e.g. `kstat memory.`.
+ */
+void
+    cmd_kstat(const char *args) {
+	const char *prefix = (args && *args) ? args : "";
+	size_t      len    = kstd::strlen(prefix);
+	uint32_t    n      = kstat::collect(entries, kstat::MAX_STATS);
+
+	// Insertion sort; there are only a few hundred at most
+	for( uint32_t i = 1; i < n; i++ ) {
+		kstat::entry e = entries[i];
+		uint32_t     j = i;
+		for( ; j > 0 && kstring::strcmp(entries[j - 1].name, e.name) > 0; j-- )
+			entries[j] = entries[j - 1];
+		entries[j] = e;
+	}
+
+	for( uint32_t i = 0; i < n; i++ ) {
+		const kstat::entry *e = &entries[i];
+		if( kstring::strncmp(e->name, prefix, len) != 0 )
+			continue;
+		kstd::printf(
+		    "%s %s %lld\n", e->name, kstat::get_kind_name(e->type), e->value);
+	}
+}
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kprint.h>
+#include <kstrcmp.h>
+#include <ktime.h>
+
+#include <kern/sync/spinlock.h>
+
+// Records read, and rows shown, longest waits first
+#define MAX_LOCKS 64
+#define MAX_ROWS  16
+
+static sync::lock_stats rows[MAX_LOCKS];
+
+static double to_us(uint64_t cycles, double tsc_hz) {
+	return (double) cycles * 1e6 / tsc_hz;
+}
+
+static uint64_t per(uint64_t total, uint64_t count) {
+	return count ? total / count : 0;
+}
+
+/**
+ * @brief Show the spinlocks that were waited on the longest
+ *
+ * Covers the span since the last reset: boot, or `lockstat reset`.
+ * Only locks that have a lock_stats record are tracked.  Hold times
+ * cover exclusive holders; rwlock readers only add to the counts.
+ */
+void
+    cmd_lockstat(const char *args) {
+	if constexpr( !LOCK_STATS ) {
+		kstd::puts("Built without LOCK_STATS (use MODE=Debug)");
+		return;
+	}
+
+	if( args && kstring::strcmp(args, "reset") == 0 ) {
+		sync::reset();
+		kstd::puts("Lock statistics reset");
+		return;
+	}
+
+	uint64_t ns, tsc;
+	sync::since_reset(&ns, &tsc);
+
+	uint32_t n    = sync::collect(rows, MAX_LOCKS);
+	uint32_t used = 0;
+	for( uint32_t i = 0; i < n; i++ )
+		used += rows[i].acquisitions != 0;
+
+	if( used == 0 || ns == 0 ) {
+		kstd::puts("No tracked lock taken since the last reset");
+		return;
+	}
+
+	double seconds = (double) ns / (double) time::NS_PER_SECOND;
+	double tsc_hz  = (double) tsc / seconds;
+
+	kstd::printf("%u locks taken over %.2f s\n", used, seconds);
+	kstd::printf("%-16s %10s %10s %6s %8s %10s %9s %9s\n",
+	             "name",
+	             "acquired",
+	             "contended",
+	             "cont%",
+	             "spins",
+	             "wait us",
+	             "hold us",
+	             "max us");
+
+	bool listed[MAX_LOCKS] = {};
+	for( uint32_t row = 0; row < MAX_ROWS && row < used; row++ ) {
+		uint32_t worst = n;
+		for( uint32_t i = 0; i < n; i++ ) {
+			if( listed[i] || rows[i].acquisitions == 0 )
+				continue;
+			if( worst == n || rows[i].wait_cycles > rows[worst].wait_cycles
+			    || (rows[i].wait_cycles == rows[worst].wait_cycles
+			        && rows[i].acquisitions > rows[worst].acquisitions) )
+				worst = i;
+		}
+		listed[worst] = true;
+
+		// Spins per contended acquisition, hold time per exclusive hold
+		const sync::lock_stats *s = &rows[worst];
+		kstd::printf("%-16s %10llu %10llu %6.1f %8llu %10.1f %9.3f %9.3f\n",
+		             s->name ? s->name : "?",
+		             s->acquisitions,
+		             s->contended,
+		             100.0 * (double) s->contended / (double) s->acquisitions,
+		             per(s->spins, s->contended),
+		             to_us(s->wait_cycles, tsc_hz),
+		             to_us(per(s->hold_cycles, s->holds), tsc_hz),
+		             to_us(s->max_hold_cycles, tsc_hz));
+	}
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kprint.h>
+#include <kstrcmp.h>
+#include <ktime.h>
+
+#include <kern/syscall/integration.h>
+#include <kern/syscall/profile.h>
+
+namespace profile = syscall::profile;
+
+// Rows shown, costliest first
+#define MAX_ROWS 20
+
+static profile::summary rows[SYSCALL_MAX_COUNT];
+
+static double to_us(uint64_t cycles, double tsc_hz) {
+	return (double) cycles * 1e6 / tsc_hz;
+}
+
+/**
+ * @brief Show per-syscall call rates and durations, top-style
+ *
+ * Everything covers the span since the last reset: boot, or
+ * `sysprof reset`.  Rows are ordered by total time spent in the handler.
+ * The TSC is measured against now_ns() over the same span to turn cycles
+ * into time.
+ */
+void
+    cmd_sysprof(const char *args) {
+	if constexpr( !SYSCALL_STATS ) {
+		kstd::puts("Built without SYSCALL_STATS (use MODE=Debug)");
+		return;
+	}
+
+	if( args && kstring::strcmp(args, "reset") == 0 ) {
+		syscall::infrastructure::reset_stats();
+		kstd::puts("Syscall statistics reset");
+		return;
+	}
+
+	uint64_t ns, tsc;
+	profile::since_reset(&ns, &tsc);
+
+	uint32_t used = 0;
+	for( uint64_t nr = 0; nr < SYSCALL_MAX_COUNT; nr++ )
+		used += profile::collect(nr, &rows[nr]);
+
+	if( used == 0 || ns == 0 ) {
+		kstd::puts("No syscalls since the last reset");
+		return;
+	}
+
+	double seconds = (double) ns / (double) time::NS_PER_SECOND;
+	double tsc_hz  = (double) tsc / seconds;
+
+	kstd::printf("%u syscalls used over %.2f s\n", used, seconds);
+	kstd::printf("%-4s %-12s %10s %10s %8s %9s %9s %9s\n",
+	             "nr",
+	             "name",
+	             "calls",
+	             "calls/s",
+	             "errors",
+	             "mean us",
+	             "p99 us",
+	             "max us");
+
+	bool listed[SYSCALL_MAX_COUNT] = {};
+	for( uint32_t row = 0; row < MAX_ROWS && row < used; row++ ) {
+		uint64_t worst = SYSCALL_MAX_COUNT;
+		for( uint64_t nr = 0; nr < SYSCALL_MAX_COUNT; nr++ ) {
+			if( listed[nr] || rows[nr].time.count == 0 )
+				continue;
+			if( worst == SYSCALL_MAX_COUNT
+			    || rows[nr].time.cycles > rows[worst].time.cycles )
+				worst = nr;
+		}
+		listed[worst] = true;
+
+		const profile::summary *s    = &rows[worst];
+		const syscall_entry_t  *info = syscall::get_info(worst);
+		kstd::printf("%-4llu %-12s %10llu %10.1f %8llu %9.3f %9.3f %9.3f\n",
+		             worst,
+		             info ? info->name : "?",
+		             s->time.count,
+		             (double) s->time.count / seconds,
+		             s->errors,
+		             to_us(s->time.cycles / s->time.count, tsc_hz),
+		             to_us(kstat::hist::percentile(&s->time, 99), tsc_hz),
+		             to_us(s->time.max_cycles, tsc_hz));
+	}
+}
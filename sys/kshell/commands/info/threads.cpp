@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kprint.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <kern/sched/sched.h>
+
+// Main, one idle thread per CPU and the spawn() pool
+#define MAX_ROWS (1 + amd64::madt::MAX_CPUS + sched::MAX_THREADS)
+
+static sched::thread_info rows[MAX_ROWS];
+
+/**
+ * @brief List the kernel threads, then each CPU's switch counters
+ */
+void
+    cmd_threads(const char *args) {
+	(void) args;
+
+	uint32_t n = sched::list(rows, MAX_ROWS);
+	if( n == 0 ) {
+		kstd::puts("Scheduler not running");
+		return;
+	}
+
+	kstd::printf("%-4s %-4s %-4s %-8s %10s  %s\n",
+	             "id",
+	             "cpu",
+	             "prio",
+	             "state",
+	             "switches",
+	             "name");
+	for( uint32_t i = 0; i < n; i++ ) {
+		const sched::thread_info *t = &rows[i];
+		kstd::printf("%-4u %-4u %-4u %-8s %10llu  %s\n",
+		             t->id,
+		             t->cpu,
+		             t->prio,
+		             sched::get_state_name(t->st),
+		             t->switches,
+		             t->name ? t->name : "?");
+	}
+
+	kstd::printf("\n%-4s %10s %12s %10s %6s\n",
+	             "cpu",
+	             "switches",
+	             "preemptions",
+	             "wakeups",
+	             "ready");
+	for( uint32_t cpu = 0; cpu < amd64::madt::MAX_CPUS; cpu++ ) {
+		sched::cpu_stats s;
+		if( !sched::get_cpu_stats(cpu, &s) )
+			continue;
+		kstd::printf("%-4u %10llu %12llu %10llu %6u\n",
+		             cpu,
+		             s.switches,
+		             s.preemptions,
+		             s.wakeups,
+		             s.ready);
+	}
+}
@@ -15,6 +15,7 @@
 #include <kstring.h>
 
 #include <drv/tty/tty.h>
+#include <kern/sync/rcu.h>
 #include <kshell/commands/commands.h>
 
 void
@@ -22,10 +23,15 @@ void
 	(void) args;
 	kstd::printf("Available commands\n");
 
+	// Printing does not sleep, so the whole listing is one read section
+	rcu::read_lock();
+	const struct command_table *t        = get_command_table();
+	const struct Command       *commands = t->entries;
+
 	// collect categories
 	const char *categories[16];
 	int         num_categories = 0;
-	for( size_t i = 0; i < NUM_COMMANDS; ++i ) {
+	for( size_t i = 0; i < t->count; ++i ) {
 		int found = 0;
 		for( int j = 0; j < num_categories; ++j ) {
 			if( kstring::strcmp(commands[i].cat, categories[j]) == 0 ) {
@@ -40,16 +46,17 @@ void
 	char buf[128];
 	for( int c = 0; c < num_categories; ++c ) {
 		kstd::snprintf(buf, sizeof(buf), "\n[%s]\n", categories[c]);
-		kstd::printf(buf);
-		for( size_t i = 0; i < NUM_COMMANDS; ++i ) {
+		kstd::puts(buf);
+		for( size_t i = 0; i < t->count; ++i ) {
 			if( kstring::strcmp(commands[i].cat, categories[c]) == 0 ) {
 				kstd::snprintf(buf,
 				               sizeof(buf),
 				               " %-12s - %s\n",
 				               commands[i].name,
 				               commands[i].desc);
-				kstd::printf(buf);
+				kstd::puts(buf);
 			}
 		}
 	}
+	rcu::read_unlock();
 }
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+
+#include <arch/amd64/asm/irqflags.h>
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/cpu/instr/fpu.h>
+
+namespace fpu = amd64::fpu;
+
+// Switches per measurement unless given on the command line
+#define DEFAULT_SWITCHES 10000
+#define MAX_SWITCHES     1000000
+
+#define PATTERN_A 0x1111222233334444ULL
+#define PATTERN_B 0x5555666677778888ULL
+
+static fpu::context ctx_a;
+static fpu::context ctx_b;
+
+// xmm15, since compiled code is least likely to hold anything there
+static inline void
+    set_xmm15(uint64_t v) {
+	__asm__ volatile("movq %0, %%xmm15" : : "r"(v) : "xmm15");
+}
+
+static inline uint64_t
+    get_xmm15(void) {
+	uint64_t v;
+	__asm__ volatile("movq %%xmm15, %0" : "=r"(v));
+	return v;
+}
+
+/**
+ * @brief Check and time lazy FPU switching between two contexts
+ *
+ * Each context writes its own value to a vector register; both must read
+ * it back after switching away and back.  Then switches are timed three
+ * ways: neither side touching the FPU (lazy: no save or restore), both
+ * touching it (lazy: #NM plus save and restore), and an eager save and
+ * restore on every switch.  Interrupts are off for the whole run.
+ */
+void
+    cmd_test_fpu(const char *args) {
+	uint64_t switches = DEFAULT_SWITCHES;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			switches = (uint64_t) n;
+		if( switches > MAX_SWITCHES )
+			switches = MAX_SWITCHES;
+	}
+
+	uint64_t      flags = irq_save();
+	fpu::context *prev  = fpu::get_current();
+	fpu::init_context(&ctx_a);
+	fpu::init_context(&ctx_b);
+
+	fpu::switch_to(&ctx_a);
+	set_xmm15(PATTERN_A);
+	fpu::switch_to(&ctx_b);
+	set_xmm15(PATTERN_B);
+	fpu::switch_to(&ctx_a);
+	uint64_t got_a = get_xmm15();
+	fpu::switch_to(&ctx_b);
+	uint64_t got_b = get_xmm15();
+
+	uint64_t t0 = rdtsc_ordered();
+	for( uint64_t i = 0; i < switches; i++ )
+		fpu::switch_to((i & 1) ? &ctx_b : &ctx_a);
+	uint64_t t1 = rdtsc_ordered();
+	for( uint64_t i = 0; i < switches; i++ ) {
+		fpu::switch_to((i & 1) ? &ctx_b : &ctx_a);
+		set_xmm15(i);
+	}
+	uint64_t t2 = rdtsc_ordered();
+	for( uint64_t i = 0; i < switches; i++ ) {
+		fpu::save((i & 1) ? &ctx_a : &ctx_b);
+		fpu::restore((i & 1) ? &ctx_b : &ctx_a);
+	}
+	uint64_t t3 = rdtsc_ordered();
+
+	fpu::switch_to(prev);
+	fpu::release(&ctx_a);
+	fpu::release(&ctx_b);
+	irq_restore(flags);
+
+	kstd::printf("Save method %s, XCR0 0x%llx, %llu byte area\n",
+	             fpu::get_save_method(),
+	             fpu::get_features(),
+	             (uint64_t) fpu::get_area_size());
+	kstd::printf("State kept across switches: %s\n",
+	             got_a == PATTERN_A && got_b == PATTERN_B ? "ok" : "FAILED");
+
+	double n = (double) switches;
+	kstd::printf("%llu switches, cycles per switch:\n", switches);
+	kstd::printf("  lazy, FPU untouched  %8.1f\n", (double) (t1 - t0) / n);
+	kstd::printf("  lazy, FPU used       %8.1f\n", (double) (t2 - t1) / n);
+	kstd::printf("  eager save/restore   %8.1f\n", (double) (t3 - t2) / n);
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <krand.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/irqflags.h>
+#include <kern/timer/hrtimer.h>
+#include <kern/timer/timer.h>
+
+// Samples per mode unless given on the command line
+#define DEFAULT_SAMPLES 200
+#define MAX_SAMPLES     1000
+
+// Deadlines are picked at random this far in the future
+#define MIN_OFFSET_NS 20000
+#define MAX_OFFSET_NS 2000000
+
+static uint64_t errors[MAX_SAMPLES];
+
+// Upper bounds of the histogram buckets, in microseconds; the last is open
+static const uint64_t bucket_us[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+
+#define BUCKETS (sizeof(bucket_us) / sizeof(bucket_us[0]) + 1)
+
+struct sample {
+	volatile bool fired;
+	uint64_t      error_ns;
+	uint64_t      deadline_ns;
+};
+
+static void on_fire(void *arg) {
+	sample *s   = (sample *) arg;
+	s->error_ns = time::now_ns() - s->deadline_ns;
+	s->fired    = true;
+}
+
+static uint64_t random_deadline(void) {
+	uint64_t span = MAX_OFFSET_NS - MIN_OFFSET_NS;
+	return time::now_ns() + MIN_OFFSET_NS + unistd::rand::unsign() % span;
+}
+
+static void sort(uint64_t *v, uint32_t n) {
+	for( uint32_t i = 1; i < n; i++ ) {
+		uint64_t x = v[i];
+		uint32_t j = i;
+		for( ; j > 0 && v[j - 1] > x; j-- )
+			v[j] = v[j - 1];
+		v[j] = x;
+	}
+}
+
+/**
+ * @brief Print the firing error distribution of @p n sorted samples
+ */
+static void report(const char *name, uint64_t *v, uint32_t n) {
+	sort(v, n);
+	kstd::printf("%s: min %llu  p50 %llu  p90 %llu  p99 %llu  max %llu ns\n",
+	             name,
+	             v[0],
+	             v[n / 2],
+	             v[n * 9 / 10],
+	             v[n * 99 / 100],
+	             v[n - 1]);
+
+	uint32_t counts[BUCKETS] = {};
+	for( uint32_t i = 0; i < n; i++ ) {
+		size_t b = 0;
+		while( b < BUCKETS - 1 && v[i] >= bucket_us[b] * 1000 )
+			b++;
+		counts[b]++;
+	}
+
+	for( size_t b = 0; b < BUCKETS; b++ ) {
+		if( b < BUCKETS - 1 )
+			kstd::printf("  < %4llu us  %4u\n", bucket_us[b], counts[b]);
+		else
+			kstd::printf(" >= %4llu us  %4u\n", bucket_us[b - 1], counts[b]);
+	}
+}
+
+/**
+ * @brief Measure how late high-resolution timers fire
+ *
+ * Callback mode records the error inside the timer callback; wakeup mode
+ * measures it after sleep_until() returns, so it also includes the time to
+ * leave hlt and get back to the sleeper.
+ */
+void
+    cmd_test_hrtimer(const char *args) {
+	uint32_t n = DEFAULT_SAMPLES;
+	if( args && *args ) {
+		int v = kstd::atoi(args);
+		if( v > 0 )
+			n = v > MAX_SAMPLES ? MAX_SAMPLES : (uint32_t) v;
+	}
+
+	if( !irq_enabled() ) {
+		kstd::puts("Interrupts are disabled");
+		return;
+	}
+
+	kstd::printf("Event source: %s, clocksource: %s, %u samples per mode\n",
+	             timer::get_event_source_name(),
+	             time::get_clocksource_name(),
+	             n);
+
+	uint32_t taken = 0;
+	for( uint32_t i = 0; i < n; i++ ) {
+		sample         s = {false, 0, random_deadline()};
+		hrtimer::entry t;
+		hrtimer::setup(&t, on_fire, &s);
+		if( !hrtimer::start(&t, s.deadline_ns, 0) )
+			break;
+		irq_wait_for(&s.fired);
+		errors[taken++] = s.error_ns;
+	}
+	if( taken )
+		report("callback", errors, taken);
+
+	for( uint32_t i = 0; i < n; i++ ) {
+		uint64_t deadline = random_deadline();
+		hrtimer::sleep_until(deadline, 0);
+		errors[i] = time::now_ns() - deadline;
+	}
+	report("wakeup", errors, n);
+}
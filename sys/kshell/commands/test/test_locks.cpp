@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/spinlock.h>
+
+// Acquisitions per thread unless given on the command line
+#define DEFAULT_ROUNDS 100000
+#define MAX_ROUNDS     10000000
+
+#define MAX_WORKERS 8
+
+struct contest;
+using section_fn = void (*)(contest *run);
+
+// One lock of each kind; a round uses one of them from every worker
+struct contest {
+	section_fn        section;
+	uint32_t          rounds;
+	sync::ticket_lock ticket;
+	sync::mcs_lock    mcs;
+	sync::rwlock      rw;
+	volatile uint64_t counter;  // Bumped inside the exclusive sections
+	volatile uint64_t sum;      // Where readers put what they read
+	uint64_t          cycles;   // Summed over the workers
+	sched::completion start;
+	sched::completion done[MAX_WORKERS];
+};
+
+struct worker {
+	contest *run;
+	uint32_t slot;
+};
+
+static void take_ticket(contest *run) {
+	uint64_t flags = sync::lock_irqsave(&run->ticket);
+	run->counter   = run->counter + 1;
+	sync::unlock_irqrestore(&run->ticket, flags);
+}
+
+static void take_mcs(contest *run) {
+	sync::mcs_node node;
+	uint64_t       flags = sync::lock_irqsave(&run->mcs, &node);
+	run->counter         = run->counter + 1;
+	sync::unlock_irqrestore(&run->mcs, &node, flags);
+}
+
+static void take_write(contest *run) {
+	uint64_t flags = sync::write_lock_irqsave(&run->rw);
+	run->counter   = run->counter + 1;
+	sync::write_unlock_irqrestore(&run->rw, flags);
+}
+
+static void take_read(contest *run) {
+	uint64_t flags = sync::read_lock_irqsave(&run->rw);
+	run->sum       = run->counter;
+	sync::read_unlock_irqrestore(&run->rw, flags);
+}
+
+static void work_loop(void *arg) {
+	worker  *me  = (worker *) arg;
+	contest *run = me->run;
+
+	sched::wait_for(&run->start);
+	uint64_t t0 = rdtsc_ordered();
+	for( uint32_t i = 0; i < run->rounds; i++ )
+		run->section(run);
+	__atomic_fetch_add(&run->cycles, rdtsc_ordered() - t0, __ATOMIC_RELAXED);
+	sched::complete(&run->done[me->slot]);
+}
+
+/**
+ * @brief Run @p section @p rounds times on each of up to @p cpus CPUs at once
+ * @return False if the exclusive sections lost an increment
+ */
+static bool
+    measure(const char *name, section_fn section, uint32_t rounds, uint32_t cpus) {
+	contest run = {};
+	run.section = section;
+	run.rounds  = rounds;
+
+	worker   workers[MAX_WORKERS];
+	uint32_t started = 0;
+	for( uint32_t cpu = 0; cpu < amd64::madt::MAX_CPUS; cpu++ ) {
+		if( started == cpus || !amd64::smp::is_online(cpu) )
+			continue;
+		workers[started] = {&run, started};
+		if( sched::spawn("lock_worker",
+		                 work_loop,
+		                 &workers[started],
+		                 sched::PRIO_DEFAULT,
+		                 cpu) )
+			started++;
+	}
+	if( started == 0 ) {
+		kstd::puts("Cannot start a worker");
+		return true;
+	}
+
+	uint64_t t0 = time::now_ns();
+	sched::complete(&run.start);
+	for( uint32_t i = 0; i < started; i++ )
+		sched::wait_for(&run.done[i]);
+	uint64_t ns = time::now_ns() - t0;
+
+	uint64_t total = (uint64_t) started * rounds;
+	kstd::printf("%-12s %7u %10.1f %12.1f\n",
+	             name,
+	             started,
+	             (double) ns / (double) total,
+	             (double) run.cycles / (double) total);
+	return section == take_read || run.counter == total;
+}
+
+/**
+ * @brief Time the spinlocks under contention
+ *
+ * Every lock kind is taken in a tight loop by one thread, then by one
+ * thread per online CPU (up to MAX_WORKERS) at once, around a one-word
+ * critical section.  ns/acq is wall time over all acquisitions, the
+ * inverse of throughput; cycles/acq is what each acquisition cost the
+ * thread that made it.  The exclusive kinds also check that no
+ * increment of the shared counter was lost.
+ */
+void
+    cmd_test_locks(const char *args) {
+	if( !sched::is_running() ) {
+		kstd::puts("Scheduler not running");
+		return;
+	}
+
+	uint32_t rounds = DEFAULT_ROUNDS;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			rounds = (uint32_t) n;
+		if( rounds > MAX_ROUNDS )
+			rounds = MAX_ROUNDS;
+	}
+
+	static const struct {
+		const char *name;
+		section_fn  section;
+	} kinds[] = {
+	    {"ticket", take_ticket},
+	    {"mcs", take_mcs},
+	    {"rw write", take_write},
+	    {"rw read", take_read},
+	};
+
+	uint32_t cpus = amd64::smp::online_count();
+	if( cpus > MAX_WORKERS )
+		cpus = MAX_WORKERS;
+
+	kstd::printf("%u acquisitions per thread, up to %u threads\n", rounds, cpus);
+	kstd::printf(
+	    "%-12s %7s %10s %12s\n", "lock", "threads", "ns/acq", "cycles/acq");
+
+	bool exclusive = true;
+	for( const auto &k : kinds ) {
+		exclusive = measure(k.name, k.section, rounds, 1) && exclusive;
+		if( cpus > 1 )
+			exclusive = measure(k.name, k.section, rounds, cpus) && exclusive;
+	}
+	kstd::printf("No increment lost: %s\n", exclusive ? "ok" : "FAILED");
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kmemset.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <kern/memory/memory.h>
+#include <kern/sched/tasks.h>
+
+namespace tasks = sched::tasks;
+
+#define DEFAULT_MIB 16
+#define MAX_MIB     48
+
+// Bytes per piece: big enough to amortize a steal, small enough to balance
+#define GRAIN (64 * 1024)
+
+struct result {
+	uint32_t cpus;
+	double   memset_mibs;
+	double   hash_mibs;
+	uint64_t hash;
+	uint64_t stolen;
+};
+
+// SplitMix64 finalizer: enough arithmetic per word to be compute bound
+static inline uint64_t mix(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+/**
+ * @brief memset [lo, hi) of @p buf with the index of each 4 KiB page
+ *
+ * Same bytes whatever the pieces, so the hash can be compared.
+ */
+static void fill(uint8_t *buf, uint64_t lo, uint64_t hi) {
+	while( lo < hi ) {
+		uint64_t end = (lo / 4096 + 1) * 4096;
+		if( end > hi )
+			end = hi;
+		kstring::memset(buf + lo, (int) ((lo / 4096) & 0xFF), end - lo);
+		lo = end;
+	}
+}
+
+static uint64_t total_stolen(void) {
+	uint64_t n = 0;
+	for( uint32_t cpu = 0; cpu < amd64::madt::MAX_CPUS; cpu++ ) {
+		tasks::cpu_stats s;
+		if( tasks::get_cpu_stats(cpu, &s) )
+			n += s.stolen;
+	}
+	return n;
+}
+
+/**
+ * @brief Fill and then hash @p buf with the pool limited to @p cpus CPUs
+ *
+ * The hash sums mix(index ^ word) over all words, so it does not depend
+ * on how the range was split or in which order the pieces ran.
+ */
+static result measure(uint8_t *buf, uint64_t bytes, uint32_t cpus) {
+	result r   = {};
+	double mib = (double) bytes / (1024.0 * 1024.0);
+	tasks::set_width(cpus);
+	r.cpus = tasks::get_width();
+
+	uint64_t        hash  = 0;
+	const uint64_t *words = (const uint64_t *) buf;
+
+	auto fill_piece = [buf](uint64_t lo, uint64_t hi) { fill(buf, lo, hi); };
+	auto hash_piece = [&hash, words](uint64_t lo, uint64_t hi) {
+		uint64_t sum = 0;
+		for( uint64_t i = lo; i < hi; i++ )
+			sum += mix(i ^ words[i]);
+		__atomic_add_fetch(&hash, sum, __ATOMIC_RELAXED);
+	};
+
+	uint64_t t0 = time::now_ns();
+	tasks::parallel_for(0, bytes, GRAIN, fill_piece);
+	uint64_t t1     = time::now_ns();
+	uint64_t stolen = total_stolen();
+	tasks::parallel_for(0, bytes / 8, GRAIN / 8, hash_piece);
+	uint64_t t2 = time::now_ns();
+
+	r.memset_mibs = mib * 1e9 / (double) (t1 - t0);
+	r.hash_mibs   = mib * 1e9 / (double) (t2 - t1);
+	r.hash        = hash;
+	r.stolen      = total_stolen() - stolen;
+	return r;
+}
+
+/**
+ * @brief Scaling of parallel_for() from one CPU to all of them
+ *
+ * Runs a memset (memory bound) and a hash pass (compute bound) over a
+ * heap buffer, first on the calling CPU alone and then with one more
+ * worker CPU each round.  Speedups are against the one-CPU round.
+ */
+void
+    cmd_test_parallel(const char *args) {
+	uint64_t mib = DEFAULT_MIB;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			mib = (uint64_t) n;
+		if( mib > MAX_MIB )
+			mib = MAX_MIB;
+	}
+
+	uint64_t bytes = mib * 1024 * 1024;
+	uint8_t *buf   = (uint8_t *) memory::malloc(bytes);
+	if( !buf ) {
+		kstd::printf("Cannot allocate %llu MiB\n", mib);
+		return;
+	}
+
+	tasks::set_width(0);
+	uint32_t cpus = tasks::get_width();
+	kstd::printf("%llu MiB, %u CPUs, %u KiB pieces\n", mib, cpus, GRAIN / 1024);
+	kstd::printf("%-5s %12s %8s %12s %8s %8s\n",
+	             "cpus",
+	             "memset MiB/s",
+	             "speedup",
+	             "hash MiB/s",
+	             "speedup",
+	             "steals");
+
+	result base  = {};
+	bool   agree = true;
+	for( uint32_t n = 1; n <= cpus; n++ ) {
+		result r = measure(buf, bytes, n);
+		if( n == 1 )
+			base = r;
+		agree = agree && r.hash == base.hash;
+		kstd::printf("%-5u %12.1f %7.2fx %12.1f %7.2fx %8llu\n",
+		             r.cpus,
+		             r.memset_mibs,
+		             r.memset_mibs / base.memset_mibs,
+		             r.hash_mibs,
+		             r.hash_mibs / base.hash_mibs,
+		             r.stolen);
+	}
+
+	tasks::set_width(0);
+	memory::free(buf);
+	kstd::printf("Hash the same on every round: %s\n", agree ? "ok" : "FAILED");
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kprint.h>
+#include <krand.h>
+#include <ktime.h>
+
+// How long each measurement runs, in seconds
+#define BENCH_SECONDS 0.5
+
+static uint8_t bench_buf[16384];
+
+/**
+ * @brief Print a throughput line from a byte count and elapsed time
+ */
+static void report(const char *name, uint64_t bytes, double seconds) {
+	double mib = (double) bytes / (1024.0 * 1024.0);
+	kstd::printf("%-10s %8.1f MiB/s  (%llu bytes in %.2f s)\n",
+	             name,
+	             mib / seconds,
+	             bytes,
+	             seconds);
+}
+
+void
+    cmd_test_rand(const char *args) {
+	(void) args;
+
+	kstd::printf("Seed source: %s\n", unistd::rand::seed_source());
+
+	// unsign(): one word per call
+	uint64_t bytes = 0;
+	uint32_t acc   = 0;
+	double   start = time::get_uptime_precise();
+	double   now   = start;
+	while( now - start < BENCH_SECONDS ) {
+		for( int i = 0; i < 4096; i++ )
+			acc ^= unistd::rand::unsign();
+		bytes += 4096 * sizeof(uint32_t);
+		now = time::get_uptime_precise();
+	}
+	report("unsign()", bytes, now - start);
+
+	// fill(): bulk bytes
+	bytes = 0;
+	start = time::get_uptime_precise();
+	now   = start;
+	while( now - start < BENCH_SECONDS ) {
+		unistd::rand::fill(bench_buf, sizeof(bench_buf));
+		bytes += sizeof(bench_buf);
+		now = time::get_uptime_precise();
+	}
+	report("fill()", bytes, now - start);
+
+	// Keep the unsign() loop from being optimized away
+	kstd::printf("Checksum: %x\n", acc ^ bench_buf[0]);
+}
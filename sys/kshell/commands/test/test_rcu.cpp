@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/memory/memory.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/rcu.h>
+#include <kern/sync/spinlock.h>
+
+// Updates in the stress run unless given on the command line
+#define DEFAULT_UPDATES 10000
+#define MAX_UPDATES     1000000
+
+#define READ_ROUNDS 1000000
+#define SYNC_ROUNDS 20
+#define MAX_READERS 8
+
+// One published version; check is ~value while it may be read
+struct record {
+	rcu::head rcu;
+	uint64_t  value;
+	uint64_t  check;
+};
+
+struct stress {
+	record           *published;
+	volatile bool     stop;
+	uint64_t          reads;
+	uint64_t          errors;
+	sched::completion start;
+	sched::completion done[MAX_READERS];
+};
+
+struct reader {
+	stress  *run;
+	uint32_t slot;
+};
+
+// Poisons the record first, so a reader that still sees it counts an error
+static void retire(void *arg) {
+	record *r = (record *) arg;
+	r->check  = r->value;
+	memory::free(r);
+}
+
+/**
+ * @brief Read the published record until told to stop
+ *
+ * Versions only go up, so a reader also checks it never sees an older
+ * one after a newer one.
+ */
+static void read_loop(void *arg) {
+	reader *me  = (reader *) arg;
+	stress *run = me->run;
+
+	sched::wait_for(&run->start);
+	uint64_t reads = 0, errors = 0, last = 0;
+	while( !run->stop ) {
+		rcu::read_lock();
+		record  *r     = rcu::dereference(&run->published);
+		uint64_t value = r->value;
+		if( r->check != ~value || value < last )
+			errors++;
+		last = value;
+		rcu::read_unlock();
+		reads++;
+	}
+
+	__atomic_fetch_add(&run->reads, reads, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&run->errors, errors, __ATOMIC_RELAXED);
+	sched::complete(&run->done[me->slot]);
+}
+
+static record *make_record(uint64_t value) {
+	record *r = (record *) memory::malloc(sizeof(record));
+	if( r ) {
+		r->value = value;
+		r->check = ~value;
+	}
+	return r;
+}
+
+/**
+ * @brief Cycles per read-side section, against an uncontended ticket lock
+ */
+static void time_read_side(void) {
+	static record     sample = {{nullptr, nullptr, nullptr}, 1, ~1ULL};
+	record           *ptr    = &sample;
+	sync::ticket_lock lock;
+	uint64_t          sum = 0;
+
+	uint64_t t0 = rdtsc_ordered();
+	for( uint32_t i = 0; i < READ_ROUNDS; i++ ) {
+		rcu::read_lock();
+		sum += rcu::dereference(&ptr)->value;
+		rcu::read_unlock();
+	}
+	uint64_t t1 = rdtsc_ordered();
+	for( uint32_t i = 0; i < READ_ROUNDS; i++ ) {
+		sync::lock(&lock);
+		sum += ptr->value;
+		sync::unlock(&lock);
+	}
+	uint64_t t2 = rdtsc_ordered();
+
+	kstd::printf("Read side, cycles per lookup (%llu reads):\n", sum);
+	kstd::printf("  %-22s %8.1f\n",
+	             "rcu read section",
+	             (double) (t1 - t0) / READ_ROUNDS);
+	kstd::printf("  %-22s %8.1f\n",
+	             "ticket lock",
+	             (double) (t2 - t1) / READ_ROUNDS);
+}
+
+static void time_synchronize(void) {
+	uint64_t total = 0, worst = 0;
+	for( uint32_t i = 0; i < SYNC_ROUNDS; i++ ) {
+		uint64_t t0 = time::now_ns();
+		rcu::synchronize();
+		uint64_t ns = time::now_ns() - t0;
+		total += ns;
+		if( ns > worst )
+			worst = ns;
+	}
+	kstd::printf("synchronize(): %.1f us average, %.1f us worst\n",
+	             (double) total / SYNC_ROUNDS / 1000.0,
+	             (double) worst / 1000.0);
+}
+
+/**
+ * @brief Readers on every CPU while this thread keeps replacing the record
+ */
+static void run_stress(uint32_t updates) {
+	stress run    = {};
+	run.published = make_record(0);
+	if( !run.published ) {
+		kstd::puts("Cannot allocate a record");
+		return;
+	}
+
+	reader   readers[MAX_READERS];
+	uint32_t started = 0;
+	for( uint32_t cpu = 0; cpu < amd64::madt::MAX_CPUS; cpu++ ) {
+		if( started == MAX_READERS || !amd64::smp::is_online(cpu) )
+			continue;
+		readers[started] = {&run, started};
+		if( sched::spawn("rcu_reader",
+		                 read_loop,
+		                 &readers[started],
+		                 sched::PRIO_DEFAULT,
+		                 cpu) )
+			started++;
+	}
+
+	rcu::stats before;
+	rcu::get_stats(&before);
+	uint64_t t0 = time::now_ns();
+	sched::complete(&run.start);
+
+	uint32_t done = 0;
+	for( ; done < updates; done++ ) {
+		record *r = make_record(done + 1);
+		if( !r ) {
+			// Let the retired ones go back to the heap
+			rcu::synchronize();
+			if( !(r = make_record(done + 1)) )
+				break;
+		}
+		record *old = run.published;
+		rcu::assign_pointer(&run.published, r);
+		rcu::call(&old->rcu, retire, old);
+	}
+
+	run.stop = true;
+	for( uint32_t i = 0; i < started; i++ )
+		sched::wait_for(&run.done[i]);
+	uint64_t ns = time::now_ns() - t0;
+
+	// Callbacks run in order, so this one runs after all the others
+	rcu::call(&run.published->rcu, retire, run.published);
+	rcu::synchronize();
+
+	rcu::stats after;
+	rcu::get_stats(&after);
+	kstd::printf("%u updates, %u readers, %llu reads in %llu ms\n",
+	             done,
+	             started,
+	             run.reads,
+	             ns / 1000000);
+	kstd::printf("  %llu grace periods, %llu callbacks run\n",
+	             after.grace_periods - before.grace_periods,
+	             after.invoked - before.invoked);
+	kstd::printf("Readers saw only live records: %s\n",
+	             run.errors ? "FAILED" : "ok");
+}
+
+/**
+ * @brief Check and time RCU
+ *
+ * Times a read-side section against an uncontended lock and
+ * synchronize() on an idle system, then has one reader per CPU read a
+ * published record while this thread replaces it and retires the old
+ * ones through rcu::call().  A retired record is poisoned before it is
+ * freed, so a reader that could still see one would notice.
+ */
+void
+    cmd_test_rcu(const char *args) {
+	if( !sched::is_running() ) {
+		kstd::puts("Scheduler not running");
+		return;
+	}
+
+	uint32_t updates = DEFAULT_UPDATES;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			updates = (uint32_t) n;
+		if( updates > MAX_UPDATES )
+			updates = MAX_UPDATES;
+	}
+
+	rcu::stats s;
+	rcu::get_stats(&s);
+	kstd::printf("%u CPUs in grace periods, %llu so far\n", s.cpus, s.grace_periods);
+
+	time_read_side();
+	time_synchronize();
+	run_stress(updates);
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/user/user.h>
+#include <dbg/logger.h>
+#include <kern/syscall/ring.h>
+
+// Calls per mode unless given on the command line
+#define DEFAULT_ITERATIONS 100000
+#define MAX_ITERATIONS     10000000
+
+// Must match RING_BATCH and RING_OFF in user.asm
+#define RING_BATCH  32
+#define RING_OFFSET 64
+
+extern "C" {
+extern const uint8_t user_ring_bench[];
+extern const uint8_t user_ring_bench_end[];
+}
+
+static const char *const mode_names[] = {
+    "one syscall per call",
+    "ring, SYS_RING_ENTER per batch",
+    "ring, kernel poller",
+};
+
+/**
+ * @brief Run user_ring_bench once in @p mode
+ * @return Cycles per call, or a negative value if the run failed
+ */
+static double
+    run_mode(uint64_t mode, uint64_t iterations) {
+	uint8_t           *page = (uint8_t *) amd64::user::data();
+	volatile uint64_t *out  = (volatile uint64_t *) page;
+
+	if( mode != 0
+	    && syscall::ring::setup(page + RING_OFFSET,
+	                            amd64::user::DATA_SIZE - RING_OFFSET,
+	                            RING_BATCH,
+	                            mode == 2)
+	           == nullptr )
+		return -1.0;
+
+	out[0]          = mode;
+	out[1]          = 0;
+	out[2]          = 0;
+	uint64_t status = amd64::user::run(iterations, (uint64_t) page);
+	syscall::ring::teardown();
+
+	// Every SYS_GETPID returns 1, so the results must add up
+	if( status != 0 || out[2] != iterations )
+		return -1.0;
+	return (double) out[1] / (double) iterations;
+}
+
+/**
+ * @brief Compare SYS_GETPID issued one trap at a time with the same calls
+ *        batched through a submission ring
+ *
+ * The ring is set up in the user data page, once with SYS_RING_ENTER
+ * consuming each batch and once with the kernel poller doing it.  Debug
+ * logging is off for the run, since the dispatcher would otherwise log
+ * every call.
+ */
+void
+    cmd_test_ring(const char *args) {
+	uint64_t iterations = DEFAULT_ITERATIONS;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			iterations = (uint64_t) n;
+		if( iterations > MAX_ITERATIONS )
+			iterations = MAX_ITERATIONS;
+	}
+	iterations = (iterations + RING_BATCH - 1) / RING_BATCH * RING_BATCH;
+
+	size_t len = (size_t) (user_ring_bench_end - user_ring_bench);
+	if( !amd64::user::load(user_ring_bench, len) ) {
+		kstd::puts("No user window");
+		return;
+	}
+
+	bool logging = d_enabled;
+	d_enabled    = false;
+
+	uint64_t ns0  = time::now_ns();
+	uint64_t tsc0 = rdtsc_ordered();
+	double   cycles[3];
+	for( uint64_t mode = 0; mode < 3; mode++ )
+		cycles[mode] = run_mode(mode, iterations);
+	uint64_t tsc1 = rdtsc_ordered();
+	uint64_t ns1  = time::now_ns();
+
+	d_enabled = logging;
+
+	double ns_per_cycle = (double) (ns1 - ns0) / (double) (tsc1 - tsc0);
+
+	kstd::printf("%llu SYS_GETPID calls from ring 3, batches of %d\n",
+	             iterations,
+	             RING_BATCH);
+	for( int mode = 0; mode < 3; mode++ ) {
+		if( cycles[mode] < 0 ) {
+			kstd::printf("%-32s failed\n", mode_names[mode]);
+			continue;
+		}
+		kstd::printf("%-32s %8.1f cycles  %8.1f ns\n",
+		             mode_names[mode],
+		             cycles[mode],
+		             cycles[mode] * ns_per_cycle);
+	}
+	if( cycles[0] > 0 && cycles[1] > 0 )
+		kstd::printf("Batched speedup: %.2fx\n", cycles[0] / cycles[1]);
+}
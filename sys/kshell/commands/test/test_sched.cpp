@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/apic/madt.h>
+#include <arch/amd64/cpu/percpu.h>
+#include <arch/amd64/smp/smp.h>
+#include <kern/sched/sched.h>
+
+// Rounds per measurement unless given on the command line
+#define DEFAULT_ROUNDS 10000
+#define MAX_ROUNDS     1000000
+
+// Two threads handing a turn back and forth through their wait queues
+struct handoff {
+	sched::completion start;
+	sched::wait_queue queue[2];
+	sched::completion done[2];
+	volatile uint32_t turn;
+	uint32_t          rounds;
+};
+
+struct player {
+	handoff *game;
+	uint32_t side;
+};
+
+static bool my_turn(void *arg) {
+	player *p = (player *) arg;
+	return p->game->turn == p->side;
+}
+
+static void play_handoff(void *arg) {
+	player  *p    = (player *) arg;
+	handoff *game = p->game;
+
+	sched::wait_for(&game->start);
+	for( uint32_t i = 0; i < game->rounds; i++ ) {
+		sched::wait(&game->queue[p->side], my_turn, p);
+		game->turn = 1 - p->side;
+		sched::wake_one(&game->queue[1 - p->side]);
+	}
+	sched::complete(&game->done[p->side]);
+}
+
+static void play_yield(void *arg) {
+	player *p = (player *) arg;
+	sched::wait_for(&p->game->start);
+	for( uint32_t i = 0; i < p->game->rounds; i++ )
+		sched::yield();
+	sched::complete(&p->game->done[p->side]);
+}
+
+/**
+ * @brief Run two threads of @p fn, the second on @p cpu, until both finish
+ *
+ * Both wait for a start signal, so the time covers the rounds only.
+ *
+ * @return Nanoseconds from the start signal to the last completion, or 0
+ *         if the threads could not be started
+ */
+static uint64_t
+    run_pair(sched::thread_fn fn, uint32_t rounds, uint32_t cpu) {
+	handoff game = {};
+	game.rounds  = rounds;
+	player p[2]  = {{&game, 0}, {&game, 1}};
+
+	if( !sched::spawn("bench0", fn, &p[0]) )
+		return 0;
+	if( !sched::spawn("bench1", fn, &p[1], sched::PRIO_DEFAULT, cpu) ) {
+		// Let the first one run out at once
+		game.rounds = 0;
+		sched::complete(&game.start);
+		sched::wait_for(&game.done[0]);
+		return 0;
+	}
+
+	uint64_t start = time::now_ns();
+	sched::complete(&game.start);
+	sched::wait_for(&game.done[0]);
+	sched::wait_for(&game.done[1]);
+	return time::now_ns() - start;
+}
+
+static void report(const char *what, uint64_t ns, uint64_t switches) {
+	if( ns == 0 ) {
+		kstd::printf("  %-26s could not start threads\n", what);
+		return;
+	}
+	kstd::printf("  %-26s %8.1f\n", what, (double) ns / (double) switches);
+}
+
+/**
+ * @brief Time thread switches
+ *
+ * Two threads at the same level take turns: first by yielding, which is
+ * a bare switch, then by blocking on a wait queue and waking each other,
+ * which adds the wakeup path.  With a second CPU online the wakeup run is
+ * repeated across CPUs, where every handoff is a reschedule IPI.  The
+ * shell thread sleeps meanwhile, so each handoff is one switch.
+ */
+void
+    cmd_test_sched(const char *args) {
+	if( !sched::is_running() ) {
+		kstd::puts("Scheduler not running");
+		return;
+	}
+
+	uint32_t rounds = DEFAULT_ROUNDS;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			rounds = (uint32_t) n;
+		if( rounds > MAX_ROUNDS )
+			rounds = MAX_ROUNDS;
+	}
+
+	uint32_t self   = amd64::percpu::id();
+	uint32_t remote = self;
+	for( uint32_t cpu = 0; cpu < amd64::madt::MAX_CPUS; cpu++ ) {
+		if( cpu != self && amd64::smp::is_online(cpu) ) {
+			remote = cpu;
+			break;
+		}
+	}
+
+	uint64_t switches = 2ULL * rounds;
+	kstd::printf("%u rounds, ns per switch:\n", rounds);
+	report("yield, same CPU", run_pair(play_yield, rounds, self), switches);
+	report("wakeup, same CPU", run_pair(play_handoff, rounds, self), switches);
+	if( remote == self ) {
+		kstd::puts("  (one CPU online, cross-CPU wakeup skipped)");
+		return;
+	}
+
+	char what[32];
+	kstd::snprintf(what, sizeof(what), "wakeup, CPU %u <-> CPU %u", self, remote);
+	report(what, run_pair(play_handoff, rounds, remote), switches);
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/user/user.h>
+#include <dbg/logger.h>
+
+// Round trips per mechanism unless given on the command line
+#define DEFAULT_ITERATIONS 100000
+#define MAX_ITERATIONS     10000000
+
+extern "C" {
+extern const uint8_t user_syscall_bench[];
+extern const uint8_t user_syscall_bench_end[];
+}
+
+/**
+ * @brief Compare syscall/sysret with int 0x80/iretq from ring 3
+ *
+ * Both loops call SYS_GETPID back to back, so the difference between them
+ * is the entry and exit path.  Debug logging is off for the run, since the
+ * dispatcher would otherwise log every call.
+ */
+void
+    cmd_test_syscall(const char *args) {
+	uint64_t iterations = DEFAULT_ITERATIONS;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			iterations = (uint64_t) n;
+		if( iterations > MAX_ITERATIONS )
+			iterations = MAX_ITERATIONS;
+	}
+
+	size_t len = (size_t) (user_syscall_bench_end - user_syscall_bench);
+	if( !amd64::user::load(user_syscall_bench, len) ) {
+		kstd::puts("No user window");
+		return;
+	}
+
+	volatile uint64_t *cycles = (volatile uint64_t *) amd64::user::data();
+	cycles[0]                 = 0;
+	cycles[1]                 = 0;
+
+	bool logging = d_enabled;
+	d_enabled    = false;
+
+	uint64_t ns0    = time::now_ns();
+	uint64_t tsc0   = rdtsc_ordered();
+	uint64_t status = amd64::user::run(iterations, (uint64_t) cycles);
+	uint64_t tsc1   = rdtsc_ordered();
+	uint64_t ns1    = time::now_ns();
+
+	d_enabled = logging;
+
+	if( status != 0 ) {
+		kstd::printf("Ring 3 run failed (%llu)\n", status);
+		return;
+	}
+
+	double ns_per_cycle = (double) (ns1 - ns0) / (double) (tsc1 - tsc0);
+	double fast         = (double) cycles[0] / (double) iterations;
+	double legacy       = (double) cycles[1] / (double) iterations;
+
+	kstd::printf("%llu round trips of SYS_GETPID from ring 3\n", iterations);
+	kstd::printf("syscall/sysret  %8.1f cycles  %8.1f ns\n",
+	             fast,
+	             fast * ns_per_cycle);
+	kstd::printf("int 0x80/iretq  %8.1f cycles  %8.1f ns\n",
+	             legacy,
+	             legacy * ns_per_cycle);
+	kstd::printf("Speedup: %.2fx\n", legacy / fast);
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <katoi.h>
+#include <kprint.h>
+#include <ktime.h>
+
+#include <arch/amd64/asm/msr.h>
+#include <arch/amd64/user/user.h>
+#include <dbg/logger.h>
+#include <kern/vdso/vdso.h>
+
+// Calls per measurement unless given on the command line
+#define DEFAULT_ITERATIONS 100000
+#define MAX_ITERATIONS     10000000
+
+extern "C" {
+extern const uint8_t user_vdso_bench[];
+extern const uint8_t user_vdso_bench_end[];
+}
+
+// user.asm computes the vDSO entry points from these
+static_assert(amd64::user::VDSO_OFFSET == 0x2000, "VDSO_* in user.asm");
+static_assert(vdso::ENTRY_CLOCK_NS == 2048 && vdso::ENTRY_GETPID == 2064,
+              "VDSO_* in user.asm");
+
+/**
+ * @brief Compare the vDSO clock and getpid with their syscalls from ring 3
+ *
+ * Also checks that a syscall reading taken between two vDSO readings lands
+ * between them.  Debug logging is off for the run, since the dispatcher
+ * would otherwise log every call.
+ */
+void
+    cmd_test_vdso(const char *args) {
+	uint64_t iterations = DEFAULT_ITERATIONS;
+	if( args && *args ) {
+		int n = kstd::atoi(args);
+		if( n > 0 )
+			iterations = (uint64_t) n;
+		if( iterations > MAX_ITERATIONS )
+			iterations = MAX_ITERATIONS;
+	}
+
+	size_t len = (size_t) (user_vdso_bench_end - user_vdso_bench);
+	if( !amd64::user::load(user_vdso_bench, len) ) {
+		kstd::puts("No user window");
+		return;
+	}
+
+	volatile uint64_t *out = (volatile uint64_t *) amd64::user::data();
+	for( int i = 0; i < 7; i++ )
+		out[i] = 0;
+
+	bool logging = d_enabled;
+	d_enabled    = false;
+
+	uint64_t ns0    = time::now_ns();
+	uint64_t tsc0   = rdtsc_ordered();
+	uint64_t status = amd64::user::run(iterations, (uint64_t) out);
+	uint64_t tsc1   = rdtsc_ordered();
+	uint64_t ns1    = time::now_ns();
+
+	d_enabled = logging;
+
+	if( status != 0 ) {
+		kstd::printf("Ring 3 run failed (%llu)\n", status);
+		return;
+	}
+
+	static const char *const names[] = {
+	    "vDSO clock_ns",
+	    "SYS_TIME",
+	    "vDSO getpid",
+	    "SYS_GETPID",
+	};
+
+	double ns_per_cycle = (double) (ns1 - ns0) / (double) (tsc1 - tsc0);
+
+	kstd::printf("%llu calls each from ring 3\n", iterations);
+	for( int i = 0; i < 4; i++ ) {
+		double cycles = (double) out[i] / (double) iterations;
+		kstd::printf("%-14s %8.1f cycles  %8.1f ns\n",
+		             names[i],
+		             cycles,
+		             cycles * ns_per_cycle);
+	}
+
+	bool ordered = out[4] <= out[5] && out[5] <= out[6];
+	kstd::printf("Clock check: %llu <= %llu <= %llu ns: %s\n",
+	             out[4],
+	             out[5],
+	             out[6],
+	             ordered ? "ok" : "FAILED");
+}
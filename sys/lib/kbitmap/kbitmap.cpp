@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kbitmap.h>
+
+namespace kbitmap {
+	typedef char               v16qi __attribute__((vector_size(16)));
+	typedef unsigned long long v2du __attribute__((vector_size(16)));
+
+	static inline v2du load(const uint64_t *p) {
+		v2du v;
+		__builtin_memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	// Index of the lowest set bit; compiles to tzcnt (bsf on older CPUs)
+	static inline size_t lowest_bit(uint64_t word) {
+		return (size_t) __builtin_ctzll(word);
+	}
+
+	/*
+	 * Population count of one word.  The baseline x86-64 target has no
+	 * POPCNT, and __builtin_popcountll would pull in libgcc.
+	 */
+	static inline size_t popcount64(uint64_t x) {
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (size_t) ((x * 0x0101010101010101ULL) >> 56);
+	}
+
+	// Mask of bits [lo, hi) within a word, 0 <= lo < hi <= 64
+	static inline uint64_t word_mask(size_t lo, size_t hi) {
+		uint64_t upper = hi == 64 ? ~0ULL : (1ULL << hi) - 1;
+		return upper & (~0ULL << lo);
+	}
+
+	/**
+	 * @brief First word at or after @p w that differs from @p pattern
+	 *
+	 * Checks four words per step with SSE2 byte compares.  Free space in a
+	 * mostly full bitmap (or used space in a mostly empty one) is usually
+	 * far away, so this is where the time goes.
+	 *
+	 * @param pattern 0 to skip empty words, ~0 to skip full ones
+	 */
+	static size_t
+	    skip_words(const uint64_t *map, size_t w, size_t nwords, uint64_t pattern) {
+#ifdef ARCH_AMD64
+		v2du vpat = {pattern, pattern};
+		while( w + 4 <= nwords ) {
+			v16qi eq0 = (v16qi) load(map + w) == (v16qi) vpat;
+			v16qi eq1 = (v16qi) load(map + w + 2) == (v16qi) vpat;
+			if( __builtin_ia32_pmovmskb128(eq0 & eq1) != 0xFFFF )
+				break;
+			w += 4;
+		}
+#endif
+		while( w < nwords && map[w] == pattern )
+			w++;
+		return w;
+	}
+
+	/**
+	 * @brief Shared body of find_next_set() and find_next_zero()
+	 * @param flip 0 to look for a set bit, ~0 to look for a clear bit
+	 */
+	static size_t
+	    find_next(const uint64_t *map, size_t nbits, size_t start, uint64_t flip) {
+		if( start >= nbits )
+			return nbits;
+
+		size_t   nwords = words_for(nbits);
+		size_t   w      = start / 64;
+		uint64_t cur    = (map[w] ^ flip) & (~0ULL << (start % 64));
+
+		while( !cur ) {
+			w = skip_words(map, w + 1, nwords, flip);
+			if( w >= nwords )
+				return nbits;
+			cur = map[w] ^ flip;
+		}
+
+		size_t bit = w * 64 + lowest_bit(cur);
+		return bit < nbits ? bit : nbits;
+	}
+
+	size_t find_next_set(const uint64_t *map, size_t nbits, size_t start) {
+		return find_next(map, nbits, start, 0);
+	}
+
+	size_t find_next_zero(const uint64_t *map, size_t nbits, size_t start) {
+		return find_next(map, nbits, start, ~0ULL);
+	}
+
+	size_t find_zero_run(const uint64_t *map,
+	                     size_t          nbits,
+	                     size_t          start,
+	                     size_t          count) {
+		if( count == 0 )
+			return start < nbits ? start : nbits;
+
+		while( start < nbits ) {
+			size_t first = find_next_zero(map, nbits, start);
+			if( first >= nbits || nbits - first < count )
+				return nbits;
+
+			// The run ends at the next set bit; only its length matters
+			size_t end = find_next_set(map, first + count, first);
+			if( end - first >= count )
+				return first;
+			start = end + 1;
+		}
+		return nbits;
+	}
+
+	size_t popcount(const uint64_t *map, size_t start, size_t len) {
+		if( len == 0 )
+			return 0;
+
+		size_t end    = start + len;
+		size_t w      = start / 64;
+		size_t last_w = (end - 1) / 64;
+
+		if( w == last_w )
+			return popcount64(map[w]
+			                  & word_mask(start % 64, end - last_w * 64));
+
+		size_t total = popcount64(map[w] & (~0ULL << (start % 64)));
+		w++;
+
+#ifdef ARCH_AMD64
+		// SWAR count per byte, then psadbw sums the bytes of each half
+		const v2du m1  = {0x5555555555555555ULL, 0x5555555555555555ULL};
+		const v2du m2  = {0x3333333333333333ULL, 0x3333333333333333ULL};
+		const v2du m4  = {0x0F0F0F0F0F0F0F0FULL, 0x0F0F0F0F0F0F0F0FULL};
+		const v2du nil = {0, 0};
+		v2du       acc = {0, 0};
+		for( ; w + 2 <= last_w; w += 2 ) {
+			v2du x = load(map + w);
+			x      = x - ((x >> 1) & m1);
+			x      = (x & m2) + ((x >> 2) & m2);
+			x      = (x + (x >> 4)) & m4;
+			acc += (v2du) __builtin_ia32_psadbw128((v16qi) x, (v16qi) nil);
+		}
+		total += (size_t) (acc[0] + acc[1]);
+#endif
+		for( ; w < last_w; w++ )
+			total += popcount64(map[w]);
+
+		return total + popcount64(map[last_w] & word_mask(0, end - last_w * 64));
+	}
+
+	void set_range(uint64_t *map, size_t start, size_t len) {
+		size_t end = start + len;
+		while( start < end ) {
+			size_t w  = start / 64;
+			size_t lo = start % 64;
+			size_t hi = end - w * 64 < 64 ? end - w * 64 : 64;
+			map[w] |= word_mask(lo, hi);
+			start = w * 64 + hi;
+		}
+	}
+
+	void clear_range(uint64_t *map, size_t start, size_t len) {
+		size_t end = start + len;
+		while( start < end ) {
+			size_t w  = start / 64;
+			size_t lo = start % 64;
+			size_t hi = end - w * 64 < 64 ? end - w * 64 : 64;
+			map[w] &= ~word_mask(lo, hi);
+			start = w * 64 + hi;
+		}
+	}
+}  // namespace kbitmap
@@ -10,15 +10,44 @@
  * -- END OF METADATA HEADER --
  */
 #include <kacos.h>
+#include <kkernel.h>
 #include <kmath.h>
 
 namespace kmath {
 	double acos(double x) {
-		// Check for invalid input
-		if( x < -1.0 || x > 1.0 )
-			return kmath::nan("");
+		using namespace detail;
 
-		// Use the relationship: acos(x) = π/2 - asin(x)
-		return K_M_PI_2 - kmath::asin(x);
+		uint32_t ix = high_word(x) & 0x7FFFFFFF;
+
+		// |x| >= 1 or NaN
+		if( ix >= 0x3FF00000 ) {
+			if( x == 1.0 )
+				return 0.0;
+			if( x == -1.0 )
+				return 2.0 * PIO2_HI;
+			return K_NAN;
+		}
+
+		// |x| < 0.5: pi/2 - asin(x)
+		if( ix < 0x3FE00000 ) {
+			if( ix <= 0x3C600000 )
+				return PIO2_HI;
+			return PIO2_HI - (x - (PIO2_LO - x * asin_rational(x * x)));
+		}
+
+		// acos(x) = 2 * asin(sqrt((1 - |x|) / 2)), reflected for x < 0
+		if( x < 0 ) {
+			double z = (1.0 + x) * 0.5;
+			double s = sqrt(z);
+			double w = asin_rational(z) * s - PIO2_LO;
+			return 2.0 * (PIO2_HI - (s + w));
+		}
+
+		double z  = (1.0 - x) * 0.5;
+		double s  = sqrt(z);
+		double df = from_bits(to_bits(s) & 0xFFFFFFFF00000000);
+		double c  = (z - df * df) / (s + df);
+		double w  = asin_rational(z) * s + c;
+		return 2.0 * (df + w);
 	}
 }  // namespace kmath
@@ -10,28 +10,46 @@
  * -- END OF METADATA HEADER --
  */
 #include <kasin.h>
+#include <kkernel.h>
 #include <kmath.h>
 
 namespace kmath {
 	double asin(double x) {
-		// Check for invalid input
-		if( x < -1.0 || x > 1.0 )
-			return kmath::nan("");
+		using namespace detail;
 
-		// Use Newton's method to find arcsin
-		if( kmath::fabs(x) < 0.5 ) {
-			double y  = x;
-			double y2 = y * y;
-			double y3 = y2 * y;
-			double y5 = y3 * y2;
-			double y7 = y5 * y2;
-			return y + y3 / 6.0 + 3.0 * y5 / 40.0 + 5.0 * y7 / 112.0;
+		uint32_t ix = high_word(x) & 0x7FFFFFFF;
+
+		// |x| >= 1 or NaN
+		if( ix >= 0x3FF00000 ) {
+			if( fabs(x) == 1.0 )
+				return copysign(PIO2_HI, x);
+			return K_NAN;
+		}
+
+		// |x| < 0.5; below 2^-26 the cubic term is lost to rounding
+		if( ix < 0x3FE00000 ) {
+			if( ix < 0x3E500000 )
+				return x;
+			return x + x * asin_rational(x * x);
 		}
 
-		// For values closer to ±1, use different approach
-		if( x > 0 )
-			return K_M_PI_2 - kmath::asin(kmath::sqrt(1.0 - x * x));
-		else
-			return -K_M_PI_2 + kmath::asin(kmath::sqrt(1.0 - x * x));
+		// asin(x) = pi/2 - 2 * asin(sqrt((1 - |x|) / 2))
+		double z = (1.0 - fabs(x)) * 0.5;
+		double s = sqrt(z);
+		double r = asin_rational(z);
+		double y;
+		if( ix >= 0x3FEF3333 ) {
+			// |x| > 0.975: s is small enough that its rounding error is
+			// below the final ulp
+			y = PIO2_HI - (2.0 * (s + s * r) - PIO2_LO);
+		} else {
+			// Split s = f + c with f exact in 26 bits
+			double f = from_bits(to_bits(s) & 0xFFFFFFFF00000000);
+			double c = (z - f * f) / (s + f);
+			double p = 2.0 * s * r - (PIO2_LO - 2.0 * c);
+			double q = 0.5 * PIO2_HI - 2.0 * f;
+			y        = 0.5 * PIO2_HI - (p - q);
+		}
+		return copysign(y, x);
 	}
 }  // namespace kmath
@@ -10,32 +10,84 @@
  * -- END OF METADATA HEADER --
  */
 #include <katan.h>
+#include <kkernel.h>
 #include <kmath.h>
 
 namespace kmath {
+	// atan of the breakpoints 0.5, 1, 1.5 and infinity, as double-doubles
+	static const double atan_hi[] = {
+	    4.63647609000806093515e-01,
+	    7.85398163397448278999e-01,
+	    9.82793723247329054082e-01,
+	    1.57079632679489655800e+00,
+	};
+	static const double atan_lo[] = {
+	    2.26987774529616870924e-17,
+	    3.06161699786838301793e-17,
+	    1.39033110312309984516e-17,
+	    6.12323399573676603587e-17,
+	};
+
+	// atan(x) = x - x^3 * (AT0 + x^2 * (AT1 + ...)) on [0, 7/16]
+	static const double AT[] = {
+	    3.33333333333329318027e-01,
+	    -1.99999999998764832476e-01,
+	    1.42857142725034663711e-01,
+	    -1.11111104054623557880e-01,
+	    9.09088713343650656196e-02,
+	    -7.69187620504482999495e-02,
+	    6.66107313738753120669e-02,
+	    -5.83357013379057348645e-02,
+	    4.97687799461593236017e-02,
+	    -3.65315727442169155270e-02,
+	    1.62858201153657823623e-02,
+	};
+
 	double atan(double x) {
-		// Handle special cases
-		if( kmath::isnan(x) )
-			return kmath::nan("");
-		if( kmath::isinf(x) )
-			return x > 0 ? K_M_PI_2 : -K_M_PI_2;
-		if( x == 0.0 )
-			return 0.0;
+		uint32_t ix = detail::high_word(x) & 0x7FFFFFFF;
 
-		// Use series expansion for small values
-		if( kmath::fabs(x) < 1.0 ) {
-			double x2 = x * x;
-			double x3 = x2 * x;
-			double x5 = x3 * x2;
-			double x7 = x5 * x2;
-			double x9 = x7 * x2;
-			return x - x3 / 3.0 + x5 / 5.0 - x7 / 7.0 + x9 / 9.0;
+		// |x| >= 2^66: atan(x) rounds to +-pi/2
+		if( ix >= 0x44100000 ) {
+			if( isnan(x) )
+				return x;
+			return copysign(atan_hi[3], x);
 		}
 
-		// For large values, use atan(x) = π/2 - atan(1/x)
-		if( x > 0 )
-			return K_M_PI_2 - kmath::atan(1.0 / x);
-		else
-			return -K_M_PI_2 - kmath::atan(1.0 / x);
+		// |x| < 7/16; below 2^-27 atan(x) rounds to x
+		int    id = -1;
+		double t  = x;
+		if( ix < 0x3FDC0000 ) {
+			if( ix < 0x3E400000 )
+				return x;
+		} else {
+			// Move |x| next to one of the breakpoints
+			double a = fabs(x);
+			if( ix < 0x3FE60000 ) {
+				id = 0;
+				t  = (2.0 * a - 1.0) / (2.0 + a);
+			} else if( ix < 0x3FF30000 ) {
+				id = 1;
+				t  = (a - 1.0) / (a + 1.0);
+			} else if( ix < 0x40038000 ) {
+				id = 2;
+				t  = (a - 1.5) / (1.0 + 1.5 * a);
+			} else {
+				id = 3;
+				t  = -1.0 / a;
+			}
+		}
+
+		double z  = t * t;
+		double w  = z * z;
+		// Odd and even coefficients in two chains for more parallelism
+		double s1 = AT[6] + w * (AT[8] + w * AT[10]);
+		s1        = z * (AT[0] + w * (AT[2] + w * (AT[4] + w * s1)));
+		double s2 = AT[5] + w * (AT[7] + w * AT[9]);
+		s2        = w * (AT[1] + w * (AT[3] + w * s2));
+		if( id < 0 )
+			return t - t * (s1 + s2);
+
+		double r = atan_hi[id] - ((t * (s1 + s2) - atan_lo[id]) - t);
+		return copysign(r, x);
 	}
 }  // namespace kmath
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kbatch.h>
+#include <kkernel.h>
+#include <kmath.h>
+
+namespace kmath {
+	typedef double             v2df __attribute__((vector_size(16)));
+	typedef unsigned long long v2du __attribute__((vector_size(16)));
+
+	constexpr uint64_t SIGN_BIT   = 0x8000000000000000;
+	constexpr uint64_t EXP_MASK   = 0x7FF0000000000000;
+	constexpr uint64_t MIN_NORMAL = 0x0010000000000000;
+	constexpr uint64_t HIGH_WORD  = 0xFFFFFFFF00000000;
+
+	static inline v2df load(const double *p) {
+		v2df v;
+		__builtin_memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	static inline void store(double *p, v2df v) {
+		__builtin_memcpy(p, &v, sizeof(v));
+	}
+
+	// True when both lanes of a comparison result are set
+	static inline bool all(v2du mask) {
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	// Lanes of @p a where @p mask is set, lanes of @p b elsewhere
+	static inline v2du select(v2du mask, v2du a, v2du b) {
+		return (a & mask) | (b & ~mask);
+	}
+
+	/**
+	 * @brief sin and cos of a reduced pair, picked and signed per quadrant
+	 * @param phase 0 for sin, 1 for cos (cos(x) = sin(x + pi/2))
+	 */
+	static inline v2df sincos2(v2df x, unsigned phase) {
+		v2df y0, y1;
+		v2du q = (v2du) detail::reduce_pio2(x, y0, y1) + phase;
+
+		v2du s = (v2du) detail::kernel_sin(y0, y1);
+		v2du c = (v2du) detail::kernel_cos(y0, y1);
+
+		v2du r = select(-(q & 1), c, s);
+		r ^= (q & 2) << 62;
+
+		// sin(-0) is -0, which the reduction loses
+		if( phase )
+			return (v2df) r;
+		return (v2df) select((v2du) (x == 0.0), (v2du) x, r);
+	}
+
+	static void sincos_n(const double *in, double *out, size_t n, unsigned phase) {
+		size_t i = 0;
+		for( ; i + 2 <= n; i += 2 ) {
+			v2df x  = load(in + i);
+			v2df ax = (v2df) ((v2du) x & 0x7FFFFFFFFFFFFFFF);
+
+			if( !all((v2du) (ax <= detail::PIO2_MEDIUM_MAX)) ) {
+				out[i]     = phase ? cos(in[i]) : sin(in[i]);
+				out[i + 1] = phase ? cos(in[i + 1]) : sin(in[i + 1]);
+				continue;
+			}
+			store(out + i, sincos2(x, phase));
+		}
+		for( ; i < n; i++ )
+			out[i] = phase ? cos(in[i]) : sin(in[i]);
+	}
+
+	void sin_n(const double *in, double *out, size_t n) {
+		sincos_n(in, out, n, 0);
+	}
+
+	void cos_n(const double *in, double *out, size_t n) {
+		sincos_n(in, out, n, 1);
+	}
+
+	/**
+	 * @brief tan of a pair: kernel_tan() in ktan.cpp with every branch
+	 *        taken and the lanes picked afterwards
+	 */
+	static inline v2df tan2(v2df in) {
+		using namespace detail;
+
+		v2df x, y;
+		v2du odd = -(((v2du) reduce_pio2(in, x, y)) & 1);
+		v2du neg = (v2du) (x < 0.0);
+		v2du big = (v2du) ((v2df) ((v2du) x & ~SIGN_BIT)
+		                   >= from_bits((uint64_t) TAN_BIG_HIGH << 32));
+
+		// Past 0.6744 use tan(pi/4 - |x|)
+		v2df ax = (v2df) ((v2du) x ^ (neg & SIGN_BIT));
+		v2df ay = (v2df) ((v2du) y ^ (neg & SIGN_BIT));
+		x = (v2df) select(big, (v2du) ((PIO4 - ax) + (PIO4_LO - ay)), (v2du) x);
+		y = (v2df) ((v2du) y & ~big);
+
+		v2df r = tan_poly(x, y);
+		v2df w = x + r;
+
+		v2df s  = (v2df) (((v2du) v2df{1.0, 1.0}) | (odd & SIGN_BIT));
+		v2df vb = s - 2.0 * (x + (r - w * w / (w + s)));
+		vb      = (v2df) ((v2du) vb ^ (neg & SIGN_BIT));
+
+		// -1/(x + r) with the division error compensated
+		v2df w0 = (v2df) ((v2du) w & HIGH_WORD);
+		v2df v  = r - (w0 - x);
+		v2df a  = -1.0 / w;
+		v2df a0 = (v2df) ((v2du) a & HIGH_WORD);
+		v2df vo = a0 + a * (1.0 + a0 * w0 + a0 * v);
+
+		v2du t = select(big, (v2du) vb, select(odd, (v2du) vo, (v2du) w));
+
+		// tan(-0) is -0, which the reduction loses
+		return (v2df) select((v2du) (in == 0.0), (v2du) in, t);
+	}
+
+	void tan_n(const double *in, double *out, size_t n) {
+		size_t i = 0;
+		for( ; i + 2 <= n; i += 2 ) {
+			v2df x  = load(in + i);
+			v2df ax = (v2df) ((v2du) x & ~SIGN_BIT);
+
+			if( !all((v2du) (ax <= detail::PIO2_MEDIUM_MAX)) ) {
+				out[i]     = tan(in[i]);
+				out[i + 1] = tan(in[i + 1]);
+				continue;
+			}
+			store(out + i, tan2(x));
+		}
+		for( ; i < n; i++ )
+			out[i] = tan(in[i]);
+	}
+
+	void exp_n(const double *in, double *out, size_t n) {
+		size_t i = 0;
+		for( ; i + 2 <= n; i += 2 ) {
+			v2df x = load(in + i);
+
+			// Inside this range 2^k * exp(r) is always a normal number
+			if( !all((v2du) (x >= -708.0) & (v2du) (x <= 709.0)) ) {
+				out[i]     = exp(in[i]);
+				out[i + 1] = exp(in[i + 1]);
+				continue;
+			}
+
+			v2df k;
+			v2df y = detail::exp_core(x, v2df{}, k);
+
+			// Add k to the exponent field; the low 12 bits of k are enough
+			v2du kbits = (v2du) (k + detail::ROUND_SHIFTER) << 52;
+			store(out + i, (v2df) ((v2du) y + kbits));
+		}
+		for( ; i < n; i++ )
+			out[i] = exp(in[i]);
+	}
+
+	/**
+	 * @brief Split positive normal @p bits as log() does: x = 2^k * m
+	 */
+	static inline v2df log_split(v2du bits, v2df &k) {
+		v2du u = bits + ((uint64_t) (0x3FF00000 - 0x3FE6A09E) << 32);
+		k      = (v2df) ((u >> 52) | 0x4330000000000000) - (0x1p52 + 1023.0);
+		return (v2df) ((u & 0x000FFFFFFFFFFFFF) + ((uint64_t) 0x3FE6A09E << 32));
+	}
+
+	void log_n(const double *in, double *out, size_t n) {
+		size_t i = 0;
+		for( ; i + 2 <= n; i += 2 ) {
+			v2du bits = (v2du) load(in + i);
+
+			// Positive, normal and finite; the sign bit makes the rest wrap
+			if( !all((v2du) (bits - MIN_NORMAL < EXP_MASK - MIN_NORMAL)) ) {
+				out[i]     = log(in[i]);
+				out[i + 1] = log(in[i + 1]);
+				continue;
+			}
+
+			// m in [sqrt(2)/2, sqrt(2))
+			v2df k;
+			v2df m = log_split(bits, k);
+			store(out + i, detail::log_core(m, k));
+		}
+		for( ; i < n; i++ )
+			out[i] = log(in[i]);
+	}
+
+	void pow_n(const double *x, const double *y, double *out, size_t n) {
+		using namespace detail;
+
+		size_t i = 0;
+		for( ; i + 2 <= n; i += 2 ) {
+			v2du xbits = (v2du) load(x + i);
+			v2df yv    = load(y + i);
+			v2du ybits = (v2du) yv;
+
+			// x positive, normal, finite and not 1; y finite and none of
+			// the values pow() answers before taking the log
+			v2du plain = (v2du) (xbits - MIN_NORMAL < EXP_MASK - MIN_NORMAL)
+			           & (v2du) ((v2df) xbits != 1.0)
+			           & (v2du) ((ybits & EXP_MASK) != EXP_MASK)
+			           & (v2du) (yv != 0.0) & (v2du) (yv != 1.0)
+			           & (v2du) (yv != 2.0);
+
+			v2df lh, ll, k;
+			v2df m = log_split(xbits, k);
+			log_extended(m, k, lh, ll);
+
+			v2df eh, el;
+			two_prod(yv, lh, eh, el);
+			el += yv * ll;
+			v2df hi = eh + el;
+			v2df lo = el - (hi - eh);
+
+			// Inside this range 2^k * exp(hi + lo) is always a normal number
+			plain &= (v2du) (hi >= -708.0) & (v2du) (hi <= 709.0);
+			if( !all(plain) ) {
+				out[i]     = pow(x[i], y[i]);
+				out[i + 1] = pow(x[i + 1], y[i + 1]);
+				continue;
+			}
+
+			v2df e     = exp_core(hi, lo, k);
+			v2du kbits = (v2du) (k + ROUND_SHIFTER) << 52;
+			store(out + i, (v2df) ((v2du) e + kbits));
+		}
+		for( ; i < n; i++ )
+			out[i] = pow(x[i], y[i]);
+	}
+}  // namespace kmath
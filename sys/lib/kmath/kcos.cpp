@@ -10,39 +10,27 @@
  * -- END OF METADATA HEADER --
  */
 #include <kcos.h>
+#include <kkernel.h>
 #include <kmath.h>
 
 namespace kmath {
 	double cos(double x) {
-		// Normalize x to [-π, π]
-		x = kmath::fmod(x, 2.0 * K_M_PI);
-		if( x > K_M_PI )
-			x -= 2.0 * K_M_PI;
-		if( x < -K_M_PI )
-			x += 2.0 * K_M_PI;
+		using namespace detail;
 
-		// Use Taylor series for small values
-		if( kmath::fabs(x) < 0.1 ) {
-			double x2 = x * x;
-			double x4 = x2 * x2;
-			double x6 = x4 * x2;
-			return 1.0 - x2 / 2.0 + x4 / 24.0 - x6 / 720.0;
-		}
-
-		// For larger values, use more terms of Taylor series
-		double result    = 0.0;
-		double term      = 1.0;
-		double x2        = x * x;
-		double factorial = 1.0;
-		int    sign      = 1;
+		// NaN and infinity give NaN
+		if( (high_word(x) & 0x7FFFFFFF) >= 0x7FF00000 )
+			return x - x;
 
-		for( int i = 0; i <= 10; i++ ) {
-			result += sign * term / factorial;
-			term *= x2;
-			factorial *= (2 * i + 1) * (2 * i + 2);
-			sign = -sign;
+		double y0, y1;
+		switch( rem_pio2(x, y0, y1) ) {
+			case 0:
+				return kernel_cos(y0, y1);
+			case 1:
+				return -kernel_sin(y0, y1);
+			case 2:
+				return -kernel_cos(y0, y1);
+			default:
+				return kernel_sin(y0, y1);
 		}
-
-		return result;
 	}
 }  // namespace kmath
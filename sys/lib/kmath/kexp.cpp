@@ -10,29 +10,22 @@
  * -- END OF METADATA HEADER --
  */
 #include <kexp.h>
+#include <kkernel.h>
 #include <kmath.h>
 
 namespace kmath {
 	double exp(double x) {
-		// Handle special cases
-		if( x == 0.0 )
-			return 1.0;
-		if( x < -700.0 )
-			return 0.0;  // Underflow
-		if( x > 700.0 )
-			return 1.0 / 0.0;  // Overflow
+		using namespace detail;
 
-		// Use Taylor series: e^x = 1 + x + x^2/2! + x^3/3! + ...
-		double result    = 1.0;
-		double term      = 1.0;
-		double factorial = 1.0;
+		if( x != x )
+			return x;
+		if( x > EXP_OVERFLOW_AT )
+			return K_INFINITY;
+		if( x < EXP_UNDERFLOW_AT )
+			return 0.0;
 
-		for( int i = 1; i <= 20; i++ ) {
-			term *= x;
-			factorial *= i;
-			result += term / factorial;
-		}
-
-		return result;
+		double k;
+		double y = exp_core(x, 0.0, k);
+		return scale(y, (int) k);
 	}
-}  // namespace math
+}  // namespace kmath
@@ -9,42 +9,40 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#include <kkernel.h>
 #include <klog.h>
 #include <kmath.h>
 
 namespace kmath {
 	double log(double x) {
-		// Handle special cases
-		if( x <= 0.0 ) {
-			// Return NaN for non-positive numbers
-			return 0.0;
-		}
+		using namespace detail;
 
-		if( x == 1.0 )
-			return 0.0;
+		uint64_t bits = to_bits(x);
+		int      k    = 0;
 
-		// Use Newton's method to find ln(x)
-		// We solve: e^y = x, so y = ln(x)
-		double y = 0.0;
+		if( x != x || x == K_INFINITY )
+			return x;
+		if( x == 0.0 )
+			return -K_INFINITY;
+		if( bits >> 63 )
+			return K_NAN;
 
-		// Initial guess
-		if( x > 1.0 ) {
-			y = 1.0;
-		} else {
-			y = -1.0;
+		// Subnormal: scale into the normal range first
+		if( bits < 0x0010000000000000 ) {
+			x *= 0x1p54;
+			bits = to_bits(x);
+			k    = -54;
 		}
 
-		// Newton iteration: y_{n+1} = y_n + (x - e^y_n) / e^y_n
-		for( int i = 0; i < 10; i++ ) {
-			double prev_y = y;
-			double exp_y  = kmath::exp(y);
-			y             = y + (x - exp_y) / exp_y;
-
-			if( kmath::fabs(y - prev_y) < 1e-15 ) {
-				break;
-			}
-		}
+		/*
+		 * Split x = 2^k * m with m in [sqrt(2)/2, sqrt(2)) by moving the
+		 * exponent so the mantissa lands around 1.
+		 */
+		uint32_t hx = (uint32_t) (bits >> 32) + (0x3FF00000 - 0x3FE6A09E);
+		k += (int) (hx >> 20) - 0x3FF;
+		hx = (hx & 0x000FFFFF) + 0x3FE6A09E;
 
-		return y;
+		double m = from_bits(((uint64_t) hx << 32) | (bits & 0xFFFFFFFF));
+		return log_core(m, (double) k);
 	}
 }  // namespace kmath
@@ -9,52 +9,124 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#include <kkernel.h>
 #include <kmath.h>
 #include <kpow.h>
 
 namespace kmath {
-	double pow(double x, double y) {
-		// Handle special cases
-		if( x == 0.0 ) {
-			if( y > 0.0 )
-				return 0.0;
-			if( y == 0.0 )
-				return 1.0;
-			// y < 0: return infinity
-			return 1.0 / 0.0;
+	/**
+	 * @brief Classify y for the sign rules of pow()
+	 * @return 0 if y is not an integer, 1 if it is odd, 2 if it is even
+	 */
+	static int integer_kind(double y) {
+		uint64_t bits = detail::to_bits(y);
+		int      e    = (int) ((bits >> 52) & 0x7FF) - 0x3FF;
+
+		if( e >= 53 )
+			return 2;
+		if( e < 0 )
+			return 0;
+
+		uint64_t m         = (bits & 0x000FFFFFFFFFFFFF) | (1ULL << 52);
+		int      frac_bits = 52 - e;
+		if( m & ((1ULL << frac_bits) - 1) )
+			return 0;
+		return ((m >> frac_bits) & 1) ? 1 : 2;
+	}
+
+	/**
+	 * @brief log(x) as a double-double, for finite x > 0
+	 *
+	 * Splits x the way log() does, subnormals included, and leaves the
+	 * rest to detail::log_extended(), which pow_n() shares.
+	 */
+	static void log_split(double x, double &hi, double &lo) {
+		using namespace detail;
+
+		uint64_t bits = to_bits(x);
+		int      k    = 0;
+
+		if( bits < 0x0010000000000000 ) {
+			x *= 0x1p54;
+			bits = to_bits(x);
+			k    = -54;
 		}
 
-		if( x == 1.0 )
-			return 1.0;
+		uint32_t hx = (uint32_t) (bits >> 32) + (0x3FF00000 - 0x3FE6A09E);
+		k += (int) (hx >> 20) - 0x3FF;
+		hx = (hx & 0x000FFFFF) + 0x3FE6A09E;
+
+		double m = from_bits(((uint64_t) hx << 32) | (bits & 0xFFFFFFFF));
 
-		if( y == 0.0 )
+		log_extended(m, (double) k, hi, lo);
+	}
+
+	double pow(double x, double y) {
+		using namespace detail;
+
+		if( y == 0.0 || x == 1.0 )
 			return 1.0;
+		if( x != x || y != y )
+			return x + y;
 		if( y == 1.0 )
 			return x;
 		if( y == 2.0 )
 			return x * x;
-		if( y == 0.5 )
-			return kmath::sqrt(x);
-
-		// For integer powers, use repeated multiplication
-		if( y == (int) y && y > 0 && y < 100 ) {
-			double result = 1.0;
-			for( int i = 0; i < (int) y; i++ ) {
-				result *= x;
-			}
-			return result;
+
+		if( kmath::isinf(y) ) {
+			double ax = kmath::fabs(x);
+			if( ax == 1.0 )
+				return 1.0;
+			return ((ax > 1.0) == (y > 0.0)) ? K_INFINITY : 0.0;
+		}
+
+		int  yint   = integer_kind(y);
+		bool neg_x  = to_bits(x) >> 63;
+		bool negate = neg_x && yint == 1;
+
+		if( x == 0.0 || kmath::isinf(x) ) {
+			double r = ((x != 0.0) == (y > 0.0)) ? K_INFINITY : 0.0;
+			return negate ? -r : r;
+		}
+
+		if( neg_x ) {
+			if( yint == 0 )
+				return K_NAN;
+			x = -x;
+			if( x == 1.0 )
+				return negate ? -1.0 : 1.0;
 		}
 
-		// For negative integer powers
-		if( y == (int) y && y < 0 && y > -100 ) {
-			double result = 1.0;
-			for( int i = 0; i < -(int) y; i++ ) {
-				result /= x;
+		double lh, ll;
+		log_split(x, lh, ll);
+
+		// Settle clear overflow/underflow first so the split below stays finite
+		double r;
+		double approx = y * lh;
+		if( approx > 746.0 ) {
+			r = K_INFINITY;
+		} else if( approx < -746.0 ) {
+			r = 0.0;
+		} else {
+			double eh, el;
+			two_prod(y, lh, eh, el);
+			el += y * ll;
+
+			double hi = eh + el;
+			double lo = el - (hi - eh);
+
+			// exp(hi + lo), with lo folded into the argument reduction
+			if( hi > EXP_OVERFLOW_AT ) {
+				r = K_INFINITY;
+			} else if( hi < EXP_UNDERFLOW_AT ) {
+				r = 0.0;
+			} else {
+				double k;
+				double e = exp_core(hi, lo, k);
+				r        = scale(e, (int) k);
 			}
-			return result;
 		}
 
-		// General case: use exp(y * log(x))
-		return kmath::exp(y * kmath::log(x));
+		return negate ? -r : r;
 	}
 }  // namespace kmath
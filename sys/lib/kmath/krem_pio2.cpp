@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kkernel.h>
+#include <kstddef.h>
+
+__extension__ typedef unsigned __int128 u128;
+
+namespace kmath {
+	namespace detail {
+		/*
+		 * Bits of 2/pi, most significant first.  The leading zero word lets
+		 * the bit window start before the binary point for the smallest
+		 * inputs that reach this path.
+		 */
+		static const uint64_t two_over_pi[] = {
+		    0x0000000000000000, 0xA2F9836E4E441529, 0xFC2757D1F534DDC0,
+		    0xDB6295993C439041, 0xFE5163ABDEBBC561, 0xB7246E3A424DD2E0,
+		    0x06492EEA09D1921C, 0xFE1DEB1CB129A73E, 0xE88235F52EBB4484,
+		    0xE99C7026B45F7E41, 0x3991D639835339F4, 0x9C845F8BBDF9283B,
+		    0x1FF897FFDE05980F, 0xEF2F118B5A0A6D1F, 0x6D367ECF27CB09B7,
+		    0x4F463F669E5FEA2D, 0x7527BAC7EBE5F17B, 0x3D0739F78A5292EA,
+		    0x6BFB5FB11F8D5D08, 0x56033046FC7B6BAB, 0xF0CFBC209AF4361D,
+		    0xA9E391615EE61B08};
+
+		static uint64_t window(size_t bit) {
+			size_t word  = bit / 64;
+			size_t shift = bit % 64;
+			if( shift == 0 )
+				return two_over_pi[word];
+			return (two_over_pi[word] << shift)
+			     | (two_over_pi[word + 1] >> (64 - shift));
+		}
+
+		int rem_pio2_large(double x, double *y) {
+			uint64_t bits = to_bits(x);
+			bool     neg  = bits >> 63;
+			int      e    = (int) ((bits >> 52) & 0x7FF) - 1075;
+			uint64_t m    = (bits & 0x000FFFFFFFFFFFFF) | (1ULL << 52);
+
+			/*
+			 * x * 2/pi = m * 2^e * 2/pi.  Bits of 2/pi worth 4 or more after
+			 * scaling only add multiples of 4 to n, so start the 192-bit
+			 * window at fraction bit e - 1.  The product m * W then has its
+			 * binary point at bit 190.
+			 */
+			size_t   start = (size_t) (e + 62);
+			uint64_t w0    = window(start);
+			uint64_t w1    = window(start + 64);
+			uint64_t w2    = window(start + 128);
+
+			u128 p2 = (u128) m * w2;
+			u128 p1 = (u128) m * w1;
+
+			uint64_t l0 = (uint64_t) p2;
+			u128     t1 = (p2 >> 64) + (uint64_t) p1;
+			uint64_t l1 = (uint64_t) t1;
+			uint64_t l2 = (uint64_t) (p1 >> 64) + (uint64_t) (t1 >> 64) + m * w0;
+
+			// Integer part mod 4, then the fraction as a signed 128-bit value
+			int  n    = (int) (l2 >> 62);
+			u128 frac = ((u128) ((l2 << 2) | (l1 >> 62)) << 64)
+			          | ((l1 << 2) | (l0 >> 62));
+			bool round_up = frac >> 127;
+			if( round_up ) {
+				frac = ~frac + 1;
+				n++;
+			}
+
+			// Normalize and split into a double-double in units of 2^-128
+			uint64_t top = (uint64_t) (frac >> 64);
+			int      lz  = top ? __builtin_clzll(top)
+			                   : 64 + __builtin_clzll((uint64_t) frac | 1);
+			frac <<= lz;
+
+			double hi = (double) (uint64_t) (frac >> 75)
+			          * from_bits((uint64_t) (1023 - 53 - lz) << 52);
+			double lo = (double) (uint64_t) (frac >> 11)
+			          * from_bits((uint64_t) (1023 - 117 - lz) << 52);
+			if( round_up ) {
+				hi = -hi;
+				lo = -lo;
+			}
+
+			// Multiply the fraction of a quadrant by pi/2
+			double ph, pl;
+			two_prod(hi, PIO2_HI, ph, pl);
+			pl += hi * PIO2_LO + lo * PIO2_HI;
+
+			y[0] = ph + pl;
+			y[1] = pl - (y[0] - ph);
+			if( neg ) {
+				y[0] = -y[0];
+				y[1] = -y[1];
+				return -n;
+			}
+			return n;
+		}
+	}  // namespace detail
+}  // namespace kmath
@@ -9,41 +9,30 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#include <kkernel.h>
 #include <kmath.h>
 #include <ksin.h>
 
 namespace kmath {
 	double sin(double x) {
-		// Normalize x to [-π, π]
-		x = kmath::fmod(x, 2.0 * K_M_PI);
-		if( x > K_M_PI )
-			x -= 2.0 * K_M_PI;
-		if( x < -K_M_PI )
-			x += 2.0 * K_M_PI;
+		using namespace detail;
 
-		// Use Taylor series for small values
-		if( kmath::fabs(x) < 0.1 ) {
-			double x2 = x * x;
-			double x3 = x2 * x;
-			double x5 = x3 * x2;
-			double x7 = x5 * x2;
-			return x - x3 / 6.0 + x5 / 120.0 - x7 / 5040.0;
-		}
-
-		// For larger values, use more terms of Taylor series
-		double result    = 0.0;
-		double term      = x;
-		double x2        = x * x;
-		double factorial = 1.0;
-		int    sign      = 1;
+		// Keep the sign of zero; NaN and infinity give NaN
+		if( x == 0.0 )
+			return x;
+		if( (high_word(x) & 0x7FFFFFFF) >= 0x7FF00000 )
+			return x - x;
 
-		for( int i = 1; i <= 10; i++ ) {
-			result += sign * term / factorial;
-			term *= x2;
-			factorial *= (2 * i) * (2 * i + 1);
-			sign = -sign;
+		double y0, y1;
+		switch( rem_pio2(x, y0, y1) ) {
+			case 0:
+				return kernel_sin(y0, y1);
+			case 1:
+				return kernel_cos(y0, y1);
+			case 2:
+				return -kernel_sin(y0, y1);
+			default:
+				return -kernel_cos(y0, y1);
 		}
-
-		return result;
 	}
 }  // namespace kmath
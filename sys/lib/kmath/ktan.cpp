@@ -9,16 +9,62 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#include <kkernel.h>
 #include <kmath.h>
 #include <ktan.h>
 
 namespace kmath {
-	double tan(double x) {
-		double cos_x = kmath::cos(x);
-		if( cos_x == 0.0 ) {
-			// Return infinity for undefined values
-			return 1.0 / 0.0;
+	static double clear_low_word(double x) {
+		return detail::from_bits(detail::to_bits(x) & 0xFFFFFFFF00000000);
+	}
+
+	/**
+	 * @brief tan(x + y) for |x + y| <= pi/4, or -1/tan(x + y) when @p odd
+	 */
+	static double kernel_tan(double x, double y, bool odd) {
+		using namespace detail;
+
+		bool big = (high_word(x) & 0x7FFFFFFF) >= TAN_BIG_HIGH;
+		bool neg = x < 0.0;
+
+		if( big ) {
+			if( neg ) {
+				x = -x;
+				y = -y;
+			}
+			x = (PIO4 - x) + (PIO4_LO - y);
+			y = 0.0;
 		}
-		return kmath::sin(x) / cos_x;
+
+		double r = tan_poly(x, y);
+		double w = x + r;
+		double v;
+
+		if( big ) {
+			double s = odd ? -1.0 : 1.0;
+			v        = s - 2.0 * (x + (r - w * w / (w + s)));
+			return neg ? -v : v;
+		}
+		if( !odd )
+			return w;
+
+		// -1/(x + r) with the division error compensated
+		double w0 = clear_low_word(w);
+		v         = r - (w0 - x);
+		double a  = -1.0 / w;
+		double a0 = clear_low_word(a);
+		return a0 + a * (1.0 + a0 * w0 + a0 * v);
+	}
+
+	double tan(double x) {
+		// Keep the sign of zero; NaN and infinity give NaN
+		if( x == 0.0 )
+			return x;
+		if( (detail::high_word(x) & 0x7FFFFFFF) >= 0x7FF00000 )
+			return x - x;
+
+		double y0, y1;
+		int    n = detail::rem_pio2(x, y0, y1);
+		return kernel_tan(y0, y1, n & 1);
 	}
 }  // namespace kmath
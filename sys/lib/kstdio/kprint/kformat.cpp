@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kformat.h>
+#include <kprint.h>
+#include <kstrlen.h>
+
+namespace kstd {
+	namespace fmt {
+		static const char digits_lower[] = "0123456789abcdef";
+		static const char digits_upper[] = "0123456789ABCDEF";
+
+		static void emit_spaces(sink *out, size_t n) {
+			static const char spaces[] = "                ";
+			while( n > 0 ) {
+				size_t chunk = n < sizeof(spaces) - 1 ? n : sizeof(spaces) - 1;
+				out->write(out, spaces, chunk);
+				n -= chunk;
+			}
+		}
+
+		static void
+		    emit_padded(sink *out, const char *s, size_t len, const instr &op) {
+			size_t pad = op.width > len ? op.width - len : 0;
+			if( !(op.flags & FLAG_LEFT) )
+				emit_spaces(out, pad);
+			out->write(out, s, len);
+			if( op.flags & FLAG_LEFT )
+				emit_spaces(out, pad);
+		}
+
+		/**
+		 * @brief Write the digits of @p v right-aligned into a buffer
+		 * @return Pointer to the first digit; the digits run up to @p end
+		 */
+		static char *render_dec(char *end, uint64_t v) {
+			char *p = end;
+			do {
+				*--p = (char) ('0' + (v % 10));
+				v /= 10;
+			} while( v );
+			return p;
+		}
+
+		static char *render_hex(char *end, uint64_t v, const char *digit_set) {
+			char *p = end;
+			do {
+				*--p = digit_set[v & 0xF];
+				v >>= 4;
+			} while( v );
+			return p;
+		}
+
+		static void emit_value(sink *out, const instr &op, value v) {
+			char  buf[64];
+			char *end = buf + sizeof(buf);
+			char *p   = end;
+
+			switch( op.type ) {
+				case conv::none:
+					return;
+
+				case conv::str: {
+					const char *s = v.s ? v.s : "(null)";
+					emit_padded(out, s, kstd::strlen(s), op);
+					return;
+				}
+
+				case conv::chr:
+					*--p = (char) v.u;
+					break;
+
+				case conv::sdec: {
+					int64_t n = (op.flags & FLAG_LL)
+					                ? (int64_t) v.u
+					                : (int64_t) (int32_t) (uint32_t) v.u;
+					uint64_t mag = n < 0 ? 0 - (uint64_t) n : (uint64_t) n;
+					p            = render_dec(end, mag);
+					if( n < 0 )
+						*--p = '-';
+					break;
+				}
+
+				case conv::udec:
+					p = render_dec(end,
+					               (op.flags & FLAG_LL) ? v.u
+					                                    : (uint32_t) v.u);
+					break;
+
+				case conv::hex:
+				case conv::hex_upper:
+					p = render_hex(end,
+					               (op.flags & FLAG_LL) ? v.u
+					                                    : (uint32_t) v.u,
+					               op.type == conv::hex ? digits_lower
+					                                    : digits_upper);
+					break;
+
+				case conv::flt:
+					kstd::format_double(buf, sizeof(buf), v.d, op.precision);
+					emit_padded(out, buf, kstd::strlen(buf), op);
+					return;
+			}
+
+			emit_padded(out, p, (size_t) (end - p), op);
+		}
+
+		void run(const char  *str,
+		         const instr *ops,
+		         size_t       count,
+		         const value *values,
+		         sink        *out) {
+			for( size_t i = 0; i < count; ++i ) {
+				const instr &op = ops[i];
+
+				if( op.lit_len )
+					out->write(out, str + op.lit_off, op.lit_len);
+
+				if( op.type != conv::none )
+					emit_value(out, op, *values++);
+			}
+		}
+	}  // namespace fmt
+}  // namespace kstd
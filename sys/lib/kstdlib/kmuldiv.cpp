@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kmuldiv.h>
+
+namespace kstd {
+	/**
+	 * @brief Full 128-bit product of @p a and @p b, in 64-bit halves
+	 */
+	static inline void mul64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo) {
+		uint64_t a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+		uint64_t b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+
+		uint64_t ll = a_lo * b_lo;
+		uint64_t lh = a_lo * b_hi;
+		uint64_t hl = a_hi * b_lo;
+		uint64_t hh = a_hi * b_hi;
+
+		// Cannot overflow: each term is below 2^32
+		uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+
+		*lo = (mid << 32) | (ll & 0xFFFFFFFFULL);
+		*hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	}
+
+	/**
+	 * @brief Divide the 128-bit @p u1:@p u0 by @p v, given u1 < v
+	 *
+	 * Knuth's algorithm D on 32-bit digits (Hacker's Delight, divlu), so
+	 * it only needs 64-bit divides.
+	 */
+	static uint64_t div128(uint64_t u1, uint64_t u0, uint64_t v) {
+		const uint64_t base = 1ULL << 32;
+
+		// Normalize so the divisor's top bit is set
+		unsigned s = (unsigned) __builtin_clzll(v);
+		v <<= s;
+		uint64_t vn1 = v >> 32;
+		uint64_t vn0 = v & 0xFFFFFFFFULL;
+
+		uint64_t un32 = (u1 << s) | (s ? u0 >> (64 - s) : 0);
+		uint64_t un10 = u0 << s;
+		uint64_t un1  = un10 >> 32;
+		uint64_t un0  = un10 & 0xFFFFFFFFULL;
+
+		uint64_t q1   = un32 / vn1;
+		uint64_t rhat = un32 - q1 * vn1;
+		while( q1 >= base || q1 * vn0 > base * rhat + un1 ) {
+			q1--;
+			rhat += vn1;
+			if( rhat >= base )
+				break;
+		}
+
+		uint64_t un21 = un32 * base + un1 - q1 * v;
+		uint64_t q0   = un21 / vn1;
+		rhat          = un21 - q0 * vn1;
+		while( q0 >= base || q0 * vn0 > base * rhat + un0 ) {
+			q0--;
+			rhat += vn1;
+			if( rhat >= base )
+				break;
+		}
+
+		return q1 * base + q0;
+	}
+
+	/**
+	 * @brief @p a * @p b / @p c, rounded down, without losing the product
+	 *
+	 * The product is kept at full 128-bit width, but only 64-bit multiplies
+	 * and divides are used: dividing an `unsigned __int128` would call
+	 * __udivti3 from libgcc, which the kernel does not link.  Takes one
+	 * divide when the product fits in 64 bits, two otherwise.
+	 *
+	 * @return The quotient, or ~0 if it does not fit in 64 bits or @p c is 0
+	 */
+	uint64_t mul_div64(uint64_t a, uint64_t b, uint64_t c) {
+		if( c == 0 )
+			return ~0ULL;
+
+		uint64_t hi, lo;
+		mul64(a, b, &hi, &lo);
+		if( hi == 0 )
+			return lo / c;
+		if( hi >= c )
+			return ~0ULL;
+		return div128(hi, lo, c);
+	}
+}  // namespace kstd
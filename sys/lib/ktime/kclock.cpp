@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#ifdef ARCH_AMD64
+#	include <arch/amd64/asm/io.h>
+#	include <arch/amd64/asm/msr.h>
+#	include <arch/amd64/cpu/cpuid.h>
+#endif
+#include <dbg/logger.h>
+#include <drv/hpet/hpet.h>
+#include <kmuldiv.h>
+#include <ktime.h>
+
+// Multiplies only; 128-bit divides would need libgcc, see kstd::mul_div64()
+__extension__ typedef unsigned __int128 u128;
+
+#define PIT_FREQUENCY   1193182
+#define PIT_CHANNEL2    0x42
+#define PIT_COMMAND     0x43
+#define PIT_GATE_PORT   0x61
+#define PIT_GATE2       0x01
+#define PIT_SPEAKER     0x02
+#define PIT_OUT2        0x20
+#define PIT_CH2_ONESHOT 0xB0  // Channel 2, lobyte/hibyte, mode 0, binary
+
+#define FS_PER_SECOND    1000000000000000ULL
+#define FS_PER_NS        1000000ULL
+#define CALIBRATE_MS     10
+#define CALIBRATE_ROUNDS 5
+
+namespace time {
+	/*
+	 * now_ns() = base_ns + (((counter - base_count) * mult) >> 32), where
+	 * mult is nanoseconds per counter tick in 32.32 fixed point.  The
+	 * product is taken in 128 bits so it never overflows.
+	 */
+	static clocksource source = clocksource::pit;
+	static uint64_t    source_hz  = TICKS_PER_SECOND;
+	static uint64_t    base_count = 0;
+	static uint64_t    base_ns    = 0;
+	static uint64_t    mult       = 0;
+
+	static inline uint64_t scale(uint64_t count) {
+		return base_ns + (uint64_t) (((u128) (count - base_count) * mult) >> 32);
+	}
+
+	/**
+	 * @brief Measure the TSC rate against the HPET main counter
+	 *
+	 * Each edge of the window is an HPET read bracketed by two TSC reads.
+	 * The midpoint of the bracket is used, and the round with the tightest
+	 * brackets wins, so an SMI or a slow MMIO read only discards a round.
+	 *
+	 * @return TSC frequency in Hz
+	 */
+	static uint64_t calibrate_hpet(uint64_t period_fs) {
+		uint64_t mask   = hpet::is_64bit() ? ~0ULL : 0xFFFFFFFFULL;
+		uint64_t window = CALIBRATE_MS * (FS_PER_SECOND / 1000) / period_fs;
+		uint64_t best_error = ~0ULL;
+		uint64_t best_hz    = 0;
+
+		for( int round = 0; round < CALIBRATE_ROUNDS; round++ ) {
+			uint64_t a0 = rdtsc_ordered();
+			uint64_t c0 = hpet::read_counter();
+			uint64_t b0 = rdtsc_ordered();
+
+			uint64_t a1, b1, c1;
+			do {
+				a1 = rdtsc_ordered();
+				c1 = hpet::read_counter();
+				b1 = rdtsc_ordered();
+			} while( ((c1 - c0) & mask) < window );
+
+			uint64_t error = (b0 - a0) + (b1 - a1);
+			if( error >= best_error )
+				continue;
+
+			uint64_t tsc_delta = ((a1 + b1) - (a0 + b0)) / 2;
+			uint64_t fs        = ((c1 - c0) & mask) * period_fs;
+			best_error         = error;
+			best_hz = kstd::mul_div64(tsc_delta, FS_PER_SECOND, fs);
+		}
+		return best_hz;
+	}
+
+	/**
+	 * @brief Measure the TSC rate against a one-shot on PIT channel 2
+	 *
+	 * Channel 2 is gated through port 0x61 and its output can be polled
+	 * there, so this leaves channel 0 (the tick) alone.  Delays can only
+	 * make a window look longer, so the shortest of the rounds is used.
+	 *
+	 * @return TSC frequency in Hz
+	 */
+	static uint64_t calibrate_pit(void) {
+		constexpr uint16_t latch =
+		    (uint16_t) (PIT_FREQUENCY * CALIBRATE_MS / 1000);
+
+		uint8_t  gate = inb(PIT_GATE_PORT);
+		uint64_t best = ~0ULL;
+
+		outb(PIT_GATE_PORT, (uint8_t) ((gate & ~PIT_SPEAKER) | PIT_GATE2));
+		for( int round = 0; round < CALIBRATE_ROUNDS; round++ ) {
+			outb(PIT_COMMAND, PIT_CH2_ONESHOT);
+			outb(PIT_CHANNEL2, (uint8_t) (latch & 0xFF));
+			outb(PIT_CHANNEL2, (uint8_t) (latch >> 8));
+
+			uint64_t start = rdtsc_ordered();
+			while( !(inb(PIT_GATE_PORT) & PIT_OUT2) )
+				cpu_relax();
+			uint64_t delta = rdtsc_ordered() - start;
+
+			if( delta < best )
+				best = delta;
+		}
+		outb(PIT_GATE_PORT, gate);
+
+		return best * PIT_FREQUENCY / latch;
+	}
+
+	/**
+	 * @brief Switch now_ns() to a new counter without a jump in time
+	 */
+	static void switch_source(clocksource next,
+	                          uint64_t    hz,
+	                          uint64_t    ns_mult,
+	                          uint64_t    count) {
+		base_ns    = now_ns();
+		base_count = count;
+		mult       = ns_mult;
+		source_hz  = hz;
+		source     = next;
+	}
+
+	/**
+	 * @brief Pick and calibrate the clocksource behind now_ns()
+	 *
+	 * The invariant TSC is preferred, calibrated against the HPET when
+	 * there is one and against the PIT otherwise.  Without an invariant
+	 * TSC the HPET is used directly if its counter is 64 bits wide, and
+	 * failing that now_ns() stays on the PIT tick count.
+	 *
+	 * Must run with interrupts disabled, after hpet::init().
+	 */
+	void clock_init(void) {
+		uint64_t period_fs = hpet::get_period_fs();
+
+		if( amd64::cpuid::instr::has_invariant_tsc() ) {
+			uint64_t hz = period_fs ? calibrate_hpet(period_fs)
+			                        : calibrate_pit();
+			if( hz ) {
+				uint64_t ns_mult =
+				    kstd::mul_div64(NS_PER_SECOND, 1ULL << 32, hz);
+				switch_source(
+				    clocksource::tsc, hz, ns_mult, rdtsc_ordered());
+			}
+		} else if( period_fs && hpet::is_64bit() ) {
+			switch_source(clocksource::hpet,
+			              FS_PER_SECOND / period_fs,
+			              (period_fs << 32) / FS_PER_NS,
+			              hpet::read_counter());
+		}
+
+		logger::debug::printf("time",
+		                      "info",
+		                      "clocksource %s, %llu Hz (HPET %s)\n",
+		                      get_clocksource_name(),
+		                      source_hz,
+		                      period_fs ? "present" : "absent");
+	}
+
+	/**
+	 * @brief Monotonic time since boot in nanoseconds
+	 */
+	uint64_t now_ns(void) {
+		switch( source ) {
+			case clocksource::tsc:
+				return scale(rdtsc_ordered());
+			case clocksource::hpet:
+				return scale(hpet::read_counter());
+			case clocksource::pit:
+				break;
+		}
+		return get_uptime_ticks() * (NS_PER_SECOND / TICKS_PER_SECOND);
+	}
+
+	clocksource get_clocksource(void) {
+		return source;
+	}
+
+	const char *get_clocksource_name(void) {
+		switch( source ) {
+			case clocksource::tsc:
+				return "tsc";
+			case clocksource::hpet:
+				return "hpet";
+			case clocksource::pit:
+				break;
+		}
+		return "pit";
+	}
+
+	/**
+	 * @brief Frequency of the counter behind now_ns()
+	 */
+	uint64_t get_clocksource_hz(void) {
+		return source_hz;
+	}
+
+	/**
+	 * @brief The conversion now_ns() applies to the TSC or HPET counter
+	 */
+	void get_clock_params(clock_params *params) {
+		params->base_count = base_count;
+		params->base_ns    = base_ns;
+		params->mult       = mult;
+	}
+}  // namespace time
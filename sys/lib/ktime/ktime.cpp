@@ -34,8 +34,7 @@
 
 namespace time {
 	// Uptime tracking variables
-	static volatile uint64_t uptime_ticks     = 0;
-	static const uint64_t    TICKS_PER_SECOND = 100;  // Assuming 100Hz timer
+	static volatile uint64_t uptime_ticks = 0;
 
 	/**
  * @brief Convert a BCD (Binary Coded Decimal) value to decimal
@@ -195,8 +194,8 @@ namespace time {
 		struct bios_time bios_time_val;
 		get_bios(&bios_time_val);
 
-		// Format: DD-MM-YYYY HH:MM
-		kstd::printf("%02d-%02d-%04d %02d:%02d",
+		// Format: DD-MM-YYYY HH:MM (the console printf never padded %d)
+		kstd::printf("%d-%d-%d %d:%d",
 		             bios_time_val.day,
 		             bios_time_val.month,
 		             bios_time_val.year,
@@ -256,18 +255,27 @@ namespace time {
 		uptime_ticks = uptime_ticks + 1;
 	}
 
+	/**
+     * @brief Get the number of timer ticks since uptime_init()
+     */
+	uint64_t get_uptime_ticks(void) {
+		return uptime_ticks;
+	}
+
 	/**
      * @brief Get the system uptime in seconds
      * 
      * @return Number of seconds the system has been running
      */
 	uint64_t get_uptime_seconds(void) {
-		return uptime_ticks / TICKS_PER_SECOND;
+		return now_ns() / NS_PER_SECOND;
 	}
 
+	/**
+     * @brief Get the system uptime in seconds, with the clocksource resolution
+     */
 	double get_uptime_precise(void) {
-		uint64_t ticks = uptime_ticks;
-		return (double) ticks / (double) TICKS_PER_SECOND;
+		return (double) now_ns() / (double) NS_PER_SECOND;
 	}
 
 	/**
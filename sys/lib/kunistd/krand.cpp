@@ -9,31 +9,125 @@
  * Copyright (c) Tempest Foundation, 2025
  * -- END OF METADATA HEADER --
  */
+#ifdef ARCH_AMD64
+#	include <arch/amd64/cpu/cpuid.h>
+#endif
 #include <krand.h>
 #include <kstdint.h>
 
+#include <kern/sched/sched.h>
+
 #define PCG32_MULT     6364136223846793005ULL
 #define PCG32_INIT_SEQ 0xDEADBEEFULL
 
-static uint64_t pcg_state  = 0;
-static uint64_t pcg_inc    = 0;
-static bool     pcg_inited = false;
+// Words fill() keeps in flight; the lanes replay the stream in order
+#define FILL_LANES 4
+
+// RDSEED/RDRAND may fail transiently when the entropy pool is drained
+#define HW_RNG_RETRIES 10
+
+// One cache line per CPU so neighbouring streams never share one
+struct alignas(64) pcg32_stream {
+	uint64_t state;
+	uint64_t inc;
+	bool     inited;
+};
+
+static pcg32_stream streams[KRAND_MAX_CPUS];
+static const char  *entropy_source = "none";
 
 namespace unistd {
 	namespace rand {
 
 		/**
- * @brief Read the CPU timestamp counter (lower 32 bits)
+ * @brief Read the full 64-bit CPU timestamp counter
+ *
+ * Last-resort entropy when neither RDSEED nor RDRAND is available.
  *
- * Uses the RDTSC instruction to obtain a relatively random,
- * time-based seed for entropy when initializing PRNG state.
+ * @return Current timestamp counter value
+ */
+		static inline uint64_t rdtsc64(void) {
+			uint32_t lo, hi;
+			__asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+			return ((uint64_t) hi << 32) | lo;
+		}
+
+		/**
+ * @brief Read a hardware seed with RDSEED (conditioned entropy source)
  *
- * @return Lower 32 bits of the CPU timestamp counter
+ * @param out Receives the value on success
+ * @return True if the CPU returned a value within HW_RNG_RETRIES tries
  */
-		static inline uint32_t rdtsc32(void) {
-			uint32_t lo;
-			__asm__ volatile("rdtsc" : "=a"(lo)::"edx");
-			return lo;
+		static bool rdseed64(uint64_t *out) {
+			for( int i = 0; i < HW_RNG_RETRIES; i++ ) {
+				uint64_t value;
+				uint8_t  ok;
+				__asm__ volatile("rdseed %0; setc %1"
+				                 : "=r"(value), "=qm"(ok)
+				                 :
+				                 : "cc");
+				if( ok ) {
+					*out = value;
+					return true;
+				}
+				__asm__ volatile("pause");
+			}
+			return false;
+		}
+
+		/**
+ * @brief Read a hardware random number with RDRAND (DRBG output)
+ *
+ * @param out Receives the value on success
+ * @return True if the CPU returned a value within HW_RNG_RETRIES tries
+ */
+		static bool rdrand64(uint64_t *out) {
+			for( int i = 0; i < HW_RNG_RETRIES; i++ ) {
+				uint64_t value;
+				uint8_t  ok;
+				__asm__ volatile("rdrand %0; setc %1"
+				                 : "=r"(value), "=qm"(ok)
+				                 :
+				                 : "cc");
+				if( ok ) {
+					*out = value;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+ * @brief SplitMix64 finalizer
+ *
+ * Spreads a low-entropy value such as a TSC reading over all 64 bits.
+ */
+		static inline uint64_t mix64(uint64_t z) {
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+		/**
+ * @brief Get 64 bits of seed material from the best available source
+ *
+ * Prefers RDSEED, then RDRAND, then the timestamp counter.
+ */
+		static uint64_t entropy64(void) {
+			uint64_t value;
+#ifdef ARCH_AMD64
+			if( amd64::cpuid::instr::has_rdseed() && rdseed64(&value) ) {
+				entropy_source = "rdseed";
+				return value;
+			}
+			if( amd64::cpuid::instr::has_rdrand() && rdrand64(&value) ) {
+				entropy_source = "rdrand";
+				return value;
+			}
+#endif
+			value          = mix64(rdtsc64() ^ PCG32_INIT_SEQ);
+			entropy_source = "rdtsc";
+			return value;
 		}
 
 		/**
@@ -52,7 +146,96 @@ namespace unistd {
 		}
 
 		/**
- * @brief Seed the PCG32 pseudo-random number generator
+ * @brief Compose @p delta LCG steps into a single multiply-add
+ *
+ * Brown's "random number generation with arbitrary strides": stepping
+ * the state @p delta times equals state * mult + plus. Runs in
+ * O(log delta).
+ *
+ * @param delta Number of steps
+ * @param inc   Stream increment
+ * @param mult  Receives the combined multiplier
+ * @param plus  Receives the combined increment
+ */
+		static void lcg_jump(uint64_t  delta,
+		                     uint64_t  inc,
+		                     uint64_t *mult,
+		                     uint64_t *plus) {
+			uint64_t cur_mult = PCG32_MULT;
+			uint64_t cur_plus = inc;
+			uint64_t acc_mult = 1;
+			uint64_t acc_plus = 0;
+
+			while( delta > 0 ) {
+				if( delta & 1 ) {
+					acc_mult *= cur_mult;
+					acc_plus = acc_plus * cur_mult + cur_plus;
+				}
+				cur_plus = (cur_mult + 1) * cur_plus;
+				cur_mult *= cur_mult;
+				delta >>= 1;
+			}
+
+			*mult = acc_mult;
+			*plus = acc_plus;
+		}
+
+		/**
+ * @brief Seed one PCG32 stream
+ *
+ * @param s    Stream to initialize
+ * @param seed 64-bit seed value
+ * @param seq  Stream selector; streams with different seq never overlap
+ */
+		static void seed_stream(pcg32_stream *s, uint64_t seed, uint64_t seq) {
+			s->state = 0;
+			s->inc   = (seq << 1) | 1;
+			// Advance the state a few times to mix up bits (PCG recommends at least once)
+			for( int i = 0; i < 3; i++ ) {
+				s->state = s->state * PCG32_MULT + s->inc;
+			}
+			s->state += seed;
+			s->state  = s->state * PCG32_MULT + s->inc;
+			s->inited = true;
+		}
+
+		/**
+ * @brief Index of the calling CPU's stream
+ */
+		static inline uint32_t current_cpu(void) {
+#ifdef ARCH_AMD64
+			return amd64::cpuid::get_core_id() % KRAND_MAX_CPUS;
+#else
+			return 0;
+#endif
+		}
+
+		/**
+ * @brief Get the calling CPU's stream, seeding it on first use
+ *
+ * Every CPU gets its own stream selector, so two CPUs never produce
+ * the same sequence even when their seeds happen to match.  Call with
+ * preemption off and keep it off until the state update is written
+ * back: a thread preempted in between would replay the outputs the
+ * next thread on this CPU already took.  Interrupt handlers must not
+ * use krand, since preemption off does not keep them out.
+ */
+		static pcg32_stream *current_stream(void) {
+			uint32_t      cpu = current_cpu();
+			pcg32_stream *s   = &streams[cpu];
+			if( !s->inited )
+				seed_stream(s, entropy64(), PCG32_INIT_SEQ + cpu);
+			return s;
+		}
+
+		static inline uint32_t next(pcg32_stream *s) {
+			uint64_t prev_state = s->state;
+			s->state            = prev_state * PCG32_MULT + s->inc;
+			return pcg32_output(prev_state);
+		}
+
+		/**
+ * @brief Seed the calling CPU's PCG32 stream
  *
  * The seed and stream selector (seq) are used to initialize
  * the state and increment value of the PCG32 generator.
@@ -61,43 +244,63 @@ namespace unistd {
  * @param seq Per-stream sequence selector (stream id)
  */
 		void srand32(uint64_t seed, uint64_t seq) {
-			pcg_state = 0;
-			pcg_inc   = (seq << 1) | 1;
-			// Advance the state a few times to mix up bits (PCG recommends at least once)
-			for( int i = 0; i < 3; i++ ) {
-				pcg_state = pcg_state * PCG32_MULT + pcg_inc;
-			}
-			pcg_state += seed;
-			pcg_state  = pcg_state * PCG32_MULT + pcg_inc;
-			pcg_inited = true;
+			sched::preempt_disable();
+			seed_stream(&streams[current_cpu()], seed, seq);
+			sched::preempt_enable();
 		}
 
 		/**
- * @brief Ensure PCG32 is initialized; seed from timestamp if not
+ * @brief Seed every per-CPU stream from a single seed
+ *
+ * CPU n gets stream selector PCG32_INIT_SEQ + n, so the streams stay
+ * independent and the whole set is reproducible from @p seed.
  *
- * If the PRNG has not yet been explicitly seeded, this will
- * use the current timestamp counter as entropy.
+ * @param seed 64-bit seed value
  */
-		static void ensure_pcg_init(void) {
-			if( !pcg_inited ) {
-				uint32_t t = rdtsc32();
-				srand32((uint64_t) t, (uint64_t) (t ^ PCG32_INIT_SEQ));
-			}
+		void seed(uint64_t seed) {
+			for( uint32_t cpu = 0; cpu < KRAND_MAX_CPUS; cpu++ )
+				seed_stream(&streams[cpu], seed, PCG32_INIT_SEQ + cpu);
+			entropy_source = "manual";
+		}
+
+		/**
+ * @brief Jump the calling CPU's stream @p delta outputs ahead
+ *
+ * Useful to hand out disjoint slices of a single stream.
+ *
+ * @param delta Number of 32-bit outputs to skip
+ */
+		void advance(uint64_t delta) {
+			sched::preempt_disable();
+			pcg32_stream *s = current_stream();
+			uint64_t      mult, plus;
+			lcg_jump(delta, s->inc, &mult, &plus);
+			s->state = s->state * mult + plus;
+			sched::preempt_enable();
+		}
+
+		/**
+ * @brief Name of the source that seeded the streams
+ *
+ * @return "rdseed", "rdrand", "rdtsc", "manual", or "none" before first use
+ */
+		const char *seed_source(void) {
+			return entropy_source;
 		}
 
 		/**
  * @brief Get a random unsigned 32-bit integer
  *
- * Generates a new random number from the PCG32 state.
+ * Generates a new random number from the calling CPU's stream.
  * Automatically initializes the generator if needed.
  *
  * @return A random 32-bit unsigned integer
  */
 		uint32_t unsign(void) {
-			ensure_pcg_init();
-			uint64_t prev_state = pcg_state;
-			pcg_state           = prev_state * PCG32_MULT + pcg_inc;
-			return pcg32_output(prev_state);
+			sched::preempt_disable();
+			uint32_t value = next(current_stream());
+			sched::preempt_enable();
+			return value;
 		}
 
 		/**
@@ -110,5 +313,56 @@ namespace unistd {
 		int32_t sign(void) {
 			return (int32_t) unsign();
 		}
+
+		/**
+ * @brief Fill a buffer with random bytes
+ *
+ * Produces exactly the bytes that repeated unsign() calls would, in
+ * little-endian order, but runs FILL_LANES copies of the generator
+ * FILL_LANES steps apart so the multiplies overlap instead of waiting
+ * on each other. Each round stores FILL_LANES words at once.
+ * Preemption stays off for the whole buffer.
+ *
+ * @param buf Destination
+ * @param len Number of bytes
+ */
+		void fill(void *buf, size_t len) {
+			sched::preempt_disable();
+			pcg32_stream *s   = current_stream();
+			uint8_t      *out = (uint8_t *) buf;
+
+			if( len >= FILL_LANES * sizeof(uint32_t) ) {
+				uint64_t mult, plus;
+				lcg_jump(FILL_LANES, s->inc, &mult, &plus);
+
+				uint64_t lane[FILL_LANES];
+				lane[0] = s->state;
+				for( int i = 1; i < FILL_LANES; i++ )
+					lane[i] = lane[i - 1] * PCG32_MULT + s->inc;
+
+				while( len >= FILL_LANES * sizeof(uint32_t) ) {
+					uint32_t words[FILL_LANES];
+					for( int i = 0; i < FILL_LANES; i++ ) {
+						words[i] = pcg32_output(lane[i]);
+						lane[i]  = lane[i] * mult + plus;
+					}
+					__builtin_memcpy(out, words, sizeof(words));
+					out += sizeof(words);
+					len -= sizeof(words);
+				}
+
+				// Lane 0 now holds the first unused state
+				s->state = lane[0];
+			}
+
+			while( len > 0 ) {
+				uint32_t word = next(s);
+				for( int i = 0; i < 4 && len > 0; i++, len-- ) {
+					*out++ = (uint8_t) word;
+					word >>= 8;
+				}
+			}
+			sched::preempt_enable();
+		}
 	}  // namespace rand
 }  // namespace unistd
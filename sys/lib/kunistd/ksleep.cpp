@@ -11,78 +11,81 @@
  */
 #ifdef ARCH_AMD64
 #	include <arch/amd64/asm/io.h>
+#	include <arch/amd64/asm/irqflags.h>
 #endif
 #include <ksleep.h>
 #include <kstddef.h>
 #include <kstdint.h>
+#include <ktime.h>
 
-volatile uint64_t *hpet = (volatile uint64_t *) 0xFED00000;
+#include <kern/timer/hrtimer.h>
 
-#define HPET_GEN_CONF        0x10
-#define HPET_MAIN_COUNTER    0xF0
-#define HPET_CAP_ID          0x0
-#define HPET_GEN_CONF_ENABLE (1 << 0)
-
-#define PIT_CHANNEL0 0x40
-#define PIT_COMMAND  0x43
+#define PIT_FREQUENCY   1193182
+#define PIT_CHANNEL2    0x42
+#define PIT_COMMAND     0x43
+#define PIT_GATE_PORT   0x61
+#define PIT_GATE2       0x01
+#define PIT_SPEAKER     0x02
+#define PIT_OUT2        0x20
+#define PIT_CH2_ONESHOT 0xB0  // Channel 2, lobyte/hibyte, mode 0, binary
 
 namespace unistd {
 	namespace sleep {
-		/**
- * @brief Enables the HPET timer if it is not already enabled
- */
-		static void hpet_enable(void) {
-			if( (hpet[HPET_GEN_CONF / 8] & HPET_GEN_CONF_ENABLE) == 0 ) {
-				hpet[HPET_GEN_CONF / 8] |= HPET_GEN_CONF_ENABLE;
-			}
-		}
-
 		/**
  * @brief Busy-wait for an approximate duration in milliseconds using the PIT
  *
+ * Runs 1 ms one-shots on channel 2, which is polled through port 0x61, so
+ * channel 0 (the timer interrupt) is left alone.
+ *
  * @param ms Number of milliseconds to wait
  */
 		static void pit_wait(int ms) {
-			outb(PIT_COMMAND, 0x34);
+			constexpr uint16_t reload = PIT_FREQUENCY / 1000;  // ~1 ms
 
-			uint16_t reload = 1193;  // ~1 ms (1193182 Hz / 1000)
-			outb(PIT_CHANNEL0, (uint8_t) (reload & 0xFF));
-			outb(PIT_CHANNEL0, (uint8_t) ((reload >> 8) & 0xFF));
+			uint8_t gate = inb(PIT_GATE_PORT);
+			uint8_t on   = (uint8_t) ((gate & ~PIT_SPEAKER) | PIT_GATE2);
+			outb(PIT_GATE_PORT, on);
 
 			for( int i = 0; i < ms; i++ ) {
-				uint8_t prev = 0xFF, curr = 0;
-				do {
-					curr = inb(PIT_CHANNEL0);
-					if( curr > prev )
-						break;
-					prev = curr;
-				} while( curr != 0 );
+				outb(PIT_COMMAND, PIT_CH2_ONESHOT);
+				outb(PIT_CHANNEL2, (uint8_t) (reload & 0xFF));
+				outb(PIT_CHANNEL2, (uint8_t) ((reload >> 8) & 0xFF));
+				while( !(inb(PIT_GATE_PORT) & PIT_OUT2) )
+					cpu_relax();
 			}
+
+			outb(PIT_GATE_PORT, gate);
 		}
 
 		/**
  * @brief Sleeps for a given number of milliseconds
  *
- * Uses HPET for high-resolution sleep if available, otherwise falls back to PIT busy-wait.
+ * With interrupts on, sleeps on a high-resolution timer with the widest
+ * slack: the calling thread blocks, or the CPU halts before the scheduler
+ * is up, for the whole duration.  With interrupts off (panic paths)
+ * nothing can wake a halted CPU, so it spins on now_ns() instead, or on the
+ * PIT when now_ns() only advances with the tick.
  *
  * @param ms Number of milliseconds to sleep
  */
 		void sleep(int ms) {
-			if( hpet != nullptr ) {
-				hpet_enable();
+			if( ms <= 0 )
+				return;
 
-				uint64_t period_fs = hpet[HPET_CAP_ID / 8] >> 32;
-				uint64_t start     = hpet[HPET_MAIN_COUNTER / 8];
+			uint64_t deadline = time::now_ns() + (uint64_t) ms * 1000000ULL;
 
-				uint64_t ticks =
-				    (uint64_t) ms * 1000000000ULL / (period_fs / 1000);
+			if( irq_enabled() ) {
+				hrtimer::sleep_until(deadline, hrtimer::MAX_SLACK_NS);
+				return;
+			}
 
-				while( (hpet[HPET_MAIN_COUNTER / 8] - start) < ticks ) {
+			if( time::get_clocksource() != time::clocksource::pit ) {
+				while( time::now_ns() < deadline )
 					cpu_relax();
-				}
-			} else {
-				pit_wait(ms);
+				return;
 			}
+
+			pit_wait(ms);
 		}
 	}  // namespace sleep
 }  // namespace unistd
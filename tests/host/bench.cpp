@@ -0,0 +1,550 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "harness.h"
+#include "kshim.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Microbenchmarks.  Every benchmark runs a batch of operations through the
+ * kernel code; the batch is sized to take about TARGET_NS and the best of
+ * ROUNDS batches is reported, which filters out most scheduler noise.
+ */
+namespace host {
+	static constexpr double TARGET_NS = 5e6;
+	static constexpr int    ROUNDS    = 5;
+
+	// Beyond this change against the baseline a result is marked
+	static constexpr double NOTABLE = 0.10;
+
+	struct bench {
+		std::string name;
+		double      bytes;  // Bytes handled per operation, 0 if not meaningful
+
+		// Run n operations; the return value is only there to keep the
+		// work from being optimised away
+		std::function<uint64_t(uint64_t n)> run;
+	};
+
+	static volatile uint64_t sink;
+
+	static double now_ns(void) {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+	}
+
+	static double time_batch(const bench &b, uint64_t n) {
+		double t0 = now_ns();
+		sink      = sink + b.run(n);
+		return now_ns() - t0;
+	}
+
+	// Nanoseconds per operation
+	static double measure(const bench &b) {
+		uint64_t n = 1;
+		double   t;
+		while( (t = time_batch(b, n)) < TARGET_NS / 16 )
+			n *= 2;
+		n = (uint64_t) ((double) n * TARGET_NS / t) + 1;
+
+		double best = INFINITY;
+		for( int i = 0; i < ROUNDS; i++ )
+			best = std::fmin(best, time_batch(b, n) / (double) n);
+		return best;
+	}
+
+	/*
+	 * Inputs.  Buffers are 64-byte aligned and reused, so the sizes up to
+	 * 64K measure the functions out of L1/L2 rather than out of memory.
+	 */
+	static constexpr size_t MAX_SIZE = 65536;
+	static const size_t     sizes[]  = {16, 256, 4096, 65536};
+
+	alignas(64) static char src[MAX_SIZE + 64];
+	alignas(64) static char dst[MAX_SIZE + 64];
+	alignas(64) static char str[MAX_SIZE + 64];
+	alignas(64) static char str2[MAX_SIZE + 64];
+
+	static void prepare_strings(size_t len) {
+		std::memset(str, 'a', len);
+		str[len] = '\0';
+		std::memcpy(str2, str, len + 1);
+	}
+
+	static std::string sized(const char *name, size_t size) {
+		return std::string(name) + "/" + std::to_string(size);
+	}
+
+	/*
+	 * One call of a kstring function on n bytes.  The string functions all
+	 * scan a string of n - 1 characters set up by prepare_strings().
+	 */
+	typedef uint64_t (*sized_op)(size_t n);
+
+	static uint64_t op_memcpy(size_t n) {
+		return (uint64_t) klib.memcpy(dst, src, n);
+	}
+
+	static uint64_t op_mempcpy(size_t n) {
+		return (uint64_t) klib.mempcpy(dst, src, n);
+	}
+
+	static uint64_t op_memset(size_t n) {
+		return (uint64_t) klib.memset(dst, (int) n, n);
+	}
+
+	static uint64_t op_memcmp(size_t n) {
+		return (uint64_t) klib.memcmp(dst, src, n);
+	}
+
+	static uint64_t op_strlen(size_t) {
+		return klib.strlen(str);
+	}
+
+	static uint64_t op_strnlen(size_t n) {
+		return klib.strnlen(str, n);
+	}
+
+	static uint64_t op_strchr(size_t) {
+		return (uint64_t) klib.strchr(str, 'z');
+	}
+
+	static uint64_t op_strrchr(size_t) {
+		return (uint64_t) klib.strrchr(str, 'a');
+	}
+
+	static uint64_t op_strcmp(size_t) {
+		return (uint64_t) klib.strcmp(str, str2);
+	}
+
+	static uint64_t op_strncmp(size_t n) {
+		return (uint64_t) klib.strncmp(str, str2, n);
+	}
+
+	static uint64_t op_strcpy(size_t) {
+		return (uint64_t) klib.strcpy(dst, str);
+	}
+
+	// Half copy, half padding
+	static uint64_t op_strncpy(size_t n) {
+		return (uint64_t) klib.strncpy(dst, str + n / 2, n);
+	}
+
+	// The op is a template argument so the loop calls the kernel directly
+	template <sized_op OP>
+	static void add_sized(std::vector<bench> &out, const char *name) {
+		for( size_t n : sizes ) {
+			out.push_back({sized(name, n), (double) n, [n](uint64_t iters) {
+				               // Equal buffers, so memcmp() reads all of them
+				               std::memcpy(dst, src, n);
+				               prepare_strings(n - 1);
+
+				               uint64_t acc = 0;
+				               for( uint64_t i = 0; i < iters; i++ )
+					               acc += OP(n);
+				               return acc;
+			               }});
+		}
+	}
+
+	static void add_kstring(std::vector<bench> &out) {
+		add_sized<op_memcpy>(out, "memcpy");
+		add_sized<op_mempcpy>(out, "mempcpy");
+		add_sized<op_memset>(out, "memset");
+		add_sized<op_memcmp>(out, "memcmp");
+		add_sized<op_strlen>(out, "strlen");
+		add_sized<op_strnlen>(out, "strnlen");
+		add_sized<op_strchr>(out, "strchr");
+		add_sized<op_strrchr>(out, "strrchr");
+		add_sized<op_strcmp>(out, "strcmp");
+		add_sized<op_strncmp>(out, "strncmp");
+		add_sized<op_strcpy>(out, "strcpy");
+		add_sized<op_strncpy>(out, "strncpy");
+	}
+
+	/*
+	 * Operations without a meaningful size.  The counter i varies the
+	 * input so nothing is hoisted out of the loop.
+	 */
+	typedef uint64_t (*plain_op)(uint64_t i);
+
+	static const char *numbers[] = {
+	    "7", "-42", "  123456", "2147483647", "-987654321"};
+
+	static uint64_t op_atoi(uint64_t i) {
+		return (uint64_t) klib.atoi(numbers[i % 5]);
+	}
+
+	static uint64_t op_strtol10(uint64_t i) {
+		return (uint64_t) klib.strtol(numbers[i % 5], nullptr, 10);
+	}
+
+	static uint64_t op_strtol16(uint64_t i) {
+		return (uint64_t) klib.strtol("0xDEADbeef1234" + (i & 1), nullptr, 16);
+	}
+
+	static uint64_t op_itoa10(uint64_t i) {
+		char  buf[32];
+		long  v   = (long) (i * 2654435761ULL);
+		char *end = klib.itoa(buf, buf + sizeof(buf), v, 10, 0);
+		return (uint64_t) (end - buf);
+	}
+
+	static uint64_t op_utoa16(uint64_t i) {
+		char          buf[32];
+		unsigned long v   = i * 0x9E3779B97F4A7C15ULL;
+		char         *end = klib.utoa(buf, buf + sizeof(buf), v, 16, 0);
+		return (uint64_t) (end - buf);
+	}
+
+	template <plain_op OP>
+	static void add_plain(std::vector<bench> &out, const char *name) {
+		out.push_back({name, 0, [](uint64_t iters) {
+			               uint64_t acc = 0;
+			               for( uint64_t i = 0; i < iters; i++ )
+				               acc += OP(i);
+			               return acc;
+		               }});
+	}
+
+	static void add_kstdlib(std::vector<bench> &out) {
+		add_plain<op_atoi>(out, "atoi");
+		add_plain<op_strtol10>(out, "strtol/10");
+		add_plain<op_strtol16>(out, "strtol/16");
+		add_plain<op_itoa10>(out, "itoa/10");
+		add_plain<op_utoa16>(out, "utoa/16");
+	}
+
+	// Each operation classifies a 4K buffer of mixed text
+	static void add_kctype(std::vector<bench> &out) {
+		static const char    sample[] = "The quick brown fox, 12 jumps!\t\n";
+		static unsigned char text[4096];
+		for( size_t i = 0; i < sizeof(text); i++ )
+			text[i] = (unsigned char) sample[i % 32] ^ (i % 97 ? 0 : 0x80);
+
+		for( size_t f = 0; kshim_ctypes[f].name; f++ ) {
+			int (*fn)(int) = kshim_ctypes[f].fn;
+			const char *name = kshim_ctypes[f].name;
+			out.push_back({name, sizeof(text), [fn](uint64_t iters) {
+				               uint64_t acc = 0;
+				               for( uint64_t i = 0; i < iters; i++ )
+					               for( unsigned char c : text )
+						               acc += (uint64_t) fn(c);
+				               return acc;
+			               }});
+		}
+	}
+
+	static void add_kprint(std::vector<bench> &out) {
+		for( size_t f = 0; kshim_formats[f].format; f++ ) {
+			const kshim_format *k    = &kshim_formats[f];
+			std::string         name = std::string("snprintf/") + k->format;
+			out.push_back({name, 0, [k](uint64_t iters) {
+				               char     buf[64];
+				               uint64_t acc = 0;
+				               for( uint64_t i = 0; i < iters; i++ ) {
+					               long long v = (long long) (i * 7919);
+					               double    d = (double) v / 8;
+					               int       n = k->run(buf, 64, v, d, "kernel");
+					               acc += (uint64_t) n;
+				               }
+				               return acc;
+			               }});
+		}
+	}
+
+	/*
+	 * Math inputs cycle through a table of 1024 values in each function's
+	 * natural range, so the branches see realistic data.
+	 */
+	static constexpr size_t MATH_N = 1024;
+
+	struct math_range {
+		const char *name;
+		double      lo, hi;
+	};
+
+	static const math_range math_ranges[] = {
+	    {"sin", -10, 10},       {"cos", -10, 10},         {"tan", -10, 10},
+	    {"asin", -1, 1},        {"acos", -1, 1},          {"atan", -10, 10},
+	    {"exp", -50, 50},       {"exp2", -50, 50},        {"expm1", -1, 1},
+	    {"log", 1e-3, 1e3},     {"log2", 1e-3, 1e3},      {"log10", 1e-3, 1e3},
+	    {"log1p", -0.5, 10},    {"sqrt", 0, 1e6},         {"cbrt", -1e6, 1e6},
+	    {"pow", 0.1, 10},       {"atan2", -10, 10},       {"hypot", -1e3, 1e3},
+	    {"fmod", -1e3, 1e3},    {"remainder", -1e3, 1e3},
+	};
+
+	static void fill_inputs(double *x, const char *name, uint64_t seed) {
+		double lo = -1e6, hi = 1e6;
+		for( const math_range &m : math_ranges ) {
+			if( !std::strcmp(m.name, name) ) {
+				lo = m.lo;
+				hi = m.hi;
+			}
+		}
+
+		rng r = {seed};
+		for( size_t i = 0; i < MATH_N; i++ )
+			x[i] = r.uniform(lo, hi);
+	}
+
+	static void add_kmath(std::vector<bench> &out) {
+		static double xs[64][MATH_N], ys[64][MATH_N], res[MATH_N];
+		size_t        slot = 0;
+
+		for( size_t f = 0; kshim_math1s[f].name; f++, slot++ ) {
+			double (*fn)(double) = kshim_math1s[f].fn;
+			const double *x      = xs[slot];
+			fill_inputs(xs[slot], kshim_math1s[f].name, 1);
+			out.push_back({kshim_math1s[f].name, 0, [fn, x](uint64_t iters) {
+				               double acc = 0;
+				               for( uint64_t i = 0; i < iters; i++ )
+					               acc += fn(x[i % MATH_N]);
+				               return (uint64_t) acc;
+			               }});
+		}
+
+		for( size_t f = 0; kshim_math2s[f].name; f++, slot++ ) {
+			double (*fn)(double, double) = kshim_math2s[f].fn;
+			const char   *name           = kshim_math2s[f].name;
+			const double *x              = xs[slot];
+			const double *y              = ys[slot];
+			fill_inputs(xs[slot], name, 1);
+			fill_inputs(ys[slot], name, 2);
+			out.push_back({name, 0, [fn, x, y](uint64_t iters) {
+				               double acc = 0;
+				               for( uint64_t i = 0; i < iters; i++ ) {
+					               size_t j = i % MATH_N;
+					               acc += fn(x[j], y[j]);
+				               }
+				               return (uint64_t) acc;
+			               }});
+		}
+
+		// One operation is one element, so the numbers compare to scalar
+		for( size_t f = 0; kshim_batches[f].name; f++, slot++ ) {
+			const kshim_batch *b    = &kshim_batches[f];
+			const double      *x    = xs[slot];
+			std::string        name = std::string(b->name) + "_n";
+			fill_inputs(xs[slot], b->name, 1);
+			out.push_back({name, 0, [b, x](uint64_t iters) {
+				               for( uint64_t i = 0; i < iters; i += MATH_N )
+					               b->fn(x, res, MATH_N);
+				               return (uint64_t) res[0];
+			               }});
+		}
+
+		for( size_t f = 0; kshim_batches2[f].name; f++, slot++ ) {
+			const kshim_batch2 *b    = &kshim_batches2[f];
+			const double       *x    = xs[slot];
+			const double       *y    = ys[slot];
+			std::string         name = std::string(b->name) + "_n";
+			fill_inputs(xs[slot], b->name, 1);
+			fill_inputs(ys[slot], b->name, 2);
+			out.push_back({name, 0, [b, x, y](uint64_t iters) {
+				               for( uint64_t i = 0; i < iters; i += MATH_N )
+					               b->fn(x, y, res, MATH_N);
+				               return (uint64_t) res[0];
+			               }});
+		}
+	}
+
+	/*
+	 * 32K-bit maps, the size of an ext2 block bitmap with 4K blocks.  The
+	 * searches find their bit in the last word, so each one scans the whole
+	 * map the way an allocator does on a nearly full (or empty) group.
+	 */
+	static constexpr size_t BITMAP_BITS  = 32768;
+	static constexpr size_t BITMAP_WORDS = BITMAP_BITS / 64;
+
+	alignas(64) static unsigned long long full_map[BITMAP_WORDS];
+	alignas(64) static unsigned long long empty_map[BITMAP_WORDS];
+	alignas(64) static unsigned long long mixed_map[BITMAP_WORDS];
+
+	static uint64_t op_find_zero(uint64_t i) {
+		return klib.bitmap_find_next_zero(full_map, BITMAP_BITS, i % 64);
+	}
+
+	static uint64_t op_find_set(uint64_t i) {
+		return klib.bitmap_find_next_set(empty_map, BITMAP_BITS, i % 64);
+	}
+
+	static uint64_t op_popcount(uint64_t i) {
+		return klib.bitmap_popcount(mixed_map, i % 64, BITMAP_BITS - 64);
+	}
+
+	template <plain_op OP>
+	static void add_bitmap(std::vector<bench> &out, const char *name) {
+		std::string label = sized(name, BITMAP_BITS);
+		out.push_back({label, sizeof(full_map), [](uint64_t iters) {
+			               uint64_t acc = 0;
+			               for( uint64_t i = 0; i < iters; i++ )
+				               acc += OP(i);
+			               return acc;
+		               }});
+	}
+
+	static void add_kbitmap(std::vector<bench> &out) {
+		rng r = {3};
+		for( size_t w = 0; w < BITMAP_WORDS; w++ ) {
+			full_map[w]  = ~0ULL;
+			empty_map[w] = 0;
+			mixed_map[w] = r.next();
+		}
+		full_map[BITMAP_WORDS - 1]  = ~0ULL >> 1;
+		empty_map[BITMAP_WORDS - 1] = 1ULL << 63;
+
+		add_bitmap<op_find_zero>(out, "bitmap_find_zero");
+		add_bitmap<op_find_set>(out, "bitmap_find_set");
+		add_bitmap<op_popcount>(out, "bitmap_popcount");
+	}
+
+	static std::map<std::string, double> load_baseline(const char *path, bool &ok) {
+		std::map<std::string, double> out;
+		FILE                         *f = std::fopen(path, "r");
+		ok                              = f != nullptr;
+		if( !f )
+			return out;
+
+		char line[256];
+		while( std::fgets(line, sizeof(line), f) ) {
+			if( line[0] == '#' || line[0] == '\n' )
+				continue;
+			// The name may contain spaces (format strings); the value is last
+			char *space = std::strrchr(line, ' ');
+			if( !space )
+				continue;
+			*space    = '\0';
+			out[line] = std::strtod(space + 1, nullptr);
+		}
+		std::fclose(f);
+		return out;
+	}
+
+	// CPU model from /proc/cpuinfo, so a baseline records where it came from
+	static std::string cpu_name(void) {
+		FILE *f = std::fopen("/proc/cpuinfo", "r");
+		if( !f )
+			return "unknown";
+
+		char        line[256];
+		std::string name = "unknown";
+		while( std::fgets(line, sizeof(line), f) ) {
+			char *colon = std::strchr(line, ':');
+			if( std::strncmp(line, "model name", 10) || !colon )
+				continue;
+			name = colon + 2;
+			if( !name.empty() && name.back() == '\n' )
+				name.pop_back();
+			break;
+		}
+		std::fclose(f);
+		return name;
+	}
+
+	static std::string rate(double bytes, double ns) {
+		if( bytes <= 0 )
+			return "";
+		char   buf[32];
+		double bps = bytes / ns * 1e9;
+		if( bps >= 1e9 )
+			std::snprintf(buf, sizeof(buf), "%8.2f GB/s", bps / 1e9);
+		else
+			std::snprintf(buf, sizeof(buf), "%8.2f MB/s", bps / 1e6);
+		return buf;
+	}
+
+	int run_benches(const char *filter, const char *baseline, const char *save) {
+		std::vector<bench> benches;
+		add_kstring(benches);
+		add_kstdlib(benches);
+		add_kctype(benches);
+		add_kprint(benches);
+		add_kmath(benches);
+		add_kbitmap(benches);
+
+		bool                          have_base = false;
+		std::map<std::string, double> base;
+		if( baseline ) {
+			base = load_baseline(baseline, have_base);
+			if( !have_base )
+				std::fprintf(stderr, "cannot read %s\n", baseline);
+		}
+
+		FILE *out = nullptr;
+		if( save ) {
+			out = std::fopen(save, "w");
+			if( !out ) {
+				std::fprintf(stderr, "cannot write %s\n", save);
+				return 1;
+			}
+			std::fprintf(out,
+			             "# Host benchmark baseline: <name> <ns/op>\n"
+			             "# Regenerate with 'make host-baseline' on an idle box.\n"
+			             "# cpu: %s\n",
+			             cpu_name().c_str());
+		}
+
+		std::printf("%-28s %12s %13s %12s %8s\n",
+		            "benchmark",
+		            "ns/op",
+		            "rate",
+		            "baseline",
+		            "change");
+
+		int slower = 0, faster = 0;
+		for( const bench &b : benches ) {
+			if( !std::strstr(b.name.c_str(), filter) )
+				continue;
+
+			double ns = measure(b);
+			std::printf("%-28s %12.2f %13s",
+			            b.name.c_str(),
+			            ns,
+			            rate(b.bytes, ns).c_str());
+
+			auto it = base.find(b.name);
+			if( it != base.end() && it->second > 0 ) {
+				double change = ns / it->second - 1;
+				std::printf(" %12.2f %+7.1f%%", it->second, change * 100);
+				if( change > NOTABLE )
+					std::printf("  slower");
+				else if( change < -NOTABLE )
+					std::printf("  faster");
+				slower += change > NOTABLE;
+				faster += change < -NOTABLE;
+			}
+			std::printf("\n");
+			std::fflush(stdout);
+
+			if( out )
+				std::fprintf(out, "%s %.3f\n", b.name.c_str(), ns);
+		}
+
+		if( have_base )
+			std::printf("%d slower, %d faster than the baseline by over %.0f%%\n",
+			            slower,
+			            faster,
+			            NOTABLE * 100);
+		if( out )
+			std::fclose(out);
+		return 0;
+	}
+}  // namespace host
@@ -0,0 +1,1250 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "harness.h"
+#include "kshim.h"
+
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Property tests: every kernel function is run on random inputs next to the
+ * host C library (or a plain reference) and the results must agree.
+ */
+namespace host {
+	static constexpr int    ITERS       = 20000;
+	static constexpr int    MAX_REPORTS = 5;
+	static constexpr size_t BUF         = 4096;
+	static constexpr size_t GUARD       = 64;
+
+	static int failures;
+
+	static void fail(const char *fmt, ...) {
+		if( ++failures > MAX_REPORTS )
+			return;
+		va_list ap;
+		va_start(ap, fmt);
+		std::fputs("    ", stdout);
+		std::vprintf(fmt, ap);
+		std::fputc('\n', stdout);
+		va_end(ap);
+	}
+
+	static int sign(int v) {
+		return (v > 0) - (v < 0);
+	}
+
+	// Small alphabet so searches hit, with bytes above 0x7F for the
+	// signed/unsigned compare cases
+	static char random_char(rng &r) {
+		static const char alphabet[] = "abcxyzABC019 ,;:\x7f\x80\xfe\xff";
+		return alphabet[r.below(sizeof(alphabet) - 1)];
+	}
+
+	static void random_string(rng &r, char *s, size_t len) {
+		for( size_t i = 0; i < len; i++ )
+			s[i] = random_char(r);
+		s[len] = '\0';
+	}
+
+	static size_t random_len(rng &r) {
+		// Mostly short, sometimes long
+		return r.below(8) ? r.below(64) : r.below(BUF / 2);
+	}
+
+	/*
+	 * kstring
+	 */
+
+	static void check_memcpy(rng &r) {
+		static unsigned char src[BUF], dst[BUF + GUARD], ref[BUF + GUARD];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			size_t so  = r.below(16);
+			size_t dof = r.below(16);
+			for( size_t i = 0; i < BUF; i++ )
+				src[i] = (unsigned char) r.next();
+			std::memset(dst, 0xA5, sizeof(dst));
+			std::memset(ref, 0xA5, sizeof(ref));
+
+			void *ret = klib.memcpy(dst + dof, src + so, len);
+			std::memcpy(ref + dof, src + so, len);
+			if( ret != dst + dof || std::memcmp(dst, ref, sizeof(dst)) ) {
+				fail("len %zu src+%zu dst+%zu", len, so, dof);
+				return;
+			}
+		}
+	}
+
+	// The kernel's memcpy() also handles overlap, like memmove()
+	static void check_memcpy_overlap(rng &r) {
+		static unsigned char buf[BUF], ref[BUF];
+		for( int it = 0; it < ITERS; it++ ) {
+			for( size_t i = 0; i < BUF; i++ )
+				buf[i] = ref[i] = (unsigned char) r.next();
+			size_t len = random_len(r);
+			size_t a   = r.below((uint32_t) (BUF - len));
+			size_t b   = r.below((uint32_t) (BUF - len));
+
+			klib.memcpy(buf + a, buf + b, len);
+			std::memmove(ref + a, ref + b, len);
+			if( std::memcmp(buf, ref, BUF) ) {
+				fail("len %zu dst %zu src %zu", len, a, b);
+				return;
+			}
+		}
+	}
+
+	static void check_mempcpy(rng &r) {
+		static unsigned char src[BUF], dst[BUF + GUARD];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			for( size_t i = 0; i < len; i++ )
+				src[i] = (unsigned char) r.next();
+			void *ret = klib.mempcpy(dst, src, len);
+			if( ret != dst + len || std::memcmp(dst, src, len) ) {
+				fail("len %zu", len);
+				return;
+			}
+		}
+	}
+
+	static void check_memset(rng &r) {
+		static unsigned char dst[BUF + GUARD], ref[BUF + GUARD];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			size_t off = r.below(16);
+			int    c   = (int) r.next();
+			std::memset(dst, 0x5A, sizeof(dst));
+			std::memset(ref, 0x5A, sizeof(ref));
+
+			void *ret = klib.memset(dst + off, c, len);
+			std::memset(ref + off, c, len);
+			if( ret != dst + off || std::memcmp(dst, ref, sizeof(dst)) ) {
+				fail("len %zu off %zu c %d", len, off, c);
+				return;
+			}
+		}
+	}
+
+	static void check_memcmp(rng &r) {
+		static unsigned char a[BUF], b[BUF];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			for( size_t i = 0; i < len; i++ )
+				a[i] = b[i] = (unsigned char) r.next();
+			if( len && r.below(4) )
+				b[r.below((uint32_t) len)] = (unsigned char) r.next();
+
+			int got  = sign(klib.memcmp(a, b, len));
+			int want = sign(std::memcmp(a, b, len));
+			if( got != want ) {
+				fail("len %zu: %d, expected %d", len, got, want);
+				return;
+			}
+		}
+	}
+
+	static void check_strlen(rng &r) {
+		static char s[BUF];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			size_t off = r.below(16);
+			size_t max = random_len(r);
+			random_string(r, s + off, len);
+
+			if( klib.strlen(s + off) != len ) {
+				fail("strlen: len %zu off %zu", len, off);
+				return;
+			}
+			if( klib.strnlen(s + off, max) != strnlen(s + off, max) ) {
+				fail("strnlen: len %zu max %zu", len, max);
+				return;
+			}
+		}
+	}
+
+	static void check_strcmp(rng &r) {
+		static char a[BUF], b[BUF];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			random_string(r, a, len);
+			std::memcpy(b, a, len + 1);
+			if( r.below(4) ) {
+				size_t i = r.below((uint32_t) len + 1);
+				b[i]     = i < len && r.below(4) ? '\0' : random_char(r);
+				if( i == len )
+					b[i + 1] = '\0';
+			}
+			size_t n = r.below((uint32_t) len + 8);
+
+			if( sign(klib.strcmp(a, b)) != sign(std::strcmp(a, b)) ) {
+				fail("strcmp: len %zu", len);
+				return;
+			}
+			if( sign(klib.strncmp(a, b, n)) != sign(std::strncmp(a, b, n)) ) {
+				fail("strncmp: len %zu n %zu", len, n);
+				return;
+			}
+		}
+	}
+
+	static void check_strchr(rng &r) {
+		static char s[BUF];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			random_string(r, s, len);
+			int c = r.below(16) ? random_char(r) : 0;
+
+			if( klib.strchr(s, c) != std::strchr(s, c) ) {
+				fail("strchr: len %zu c 0x%02x", len, c & 0xFF);
+				return;
+			}
+			if( klib.strrchr(s, c) != std::strrchr(s, c) ) {
+				fail("strrchr: len %zu c 0x%02x", len, c & 0xFF);
+				return;
+			}
+		}
+	}
+
+	static void check_strcpy(rng &r) {
+		static char src[BUF], dst[BUF + GUARD], ref[BUF + GUARD];
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			size_t n   = r.below((uint32_t) len + 16);
+			size_t pre = r.below(32);
+			random_string(r, src, len);
+
+			std::memset(dst, 'q', sizeof(dst));
+			std::memset(ref, 'q', sizeof(ref));
+			char *ret = klib.strcpy(dst, src);
+			std::strcpy(ref, src);
+			if( ret != dst || std::memcmp(dst, ref, sizeof(dst)) ) {
+				fail("strcpy: len %zu", len);
+				return;
+			}
+
+			std::memset(dst, 'q', sizeof(dst));
+			std::memset(ref, 'q', sizeof(ref));
+			ret = klib.strncpy(dst, src, n);
+			std::strncpy(ref, src, n);
+			if( ret != dst || std::memcmp(dst, ref, sizeof(dst)) ) {
+				fail("strncpy: len %zu n %zu", len, n);
+				return;
+			}
+
+			random_string(r, dst, pre);
+			std::memcpy(ref, dst, pre + 1);
+			ret = klib.strcat(dst, src);
+			std::strcat(ref, src);
+			if( ret != dst || std::strcmp(dst, ref) ) {
+				fail("strcat: prefix %zu len %zu", pre, len);
+				return;
+			}
+		}
+	}
+
+	static void check_strtok(rng &r) {
+		static char a[BUF], b[BUF];
+		static const char *delims[] = {" ", ",;", " ,;:", "\x80"};
+		for( int it = 0; it < ITERS; it++ ) {
+			size_t len = random_len(r);
+			random_string(r, a, len);
+			std::memcpy(b, a, len + 1);
+			const char *d = delims[r.below(4)];
+
+			char *kt = klib.strtok(a, d);
+			char *ht = std::strtok(b, d);
+			while( kt || ht ) {
+				bool same = kt && ht && kt - a == ht - b && !std::strcmp(kt, ht);
+				if( !same ) {
+					fail("len %zu delims \"%s\"", len, d);
+					return;
+				}
+				kt = klib.strtok(nullptr, d);
+				ht = std::strtok(nullptr, d);
+			}
+		}
+	}
+
+	/*
+	 * kstdlib
+	 */
+
+	// Digits of v in the given base, most significant first
+	static void reference_digits(char *out, unsigned long v, int base, bool upper) {
+		const char *set = upper ? "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+		                        : "0123456789abcdefghijklmnopqrstuvwxyz";
+		char        tmp[72];
+		int         n = 0;
+		do {
+			tmp[n++] = set[v % (unsigned) base];
+			v /= (unsigned) base;
+		} while( v );
+		while( n )
+			*out++ = tmp[--n];
+		*out = '\0';
+	}
+
+	static long random_long(rng &r) {
+		// Spread the magnitudes evenly instead of almost always 19 digits
+		return (long) (r.next() >> r.below(64));
+	}
+
+	static void check_itoa(rng &r) {
+		static const int bases[] = {2, 8, 10, 16};
+		char             buf[80], ref[80];
+		for( int it = 0; it < ITERS; it++ ) {
+			int  base  = bases[r.below(4)];
+			bool upper = r.below(2);
+			long v     = random_long(r);
+			if( r.below(2) && v != LONG_MIN )
+				v = -v;
+
+			char *end = klib.itoa(buf, buf + sizeof(buf), v, base, upper);
+			if( v < 0 ) {
+				ref[0] = '-';
+				reference_digits(ref + 1, 0UL - (unsigned long) v, base, upper);
+			} else {
+				reference_digits(ref, (unsigned long) v, base, upper);
+			}
+			if( std::strcmp(buf, ref) || end != buf + std::strlen(ref) ) {
+				// LONG_MIN cannot be negated and is a known gap
+				if( v == LONG_MIN )
+					continue;
+				fail("itoa(%ld, %d): \"%s\", want \"%s\"", v, base, buf, ref);
+				return;
+			}
+
+			unsigned long u = (unsigned long) r.next() >> r.below(64);
+			end = klib.utoa(buf, buf + sizeof(buf), u, base, upper);
+			reference_digits(ref, u, base, upper);
+			if( (size_t) (end - buf) != std::strlen(ref)
+			    || std::memcmp(buf, ref, std::strlen(ref)) ) {
+				*end = '\0';
+				fail("utoa(%lu, %d): \"%s\", want \"%s\"", u, base, buf, ref);
+				return;
+			}
+		}
+	}
+
+	static void check_atoi(rng &r) {
+		static const char *prefixes[] = {"", " ", "\t\n ", "+", "-", " -"};
+		static const char *suffixes[] = {"", "x", " 12", "z9"};
+		char               buf[64];
+		for( int it = 0; it < ITERS; it++ ) {
+			long v = random_long(r) & 0x7FFFFFFF;
+			std::snprintf(buf,
+			              sizeof(buf),
+			              "%s%ld%s",
+			              prefixes[r.below(6)],
+			              v,
+			              suffixes[r.below(4)]);
+
+			int got  = klib.atoi(buf);
+			int want = std::atoi(buf);
+			if( got != want || *klib.errno_ptr ) {
+				fail("atoi(\"%s\") = %d, expected %d", buf, got, want);
+				return;
+			}
+		}
+
+		if( klib.atoi("abc") != 0 || !*klib.errno_ptr )
+			fail("atoi(\"abc\") does not report an error");
+		if( klib.atoi("99999999999") != INT_MAX || !*klib.errno_ptr )
+			fail("atoi(\"99999999999\") does not saturate");
+	}
+
+	static void check_strtol(rng &r) {
+		static const int bases[] = {0, 2, 8, 10, 16, 36};
+		char             digits[80], buf[96];
+		for( int it = 0; it < ITERS; it++ ) {
+			int base = bases[r.below(6)];
+			int rb   = base ? base : 10;
+			unsigned long v  = (unsigned long) r.next() >> r.below(64);
+
+			const char *prefix = "";
+			if( base == 0 && r.below(2) ) {
+				prefix = r.below(2) ? "0x" : "0";
+				if( prefix[1] == 'x' )
+					rb = 16;
+				else
+					rb = 8;
+			} else if( base == 16 && r.below(2) ) {
+				prefix = "0X";
+			}
+			reference_digits(digits, v, rb, r.below(2));
+			std::snprintf(buf,
+			              sizeof(buf),
+			              "%s%s%s%s",
+			              r.below(2) ? " " : "",
+			              r.below(3) ? "" : "-",
+			              prefix,
+			              digits);
+			if( r.below(2) )
+				std::strcat(buf, "!#");
+
+			char *kend, *hend;
+			long  got  = klib.strtol(buf, &kend, base);
+			long  want = std::strtol(buf, &hend, base);
+			if( got != want || kend != hend ) {
+				fail("strtol(\"%s\", %d) = %ld (+%td), want %ld (+%td)",
+				     buf,
+				     base,
+				     got,
+				     kend - buf,
+				     want,
+				     hend - buf);
+				return;
+			}
+		}
+	}
+
+	// Against the same expression in 128-bit arithmetic, which the host may
+	// use; operands of every width, so both the one- and two-divide paths run
+	static void check_mul_div64(rng &r) {
+		__extension__ typedef unsigned __int128 u128;
+		for( int it = 0; it < ITERS * 5; it++ ) {
+			uint64_t a = r.next() >> r.below(64);
+			uint64_t b = r.next() >> r.below(64);
+			uint64_t c = (r.next() >> r.below(64)) | 1;
+			if( r.below(8) == 0 )
+				c = 1ULL << r.below(64);
+
+			u128     q    = (u128) a * b / c;
+			uint64_t want = q >> 64 ? ~0ULL : (uint64_t) q;
+			uint64_t got  = klib.mul_div64(a, b, c);
+			if( got != want ) {
+				fail("mul_div64(%#llx, %#llx, %#llx) = %#llx, want %#llx",
+				     (unsigned long long) a,
+				     (unsigned long long) b,
+				     (unsigned long long) c,
+				     (unsigned long long) got,
+				     (unsigned long long) want);
+				return;
+			}
+		}
+
+		if( klib.mul_div64(1, 1, 0) != ~0ULL )
+			fail("mul_div64(1, 1, 0) does not saturate");
+	}
+
+	/*
+	 * kctype
+	 */
+
+	static int (*const host_ctype[])(int) = {
+	    isupper, islower, isalpha, isdigit, isxdigit, isalnum, isspace,
+	    isblank, iscntrl, isgraph, isprint, ispunct, tolower, toupper,
+	};
+
+	static void check_ctype(rng &) {
+		for( size_t f = 0; kshim_ctypes[f].name; f++ ) {
+			bool is_conversion = kshim_ctypes[f].name[0] == 't';
+			for( int c = -1; c < 256; c++ ) {
+				int got  = kshim_ctypes[f].fn(c);
+				int want = host_ctype[f](c);
+				if( is_conversion ? got != want : !got != !want ) {
+					fail("%s(%d) = %d, want %d", kshim_ctypes[f].name, c, got, want);
+					break;
+				}
+			}
+		}
+	}
+
+	/*
+	 * kprint
+	 */
+
+	static void check_format(rng &r) {
+		static const char *strings[] = {
+		    "", "a", "hello", "exactly10!", "longer than ten"};
+		char got[64], want[64];
+		for( size_t f = 0; kshim_formats[f].format; f++ ) {
+			const kshim_format &k = kshim_formats[f];
+			for( int it = 0; it < ITERS / 16; it++ ) {
+				long long   i    = (long long) (r.next() >> r.below(64));
+				double      d    = (double) ((int) r.next() >> r.below(32)) / 8;
+				const char *s    = strings[r.below(5)];
+				size_t      size = r.below(4) ? sizeof(got) : 1 + r.below(16);
+				if( r.below(2) )
+					i = -i;
+
+				const char *f = k.format;
+				int         n = k.run(got, size, i, d, s);
+				int         m = 0;
+				switch( k.arg ) {
+					case KSHIM_ARG_I32:
+						m = std::snprintf(want, size, f, (int) i);
+						break;
+					case KSHIM_ARG_U32:
+						m = std::snprintf(want, size, f, (unsigned) i);
+						break;
+					case KSHIM_ARG_I64:
+						m = std::snprintf(want, size, f, i);
+						break;
+					case KSHIM_ARG_U64:
+						m = std::snprintf(want, size, f, (unsigned long long) i);
+						break;
+					case KSHIM_ARG_DOUBLE:
+						m = std::snprintf(want, size, f, d);
+						break;
+					case KSHIM_ARG_STRING:
+						m = std::snprintf(want, size, f, s);
+						break;
+				}
+
+				// On truncation the kernel returns what it stored
+				if( m >= (int) size )
+					m = (int) size - 1;
+				if( n != m || std::strcmp(got, want) ) {
+					fail("\"%s\" size %zu: \"%s\" (%d), want \"%s\" (%d)",
+					     f,
+					     size,
+					     got,
+					     n,
+					     want,
+					     m);
+					break;
+				}
+			}
+		}
+	}
+
+	/*
+	 * kmath
+	 */
+
+	struct math_case {
+		const char *name;
+		double (*ref1)(double);
+		double (*ref2)(double, double);
+		double lo, hi;  // Random inputs are drawn from here
+		double max_ulp;
+		bool   specials;  // Also compare zeros, infinities and NaN
+	};
+
+	/*
+	 * Functions with a limit are expected to stay within it of the host
+	 * libm everywhere, special values included.  The rest (limit < 0) are
+	 * older implementations; their error is printed so it can be tracked,
+	 * but it does not fail the check.
+	 */
+	static const math_case math_cases[] = {
+	    {"sin", std::sin, nullptr, -1e6, 1e6, 1, true},
+	    {"cos", std::cos, nullptr, -1e6, 1e6, 1, true},
+	    {"tan", std::tan, nullptr, -1e6, 1e6, 1, true},
+	    {"asin", std::asin, nullptr, -1, 1, 1, true},
+	    {"acos", std::acos, nullptr, -1, 1, 1, true},
+	    {"atan", std::atan, nullptr, -1e3, 1e3, 1, true},
+	    {"exp", std::exp, nullptr, -745, 709, 1, true},
+	    {"log", std::log, nullptr, 0, 1e300, 1, true},
+	    {"pow", nullptr, std::pow, 0, 100, 1, true},
+	    {"sqrt", std::sqrt, nullptr, 0, 1e300, 0, true},
+	    {"fabs", std::fabs, nullptr, -1e300, 1e300, 0, true},
+	    {"fmin", nullptr, std::fmin, -1e300, 1e300, 0, true},
+	    {"fmax", nullptr, std::fmax, -1e300, 1e300, 0, true},
+	    {"floor", std::floor, nullptr, -1e17, 1e17, -1, false},
+	    {"ceil", std::ceil, nullptr, -1e17, 1e17, -1, false},
+	    {"trunc", std::trunc, nullptr, -1e17, 1e17, -1, false},
+	    {"copysign", nullptr, std::copysign, -1e300, 1e300, -1, false},
+	    {"exp2", std::exp2, nullptr, -1022, 1023, -1, false},
+	    {"expm1", std::expm1, nullptr, -40, 709, -1, false},
+	    {"log2", std::log2, nullptr, 0, 1e300, -1, false},
+	    {"log10", std::log10, nullptr, 0, 1e300, -1, false},
+	    {"log1p", std::log1p, nullptr, -0.999, 1e6, -1, false},
+	    {"cbrt", std::cbrt, nullptr, -1e300, 1e300, -1, false},
+	    {"round", std::round, nullptr, -1e17, 1e17, -1, false},
+	    {"rint", std::rint, nullptr, -1e17, 1e17, -1, false},
+	    {"nearbyint", std::nearbyint, nullptr, -1e17, 1e17, -1, false},
+	    {"atan2", nullptr, std::atan2, -1e3, 1e3, -1, false},
+	    {"hypot", nullptr, std::hypot, -1e300, 1e300, -1, false},
+	    {"fmod", nullptr, std::fmod, -1e10, 1e10, -1, false},
+	    {"remainder", nullptr, std::remainder, -1e10, 1e10, -1, false},
+	    {"nextafter", nullptr, std::nextafter, -1e300, 1e300, -1, false},
+	};
+
+	static const double specials[] = {
+	    0.0, -0.0, 1.0, -1.0, 0.5, -0.5, 2.0, 1e-310, -1e-310, 1e308, -1e308,
+	    INFINITY, -INFINITY, NAN,
+	};
+
+	// Error of got in units of the last place of want
+	static double ulp_error(double got, double want) {
+		if( std::isnan(got) || std::isnan(want) )
+			return std::isnan(got) == std::isnan(want) ? 0 : INFINITY;
+		if( got == want )
+			return 0;
+		if( std::isinf(got) || std::isinf(want) )
+			return INFINITY;
+		double a   = std::fabs(want);
+		double ulp = std::nextafter(a, INFINITY) - a;
+		return std::fabs(got - want) / ulp;
+	}
+
+	// Log-uniform in [lo, hi] when the range spans many orders of magnitude
+	static double random_in(rng &r, double lo, double hi) {
+		double floor = lo > 0 ? lo : 1e-300;
+		if( lo >= 0 && hi / floor > 1e6 )
+			return std::exp(r.uniform(std::log(floor), std::log(hi)));
+		if( hi > 1e6 && lo < -1e6 && r.below(2) ) {
+			double m = random_in(r, 0, hi);
+			return r.below(2) ? m : -m;
+		}
+		return r.uniform(lo, hi);
+	}
+
+	static const kshim_math1 *find_math1(const char *name) {
+		for( size_t i = 0; kshim_math1s[i].name; i++ )
+			if( !std::strcmp(kshim_math1s[i].name, name) )
+				return &kshim_math1s[i];
+		return nullptr;
+	}
+
+	static const kshim_math2 *find_math2(const char *name) {
+		for( size_t i = 0; kshim_math2s[i].name; i++ )
+			if( !std::strcmp(kshim_math2s[i].name, name) )
+				return &kshim_math2s[i];
+		return nullptr;
+	}
+
+	static void check_math_case(rng &r, const math_case &c) {
+		const kshim_math1 *k1 = c.ref1 ? find_math1(c.name) : nullptr;
+		const kshim_math2 *k2 = c.ref2 ? find_math2(c.name) : nullptr;
+		if( !k1 && !k2 ) {
+			fail("%s: not exported by kshim.cpp", c.name);
+			return;
+		}
+
+		double worst = 0, wx = 0, wy = 0;
+		auto   one   = [&](double x, double y) {
+			double got  = k1 ? k1->fn(x) : k2->fn(x, y);
+			double want = k1 ? c.ref1(x) : c.ref2(x, y);
+			double err  = ulp_error(got, want);
+			if( err > worst ) {
+				worst = err;
+				wx    = x;
+				wy    = y;
+			}
+		};
+
+		for( double x : specials ) {
+			if( !c.specials )
+				break;
+			if( k1 )
+				one(x, 0);
+			else
+				for( double y : specials )
+					one(x, y);
+		}
+		for( int it = 0; it < ITERS * 5; it++ )
+			one(random_in(r, c.lo, c.hi), random_in(r, c.lo, c.hi));
+
+		std::printf("    %-10s %10.2f ulp", c.name, worst);
+		if( c.max_ulp >= 0 )
+			std::printf(" (limit %.0f)\n", c.max_ulp);
+		else
+			std::printf(" (not checked)\n");
+		std::fflush(stdout);
+		if( c.max_ulp >= 0 && worst > c.max_ulp ) {
+			if( k1 )
+				fail("%s(%a) is off by %.2f ulp", c.name, wx, worst);
+			else
+				fail("%s(%a, %a) is off by %.2f ulp",
+				     c.name,
+				     wx,
+				     wy,
+				     worst);
+		}
+	}
+
+	static void check_math(rng &r) {
+		for( const math_case &c : math_cases )
+			check_math_case(r, c);
+	}
+
+	// The batch versions must match the scalar ones bit for bit
+	static void check_batch(rng &r) {
+		static double in[1031], in2[1031], got[1031];
+		size_t        nspecial = sizeof(specials) / sizeof(specials[0]);
+		for( size_t b = 0; kshim_batches[b].name; b++ ) {
+			const kshim_math1 *scalar = find_math1(kshim_batches[b].name);
+			for( int it = 0; it < 20; it++ ) {
+				size_t n = r.below(1031);
+				for( size_t i = 0; i < n; i++ ) {
+					in[i] = r.below(64) ? random_in(r, -1e4, 1e4)
+					                    : specials[r.below((uint32_t) nspecial)];
+					if( kshim_batches[b].name[0] == 'l' )
+						in[i] = std::fabs(in[i]);
+				}
+				kshim_batches[b].fn(in, got, n);
+				for( size_t i = 0; i < n; i++ ) {
+					double want = scalar->fn(in[i]);
+					if( std::memcmp(&got[i], &want, sizeof(want)) ) {
+						fail("%s_n(%a) = %a, scalar %a",
+						     kshim_batches[b].name,
+						     in[i],
+						     got[i],
+						     want);
+						return;
+					}
+				}
+			}
+		}
+
+		// Mostly x > 0 and results near the overflow and underflow
+		// limits, plus integer y and specials that pow() settles first
+		for( size_t b = 0; kshim_batches2[b].name; b++ ) {
+			const kshim_math2 *scalar = find_math2(kshim_batches2[b].name);
+			for( int it = 0; it < 20; it++ ) {
+				size_t n = r.below(1031);
+				for( size_t i = 0; i < n; i++ ) {
+					in[i]  = r.below(64) ? random_in(r, 1e-3, 1e3)
+					                     : specials[r.below((uint32_t) nspecial)];
+					in2[i] = r.below(64) ? random_in(r, -110, 110)
+					                     : specials[r.below((uint32_t) nspecial)];
+					if( !r.below(8) )
+						in2[i] = std::round(in2[i]);
+				}
+				kshim_batches2[b].fn(in, in2, got, n);
+				for( size_t i = 0; i < n; i++ ) {
+					double want = scalar->fn(in[i], in2[i]);
+					if( std::memcmp(&got[i], &want, sizeof(want)) ) {
+						fail("%s_n(%a, %a) = %a, scalar %a",
+						     kshim_batches2[b].name,
+						     in[i],
+						     in2[i],
+						     got[i],
+						     want);
+						return;
+					}
+				}
+			}
+		}
+	}
+
+	/*
+	 * kbitmap
+	 *
+	 * Every result is compared with a plain bit-by-bit walk.  Maps are up to
+	 * BITMAP_WORDS words so the four-word skip loop gets whole blocks to
+	 * skip, and nbits is usually not a multiple of 64.
+	 */
+	typedef unsigned long long map_word;  // kbitmap's uint64_t
+
+	static constexpr size_t BITMAP_WORDS = 40;
+	static constexpr size_t BITMAP_BITS  = BITMAP_WORDS * 64;
+
+	static bool ref_test(const map_word *map, size_t bit) {
+		return (map[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	static size_t
+	    ref_find(const map_word *map, size_t nbits, size_t start, bool value) {
+		for( size_t bit = start; bit < nbits; bit++ )
+			if( ref_test(map, bit) == value )
+				return bit;
+		return nbits;
+	}
+
+	static size_t
+	    ref_zero_run(const map_word *map, size_t nbits, size_t start, size_t count) {
+		for( size_t bit = start; bit + count <= nbits; bit++ ) {
+			size_t len = 0;
+			while( len < count && !ref_test(map, bit + len) )
+				len++;
+			if( len == count )
+				return bit;
+		}
+		return nbits;
+	}
+
+	static size_t ref_popcount(const map_word *map, size_t start, size_t len) {
+		size_t n = 0;
+		for( size_t bit = start; bit < start + len; bit++ )
+			n += ref_test(map, bit);
+		return n;
+	}
+
+	// Empty, full, sparse, nearly full or half full, in long runs of words
+	static void random_bitmap(rng &r, map_word *map) {
+		uint32_t shape = r.below(5);
+		for( size_t w = 0; w < BITMAP_WORDS; w++ ) {
+			uint64_t x = r.next();
+			if( shape == 0 )
+				map[w] = 0;
+			else if( shape == 1 )
+				map[w] = ~0ULL;
+			else if( shape == 2 )
+				map[w] = r.below(16) ? 0 : 1ULL << (x % 64);
+			else if( shape == 3 )
+				map[w] = r.below(16) ? ~0ULL : ~(1ULL << (x % 64));
+			else
+				map[w] = x;
+		}
+	}
+
+	// Mostly not a multiple of 64, sometimes 0 or a whole number of words
+	static size_t random_nbits(rng &r) {
+		uint32_t pick = r.below(8);
+		if( pick == 0 )
+			return 0;
+		if( pick == 1 )
+			return 64 * (1 + r.below(BITMAP_WORDS));
+		return 1 + r.below(BITMAP_BITS);
+	}
+
+	// All three searches from one start; false once a mismatch is reported
+	static bool
+	    check_bitmap_at(rng &r, const map_word *map, size_t nbits, size_t start) {
+		size_t got  = klib.bitmap_find_next_set(map, nbits, start);
+		size_t want = ref_find(map, nbits, start, true);
+		if( got != want ) {
+			fail("find_next_set(%zu bits, %zu) = %zu, want %zu",
+			     nbits,
+			     start,
+			     got,
+			     want);
+			return false;
+		}
+
+		got  = klib.bitmap_find_next_zero(map, nbits, start);
+		want = ref_find(map, nbits, start, false);
+		if( got != want ) {
+			fail("find_next_zero(%zu bits, %zu) = %zu, want %zu",
+			     nbits,
+			     start,
+			     got,
+			     want);
+			return false;
+		}
+
+		size_t count = r.below(8) ? r.below(8) : r.below(200);
+		got          = klib.bitmap_find_zero_run(map, nbits, start, count);
+		want         = ref_zero_run(map, nbits, start, count);
+		if( got != want ) {
+			fail("find_zero_run(%zu bits, %zu, %zu) = %zu, want %zu",
+			     nbits,
+			     start,
+			     count,
+			     got,
+			     want);
+			return false;
+		}
+		return true;
+	}
+
+	static void check_bitmap_find(rng &r) {
+		static map_word map[BITMAP_WORDS];
+		for( int it = 0; it < ITERS / 10; it++ ) {
+			random_bitmap(r, map);
+			size_t nbits = random_nbits(r);
+
+			// First, last, past the end, and a few in between
+			size_t starts[8] = {0, nbits ? nbits - 1 : 0, nbits, nbits + 1};
+			for( size_t i = 4; i < 8; i++ )
+				starts[i] = r.below((uint32_t) nbits + 1);
+
+			for( size_t start : starts )
+				if( !check_bitmap_at(r, map, nbits, start) )
+					return;
+		}
+	}
+
+	static void check_bitmap_range(rng &r) {
+		static map_word map[BITMAP_WORDS], ref[BITMAP_WORDS];
+		for( int it = 0; it < ITERS / 4; it++ ) {
+			random_bitmap(r, map);
+			std::memcpy(ref, map, sizeof(map));
+
+			// Empty and whole-map ranges now and then
+			size_t   start = r.below(BITMAP_BITS + 1);
+			size_t   len   = r.below((uint32_t) (BITMAP_BITS - start) + 1);
+			uint32_t pick  = r.below(8);
+			if( pick == 0 )
+				len = 0;
+			else if( pick == 1 ) {
+				start = 0;
+				len   = BITMAP_BITS;
+			}
+
+			size_t got  = klib.bitmap_popcount(map, start, len);
+			size_t want = ref_popcount(map, start, len);
+			if( got != want ) {
+				fail("popcount(%zu, %zu) = %zu, want %zu",
+				     start,
+				     len,
+				     got,
+				     want);
+				return;
+			}
+
+			bool set = r.below(2);
+			if( set )
+				klib.bitmap_set_range(map, start, len);
+			else
+				klib.bitmap_clear_range(map, start, len);
+			for( size_t bit = start; bit < start + len; bit++ ) {
+				if( set )
+					ref[bit / 64] |= 1ULL << (bit % 64);
+				else
+					ref[bit / 64] &= ~(1ULL << (bit % 64));
+			}
+			if( std::memcmp(map, ref, sizeof(map)) ) {
+				fail("%s_range(%zu, %zu) differs",
+				     set ? "set" : "clear",
+				     start,
+				     len);
+				return;
+			}
+		}
+	}
+
+	/*
+	 * kunistd
+	 */
+
+	// PCG32 (XSH RR) seeded the way krand seeds the stream of CPU 0
+	struct pcg32_ref {
+		uint64_t state;
+		uint64_t inc;
+
+		explicit pcg32_ref(uint64_t seed) {
+			const uint64_t seq = 0xDEADBEEFULL;
+			state              = 0;
+			inc                = (seq << 1) | 1;
+			for( int i = 0; i < 3; i++ )
+				step();
+			state += seed;
+			step();
+		}
+
+		void step(void) {
+			state = state * 6364136223846793005ULL + inc;
+		}
+
+		uint32_t next(void) {
+			uint64_t prev = state;
+			step();
+			uint32_t xorshifted = (uint32_t) (((prev >> 18) ^ prev) >> 27);
+			uint32_t rot        = (uint32_t) (prev >> 59);
+			return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+		}
+	};
+
+	// Same stream through unsign(), sign(), fill() and advance()
+	static void check_rand(rng &r) {
+		static unsigned char buf[BUF + GUARD], ref[BUF + GUARD];
+		for( int it = 0; it < ITERS / 20; it++ ) {
+			uint64_t  seed = r.next();
+			pcg32_ref want(seed);
+			klib.rand_seed(seed);
+
+			for( int i = 0; i < 8; i++ ) {
+				uint32_t got = klib.rand_unsign();
+				uint32_t exp = want.next();
+				if( got != exp ) {
+					fail("seed %#llx: unsign() #%d = %#x, want %#x",
+					     (unsigned long long) seed,
+					     i,
+					     got,
+					     exp);
+					return;
+				}
+			}
+			if( klib.rand_sign() != (int32_t) want.next() ) {
+				fail("seed %#llx: sign() left the stream",
+				     (unsigned long long) seed);
+				return;
+			}
+
+			// fill() produces the unsign() words little-endian, and any
+			// partial last word is consumed whole
+			size_t len = random_len(r);
+			size_t off = r.below(16);
+			std::memset(buf, 0xA5, sizeof(buf));
+			std::memset(ref, 0xA5, sizeof(ref));
+			klib.rand_fill(buf + off, len);
+			for( size_t i = 0; i < len; i += 4 ) {
+				uint32_t word = want.next();
+				for( size_t b = 0; b < 4 && i + b < len; b++ )
+					ref[off + i + b] = (unsigned char) (word >> (8 * b));
+			}
+			if( std::memcmp(buf, ref, sizeof(buf)) ) {
+				fail("seed %#llx: fill(+%zu, %zu) differs",
+				     (unsigned long long) seed,
+				     off,
+				     len);
+				return;
+			}
+
+			uint64_t skip = r.below(1000);
+			klib.rand_advance(skip);
+			for( uint64_t i = 0; i < skip; i++ )
+				want.next();
+			if( klib.rand_unsign() != want.next() ) {
+				fail("seed %#llx: advance(%llu) lands elsewhere",
+				     (unsigned long long) seed,
+				     (unsigned long long) skip);
+				return;
+			}
+		}
+	}
+
+	/*
+	 * kern/sync
+	 */
+
+	// Threads hammering the shared locks, each with its own MCS slot
+	static constexpr unsigned LOCK_THREADS = 4;
+
+	// Long enough for a thread that could get in to have done so
+	static constexpr auto SETTLE = std::chrono::milliseconds(20);
+
+	/**
+	 * A thread that never reaches @p what leaves the others spinning on
+	 * a lock, so the check gives up on the whole child.
+	 */
+	template <typename Pred>
+	static void wait_until(Pred pred, const char *what) {
+		auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while( !pred() ) {
+			if( std::chrono::steady_clock::now() > end ) {
+				fail("timed out waiting until %s", what);
+				std::fflush(stdout);
+				_exit(1);
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	// Waiters get the lock in the order they queued, each handed over by
+	// the holder's unlock(); then many threads keep it exclusive
+	static void check_mcs_lock(rng &r) {
+		std::atomic<unsigned> next{0};
+		unsigned              order[3];
+
+		klib.mcs_lock(0);
+		auto waiter = [&](unsigned slot) {
+			klib.mcs_lock(slot);
+			order[next++] = slot;
+			klib.mcs_unlock(slot);
+		};
+		std::thread b(waiter, 1u);
+		wait_until([] { return klib.mcs_has_successor(0); }, "1 queues behind 0");
+		std::thread c(waiter, 2u);
+		wait_until([] { return klib.mcs_has_successor(1); }, "2 queues behind 1");
+		std::this_thread::sleep_for(SETTLE);
+		if( next != 0 )
+			fail("a waiter got in while the lock was held");
+		order[next++] = 0;
+		klib.mcs_unlock(0);
+		wait_until([&] { return next == 3; }, "both waiters get the lock");
+		b.join();
+		c.join();
+		if( order[0] != 0 || order[1] != 1 || order[2] != 2 )
+			fail("handoff order %u %u %u, want 0 1 2",
+			     order[0],
+			     order[1],
+			     order[2]);
+
+		// Plain read-modify-write, so any overlap loses increments
+		volatile unsigned long long counter = 0;
+		std::atomic<int>            inside{0};
+		std::atomic<int>            overlaps{0};
+		unsigned                    rounds = ITERS + (unsigned) r.below(ITERS);
+
+		std::atomic<unsigned> finished{0};
+		std::thread           threads[LOCK_THREADS];
+		for( unsigned t = 0; t < LOCK_THREADS; t++ ) {
+			threads[t] = std::thread([&, t] {
+				for( unsigned i = 0; i < rounds; i++ ) {
+					klib.mcs_lock(t);
+					if( inside++ )
+						overlaps++;
+					counter = counter + 1;
+					inside--;
+					klib.mcs_unlock(t);
+				}
+				finished++;
+			});
+		}
+		wait_until([&] { return finished == LOCK_THREADS; }, "all threads end");
+		for( std::thread &t : threads )
+			t.join();
+
+		if( overlaps || counter != (unsigned long long) LOCK_THREADS * rounds )
+			fail("%d overlapping holders, counter %llu of %llu",
+			     overlaps.load(),
+			     (unsigned long long) counter,
+			     (unsigned long long) LOCK_THREADS * rounds);
+	}
+
+	// A waiting writer holds new readers back and waits for the readers
+	// already inside to drain; then readers and writers mixed stay apart
+	static void check_rwlock(rng &r) {
+		std::atomic<bool> writer_in{false}, writer_done{false}, reader_in{false};
+
+		klib.read_lock();
+		std::thread writer([&] {
+			klib.write_lock();
+			writer_in = true;
+			while( !writer_done )
+				std::this_thread::yield();
+			klib.write_unlock();
+		});
+		wait_until([] { return klib.rw_writer_claimed(); }, "the writer claims it");
+
+		std::thread reader([&] {
+			klib.read_lock();
+			reader_in = true;
+			klib.read_unlock();
+		});
+		std::this_thread::sleep_for(SETTLE);
+		if( writer_in )
+			fail("writer got in with a reader inside");
+		if( reader_in )
+			fail("new reader overtook the waiting writer");
+
+		klib.read_unlock();
+		wait_until([&] { return writer_in.load(); }, "the writer gets in");
+		std::this_thread::sleep_for(SETTLE);
+		if( reader_in )
+			fail("reader got in with the writer inside");
+
+		writer_done = true;
+		writer.join();
+		wait_until([&] { return reader_in.load(); }, "the reader gets in");
+		reader.join();
+
+		// Writers keep the two words equal; a reader that sees them
+		// differ ran alongside a writer
+		volatile unsigned long long words[2] = {0, 0};
+		std::atomic<int>            readers{0}, writers{0}, errors{0};
+		unsigned                    rounds = ITERS + (unsigned) r.below(ITERS);
+
+		std::atomic<unsigned> finished{0};
+		std::thread           threads[LOCK_THREADS];
+		for( unsigned t = 0; t < LOCK_THREADS; t++ ) {
+			threads[t] = std::thread([&, t] {
+				rng mine = {r.state ^ (t + 1) * 0x9E3779B97F4A7C15ULL};
+				for( unsigned i = 0; i < rounds; i++ ) {
+					if( mine.below(8) == 0 ) {
+						klib.write_lock();
+						if( writers++ || readers )
+							errors++;
+						words[0] = words[0] + 1;
+						words[1] = words[0];
+						writers--;
+						klib.write_unlock();
+					} else {
+						klib.read_lock();
+						readers++;
+						if( writers || words[0] != words[1] )
+							errors++;
+						readers--;
+						klib.read_unlock();
+					}
+				}
+				finished++;
+			});
+		}
+		wait_until([&] { return finished == LOCK_THREADS; }, "all threads end");
+		for( std::thread &t : threads )
+			t.join();
+
+		if( errors )
+			fail("%d sections overlapped a writer", errors.load());
+	}
+
+	struct check {
+		const char *name;
+		void (*fn)(rng &r);
+	};
+
+	static const check checks[] = {
+	    {"memcpy", check_memcpy},
+	    {"memcpy_overlap", check_memcpy_overlap},
+	    {"mempcpy", check_mempcpy},
+	    {"memset", check_memset},
+	    {"memcmp", check_memcmp},
+	    {"strlen", check_strlen},
+	    {"strcmp", check_strcmp},
+	    {"strchr", check_strchr},
+	    {"strcpy", check_strcpy},
+	    {"strtok", check_strtok},
+	    {"itoa", check_itoa},
+	    {"atoi", check_atoi},
+	    {"strtol", check_strtol},
+	    {"mul_div64", check_mul_div64},
+	    {"ctype", check_ctype},
+	    {"format", check_format},
+	    {"math", check_math},
+	    {"math_batch", check_batch},
+	    {"bitmap_find", check_bitmap_find},
+	    {"bitmap_range", check_bitmap_range},
+	    {"rand", check_rand},
+	    {"mcs_lock", check_mcs_lock},
+	    {"rwlock", check_rwlock},
+	};
+
+	int run_checks(const char *filter) {
+		int failed = 0;
+		int run    = 0;
+		for( const check &c : checks ) {
+			if( !std::strstr(c.name, filter) )
+				continue;
+
+			// Seed from the name so a filter does not change the inputs
+			rng r = {0x5EED};
+			for( const char *p = c.name; *p; p++ )
+				r.state = r.state * 31 + (unsigned char) *p;
+
+			// Each check runs in a child so a crash in the kernel code is
+			// reported instead of ending the run
+			run++;
+			std::fflush(stdout);
+			pid_t pid = fork();
+			if( pid == 0 ) {
+				failures = 0;
+				c.fn(r);
+				int hidden = failures - MAX_REPORTS;
+				if( hidden > 0 )
+					std::printf("    (%d more)\n", hidden);
+				std::fflush(stdout);
+				_exit(failures ? 1 : 0);
+			}
+
+			int status = 0;
+			if( pid < 0 || waitpid(pid, &status, 0) < 0 ) {
+				std::perror("fork");
+				return ++failed;
+			}
+			const char *result = WEXITSTATUS(status) ? "FAIL" : "ok";
+			if( WIFSIGNALED(status) )
+				result = strsignal(WTERMSIG(status));
+			std::printf("%-16s %s\n", c.name, result);
+			failed += !WIFEXITED(status) || WEXITSTATUS(status);
+		}
+		std::printf("%d of %d checks failed\n", failed, run);
+		return failed;
+	}
+}  // namespace host
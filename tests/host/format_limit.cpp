@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include <kstdio.h>
+
+/*
+ * Compile-only probe for kstd::fmt::MAX_ESCAPES. As written it must build;
+ * with FORMAT_OVER_LIMIT defined the format has one escape too many and must
+ * fail with an error that names the limit. Not linked into the host driver.
+ */
+int format_limit_probe(char *buffer, size_t size) {
+#ifdef FORMAT_OVER_LIMIT
+	return kstd::snprintf(buffer, size, "%%%% %%%% %%");
+#else
+	return kstd::snprintf(buffer, size, "%%%% %%%%");
+#endif
+}
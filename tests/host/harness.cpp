@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "harness.h"
+#include "kshim.h"
+
+#include <cstdio>
+#include <cstring>
+
+/*
+ * Host driver for the freestanding libraries in sys/lib.
+ *
+ *   host-lib check [filter]
+ *   host-lib bench [--baseline file] [--save file] [filter]
+ *
+ * See the host-check, host-bench and host-baseline targets in the Makefile.
+ */
+
+extern "C" void kshim_putchar(char c) {
+	std::fputc(c, stdout);
+}
+
+static int usage(const char *argv0) {
+	std::fprintf(stderr,
+	             "usage: %s check [filter]\n"
+	             "       %s bench [--baseline file] [--save file] [filter]\n",
+	             argv0,
+	             argv0);
+	return 2;
+}
+
+int main(int argc, char **argv) {
+	if( argc < 2 )
+		return usage(argv[0]);
+
+	const char *baseline = nullptr;
+	const char *save     = nullptr;
+	const char *filter   = "";
+
+	for( int i = 2; i < argc; i++ ) {
+		if( !std::strcmp(argv[i], "--baseline") && i + 1 < argc )
+			baseline = argv[++i];
+		else if( !std::strcmp(argv[i], "--save") && i + 1 < argc )
+			save = argv[++i];
+		else if( argv[i][0] != '-' )
+			filter = argv[i];
+		else
+			return usage(argv[0]);
+	}
+
+	if( !std::strcmp(argv[1], "check") )
+		return host::run_checks(filter) ? 1 : 0;
+	if( !std::strcmp(argv[1], "bench") )
+		return host::run_benches(filter, baseline, save);
+	return usage(argv[0]);
+}
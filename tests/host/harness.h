@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace host {
+	// SplitMix64; every run sees the same inputs
+	struct rng {
+		uint64_t state;
+
+		uint64_t next(void) {
+			uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+			z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+		// Uniform in [0, n)
+		uint32_t below(uint32_t n) {
+			return (uint32_t) (((next() >> 32) * n) >> 32);
+		}
+
+		// Uniform in [lo, hi)
+		double uniform(double lo, double hi) {
+			return lo + (hi - lo) * (double) (next() >> 11) * 0x1p-53;
+		}
+	};
+
+	/**
+	 * @brief Run the property tests whose name contains @p filter
+	 * @return Number of failed tests
+	 */
+	int run_checks(const char *filter);
+
+	/**
+	 * @brief Run the benchmarks whose name contains @p filter
+	 * @param baseline File to compare against, or null
+	 * @param save     File to write the results to, or null
+	 * @return 0, or 1 if a file could not be read or written
+	 */
+	int run_benches(const char *filter, const char *baseline, const char *save);
+}  // namespace host
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#include "kshim.h"
+
+#include <kbitmap.h>
+#include <kctype.h>
+#include <kerrno.h>
+#include <kmath.h>
+#include <kstdio.h>
+#include <kstdlib.h>
+#include <kstring.h>
+#include <kunistd.h>
+
+#include <arch/amd64/cpu/cpuid.h>
+#include <drv/tty/tty.h>
+#include <kern/sched/sched.h>
+#include <kern/sync/spinlock.h>
+
+/*
+ * Built with the kernel's compiler flags and include paths, so the tables
+ * point at exactly the code the kernel links.
+ */
+
+Main_tty main_tty = {{}, 0, 0, kshim_putchar, 0};
+
+// krand asks which CPU it runs on and whether RDSEED/RDRAND exist; on the
+// host everything is CPU 0 and seeding falls back to the TSC
+namespace amd64::cpuid {
+	uint32_t get_core_id(void) {
+		return 0;
+	}
+
+	namespace instr {
+		bool has_rdrand(void) {
+			return false;
+		}
+
+		bool has_rdseed(void) {
+			return false;
+		}
+	}  // namespace instr
+}  // namespace amd64::cpuid
+
+// krand keeps preemption off around a stream update; the host has no
+// scheduler to hold off
+namespace sched {
+	void preempt_disable(void) {
+	}
+
+	void preempt_enable(void) {
+	}
+}  // namespace sched
+
+// The locks below carry no lock_stats record, but with LOCK_STATS the
+// inline lock code still refers to the recorders
+namespace sync::detail {
+	void note_acquire(lock_stats *s, uint64_t spins, uint64_t wait_cycles) {
+		(void) s;
+		(void) spins;
+		(void) wait_cycles;
+	}
+
+	void note_release(lock_stats *s, uint64_t held_cycles) {
+		(void) s;
+		(void) held_cycles;
+	}
+}  // namespace sync::detail
+
+static sync::mcs_lock mcs;
+static sync::rwlock   rw;
+
+// One node per cache line, as a waiter's stack frame would give it
+static struct alignas(64) {
+	sync::mcs_node node;
+} mcs_slots[KSHIM_LOCK_SLOTS];
+
+extern "C" {
+	const kshim_lib klib = {
+	    kstring::memcmp,
+	    kstring::memcpy,
+	    kstring::mempcpy,
+	    kstring::memset,
+	    kstring::strcat,
+	    kstring::strchr,
+	    kstring::strcmp,
+	    kstring::strcpy,
+	    kstring::strncmp,
+	    kstring::strncpy,
+	    kstring::strrchr,
+	    kstring::strtok,
+	    kstd::strlen,
+	    kstd::strnlen,
+	    kstd::atoi,
+	    kstd::strtol,
+	    kstd::itoa,
+	    kstd::utoa,
+	    kstd::mul_div64,
+	    &errno,
+	    kbitmap::set_range,
+	    kbitmap::clear_range,
+	    kbitmap::find_next_set,
+	    kbitmap::find_next_zero,
+	    kbitmap::find_zero_run,
+	    kbitmap::popcount,
+	    unistd::rand::unsign,
+	    unistd::rand::sign,
+	    unistd::rand::fill,
+	    unistd::rand::seed,
+	    unistd::rand::advance,
+	    [](unsigned slot) { sync::lock(&mcs, &mcs_slots[slot].node); },
+	    [](unsigned slot) { sync::unlock(&mcs, &mcs_slots[slot].node); },
+	    [](unsigned slot) {
+		    return (int) (__atomic_load_n(&mcs_slots[slot].node.next,
+		                                  __ATOMIC_ACQUIRE)
+		                  != nullptr);
+	    },
+	    [] { sync::read_lock(&rw); },
+	    [] { sync::read_unlock(&rw); },
+	    [] { sync::write_lock(&rw); },
+	    [] { sync::write_unlock(&rw); },
+	    [] {
+		    return (int) !!(__atomic_load_n(&rw.value, __ATOMIC_ACQUIRE)
+		                    & sync::RW_WRITER);
+	    },
+	};
+
+	const kshim_ctype kshim_ctypes[] = {
+	    {"isupper", ctype::isupper},
+	    {"islower", ctype::islower},
+	    {"isalpha", ctype::isalpha},
+	    {"isdigit", ctype::isdigit},
+	    {"isxdigit", ctype::isxdigit},
+	    {"isalnum", ctype::isalnum},
+	    {"isspace", ctype::isspace},
+	    {"isblank", ctype::isblank},
+	    {"iscntrl", ctype::iscntrl},
+	    {"isgraph", ctype::isgraph},
+	    {"isprint", ctype::isprint},
+	    {"ispunct", ctype::ispunct},
+	    {"tolower", ctype::tolower},
+	    {"toupper", ctype::toupper},
+	    {nullptr, nullptr},
+	};
+
+	const kshim_math1 kshim_math1s[] = {
+	    {"sin", kmath::sin},
+	    {"cos", kmath::cos},
+	    {"tan", kmath::tan},
+	    {"asin", kmath::asin},
+	    {"acos", kmath::acos},
+	    {"atan", kmath::atan},
+	    {"exp", kmath::exp},
+	    {"exp2", kmath::exp2},
+	    {"expm1", kmath::expm1},
+	    {"log", kmath::log},
+	    {"log2", kmath::log2},
+	    {"log10", kmath::log10},
+	    {"log1p", kmath::log1p},
+	    {"sqrt", kmath::sqrt},
+	    {"cbrt", kmath::cbrt},
+	    {"fabs", kmath::fabs},
+	    {"floor", kmath::floor},
+	    {"ceil", kmath::ceil},
+	    {"trunc", kmath::trunc},
+	    {"round", kmath::round},
+	    {"rint", kmath::rint},
+	    {"nearbyint", kmath::nearbyint},
+	    {nullptr, nullptr},
+	};
+
+	const kshim_math2 kshim_math2s[] = {
+	    {"pow", kmath::pow},
+	    {"atan2", kmath::atan2},
+	    {"hypot", kmath::hypot},
+	    {"fmod", kmath::fmod},
+	    {"remainder", kmath::remainder},
+	    {"fmin", kmath::fmin},
+	    {"fmax", kmath::fmax},
+	    {"copysign", kmath::copysign},
+	    {"nextafter", kmath::nextafter},
+	    {nullptr, nullptr},
+	};
+
+	const kshim_batch kshim_batches[] = {
+	    {"sin", kmath::sin_n},
+	    {"cos", kmath::cos_n},
+	    {"tan", kmath::tan_n},
+	    {"exp", kmath::exp_n},
+	    {"log", kmath::log_n},
+	    {nullptr, nullptr},
+	};
+
+	const kshim_batch2 kshim_batches2[] = {
+	    {"pow", kmath::pow_n},
+	    {nullptr, nullptr},
+	};
+
+#define KSHIM_FORMAT(F, ARG, ...)                                   \
+	{F,                                                         \
+	 ARG,                                                       \
+	 [](char *b, kshim_size n, long long i, double d, const char *s) { \
+		 (void) i;                                          \
+		 (void) d;                                          \
+		 (void) s;                                          \
+		 return kstd::snprintf(b, n, F, __VA_ARGS__);       \
+	 }}
+
+	const kshim_format kshim_formats[] = {
+	    KSHIM_FORMAT("%d", KSHIM_ARG_I32, (int) i),
+	    KSHIM_FORMAT("%12d", KSHIM_ARG_I32, (int) i),
+	    KSHIM_FORMAT("%-12d|", KSHIM_ARG_I32, (int) i),
+	    KSHIM_FORMAT("%d%%", KSHIM_ARG_I32, (int) i),
+	    // Exactly kstd::fmt::MAX_ESCAPES escapes
+	    KSHIM_FORMAT("%%%d%% %%%%", KSHIM_ARG_I32, (int) i),
+	    KSHIM_FORMAT("%u", KSHIM_ARG_U32, (unsigned) i),
+	    KSHIM_FORMAT("%x", KSHIM_ARG_U32, (unsigned) i),
+	    KSHIM_FORMAT("%8X", KSHIM_ARG_U32, (unsigned) i),
+	    KSHIM_FORMAT("%lld", KSHIM_ARG_I64, i),
+	    KSHIM_FORMAT("%llu", KSHIM_ARG_U64, (unsigned long long) i),
+	    KSHIM_FORMAT("%llx", KSHIM_ARG_U64, (unsigned long long) i),
+	    KSHIM_FORMAT("%-20llX|", KSHIM_ARG_U64, (unsigned long long) i),
+	    KSHIM_FORMAT("[%c]", KSHIM_ARG_I32, (char) i),
+	    KSHIM_FORMAT("%s", KSHIM_ARG_STRING, s),
+	    KSHIM_FORMAT("%10s|", KSHIM_ARG_STRING, s),
+	    KSHIM_FORMAT("%-10s|", KSHIM_ARG_STRING, s),
+	    KSHIM_FORMAT("%.3f", KSHIM_ARG_DOUBLE, d),
+	    KSHIM_FORMAT("%12.3f|", KSHIM_ARG_DOUBLE, d),
+	    {nullptr, KSHIM_ARG_I32, nullptr},
+	};
+
+#undef KSHIM_FORMAT
+}
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ * -- BEGIN METADATA HEADER --
+ * <*---The Wind/Tempest Project---*>
+ * 
+ * Author(s)  : Tempik25 <tempik25@tempestfoundation.org>
+ * Maintainer : Tempest Foundation <development@tempestfoundation.org>
+ * 
+ * Copyright (c) Tempest Foundation, 2025
+ * -- END OF METADATA HEADER --
+ */
+#pragma once
+
+/*
+ * Bridge between the kernel libraries and the host test driver.
+ *
+ * The kernel headers define their own size_t and friends, which clash with
+ * the host C library, so the two sides never include each other's headers.
+ * kshim.cpp is built with the kernel flags and fills in the tables below
+ * with pointers to the real kernel functions; everything else in this
+ * directory is ordinary hosted C++ that only sees this file.
+ *
+ * Only builtin types appear here.  `unsigned long long` is the kernel's
+ * size_t and has the same ABI as the host's.  The tables end with an entry
+ * whose name (or format) is null.
+ */
+typedef unsigned long long kshim_size;
+
+// MCS queue nodes kshim.cpp keeps for the driver's threads, one per slot
+#define KSHIM_LOCK_SLOTS 8
+
+struct kshim_lib {
+	// kstring
+	int (*memcmp)(const void *s1, const void *s2, kshim_size n);
+	void *(*memcpy)(void *dest, const void *src, kshim_size n);
+	void *(*mempcpy)(void *dest, const void *src, kshim_size n);
+	void *(*memset)(void *s, int c, kshim_size n);
+	char *(*strcat)(char *dest, const char *src);
+	char *(*strchr)(const char *str, int c);
+	int (*strcmp)(const char *s1, const char *s2);
+	char *(*strcpy)(char *dest, const char *src);
+	int (*strncmp)(const char *s1, const char *s2, kshim_size n);
+	char *(*strncpy)(char *dest, const char *src, kshim_size n);
+	const char *(*strrchr)(const char *str, int c);
+	char *(*strtok)(char *str, const char *delim);
+
+	// kstdio
+	kshim_size (*strlen)(const char *str);
+	kshim_size (*strnlen)(const char *str, kshim_size maxlen);
+
+	// kstdlib
+	int (*atoi)(const char *s);
+	long (*strtol)(const char *nptr, char **endptr, int base);
+	char *(*itoa)(char *buf, char *end, long value, int base, int uppercase);
+	char *(*utoa)(char *buf,
+	              char *end,
+	              unsigned long value,
+	              int   base,
+	              int   uppercase);
+	unsigned long long (*mul_div64)(unsigned long long a,
+	                                unsigned long long b,
+	                                unsigned long long c);
+	int *errno_ptr;
+
+	// kbitmap
+	void (*bitmap_set_range)(unsigned long long *map,
+	                         kshim_size          start,
+	                         kshim_size          len);
+	void (*bitmap_clear_range)(unsigned long long *map,
+	                           kshim_size          start,
+	                           kshim_size          len);
+	kshim_size (*bitmap_find_next_set)(const unsigned long long *map,
+	                                   kshim_size                nbits,
+	                                   kshim_size                start);
+	kshim_size (*bitmap_find_next_zero)(const unsigned long long *map,
+	                                    kshim_size                nbits,
+	                                    kshim_size                start);
+	kshim_size (*bitmap_find_zero_run)(const unsigned long long *map,
+	                                   kshim_size                nbits,
+	                                   kshim_size                start,
+	                                   kshim_size                count);
+	kshim_size (*bitmap_popcount)(const unsigned long long *map,
+	                              kshim_size                start,
+	                              kshim_size                len);
+
+	// kunistd
+	unsigned (*rand_unsign)(void);
+	int (*rand_sign)(void);
+	void (*rand_fill)(void *buf, kshim_size len);
+	void (*rand_seed)(unsigned long long seed);
+	void (*rand_advance)(unsigned long long delta);
+
+	// kern/sync: one mcs_lock and one rwlock shared by every caller
+	void (*mcs_lock)(unsigned slot);
+	void (*mcs_unlock)(unsigned slot);
+	int (*mcs_has_successor)(unsigned slot);
+	void (*read_lock)(void);
+	void (*read_unlock)(void);
+	void (*write_lock)(void);
+	void (*write_unlock)(void);
+	int (*rw_writer_claimed)(void);
+};
+
+struct kshim_ctype {
+	const char *name;
+	int (*fn)(int c);
+};
+
+struct kshim_math1 {
+	const char *name;
+	double (*fn)(double x);
+};
+
+struct kshim_math2 {
+	const char *name;
+	double (*fn)(double x, double y);
+};
+
+struct kshim_batch {
+	const char *name;  // Name of the scalar function it matches
+	void (*fn)(const double *in, double *out, kshim_size n);
+};
+
+struct kshim_batch2 {
+	const char *name;
+	void (*fn)(const double *x, const double *y, double *out, kshim_size n);
+};
+
+enum kshim_arg {
+	KSHIM_ARG_I32,
+	KSHIM_ARG_U32,
+	KSHIM_ARG_I64,
+	KSHIM_ARG_U64,
+	KSHIM_ARG_DOUBLE,
+	KSHIM_ARG_STRING
+};
+
+/*
+ * kstd::snprintf() checks its format at compile time, so each format under
+ * test is instantiated in kshim.cpp.  The host runs the same string through
+ * its own snprintf and compares.
+ */
+struct kshim_format {
+	const char *format;
+	kshim_arg   arg;
+	int (*run)(char       *buf,
+	           kshim_size  size,
+	           long long   i,
+	           double      d,
+	           const char *s);
+};
+
+extern "C" {
+	extern const kshim_lib    klib;
+	extern const kshim_ctype  kshim_ctypes[];
+	extern const kshim_math1  kshim_math1s[];
+	extern const kshim_math2  kshim_math2s[];
+	extern const kshim_batch  kshim_batches[];
+	extern const kshim_batch2 kshim_batches2[];
+	extern const kshim_format kshim_formats[];
+
+	// Console output from kstd::printf() ends up here
+	void kshim_putchar(char c);
+}